@@ -54,6 +54,8 @@ dependencies {
     implementation("io.github.gradle-nexus:publish-plugin:${Versions.nexusPublishPlugin}")
     implementation("io.gitlab.arturbosch.detekt:detekt-gradle-plugin:${Versions.detektPlugin}")
     implementation("org.jetbrains.kotlin:kotlin-gradle-plugin:${Versions.kotlin}")
+    implementation("org.jetbrains.kotlin:kotlin-allopen:${Versions.kotlin}")
+    implementation("org.jetbrains.kotlinx:kotlinx-benchmark-plugin:${Versions.kotlinxBenchmark}")
     implementation("com.android.tools.build:gradle:${Versions.Android.buildTools}") // TODO LATER Don't know why this has to be here. See if we can remove this
     implementation("com.android.tools.build:gradle-api:${Versions.Android.buildTools}")
     implementation(kotlin("script-runtime"))
@@ -76,6 +76,7 @@ object Versions {
     const val jvmTarget = "1.8"
     const val kotlin = "1.6.0" // https://github.com/JetBrains/kotlin
     const val kotlinCompileTesting = "1.4.2" // https://github.com/tschuchortdev/kotlin-compile-testing
+    const val kotlinxBenchmark = "0.4.0" // https://github.com/Kotlin/kotlinx-benchmark
     const val ktlintPlugin = "10.1.0" // https://github.com/jlleitschuh/ktlint-gradle
     const val ktlintVersion = "0.41.0" // https://github.com/pinterest/ktlint
     const val ktor = "1.6.4" // https://kotlinlang.org/docs/releases.html#release-details
@@ -69,6 +69,7 @@ allprojects {
         input = files(
             file("src/androidMain/kotlin"),
             file("src/androidTest/kotlin"),
+            file("src/apple/kotlin"),
             file("src/commonMain/kotlin"),
             file("src/commonTest/kotlin"),
             file("src/darwin/kotlin"),
@@ -77,9 +78,13 @@ allprojects {
             file("src/iosTest/kotlin"),
             file("src/jvm/kotlin"),
             file("src/jvmMain/kotlin"),
+            file("src/linux/kotlin"),
+            file("src/linuxMain/kotlin"),
+            file("src/linuxTest/kotlin"),
             file("src/main/kotlin"),
             file("src/macosMain/kotlin"),
             file("src/macosTest/kotlin"),
+            file("src/native/kotlin"),
             file("src/test/kotlin")
         )
 
@@ -91,6 +91,26 @@ val debugLibs = listOf(
     "librealm-object-store-dbg.a",
     "librealm-sync-dbg.a"
 )
+val nativeLibraryIncludesLinuxX64Debug =
+    includeBinaries(
+        listOf(
+            "object-store/c_api/librealm-ffi-static-dbg.a",
+            "librealm-dbg.a",
+            "parser/librealm-parser-dbg.a",
+            "object-store/librealm-object-store-dbg.a",
+            "sync/librealm-sync-dbg.a"
+        ).map { "$absoluteCorePath/build-linux_x64-dbg/src/realm/$it" }
+    )
+val nativeLibraryIncludesLinuxX64Release =
+    includeBinaries(
+        listOf(
+            "object-store/c_api/librealm-ffi-static.a",
+            "librealm.a",
+            "parser/librealm-parser.a",
+            "object-store/librealm-object-store.a",
+            "sync/librealm-sync.a"
+        ).map { "$absoluteCorePath/build-linux_x64/src/realm/$it" }
+    )
 val nativeLibraryIncludesIosArm64Debug =
     includeBinaries(debugLibs.map { "$absoluteCorePath/build-capi_ios_Arm64-dbg/lib/$it" })
 val nativeLibraryIncludesIosArm64Release =
@@ -154,6 +174,18 @@ kotlin {
         }
     }
 
+    linuxX64("linux") {
+        compilations.getByName("main") {
+            cinterops.create("realm_wrapper") {
+                defFile = project.file("src/native/realm.def")
+                packageName = "realm_wrapper"
+                includeDirs("$absoluteCorePath/src/")
+            }
+            // See comments on macosX64 target on why library paths are resolved through gradle
+            kotlinOptions.freeCompilerArgs += if (isReleaseBuild) nativeLibraryIncludesLinuxX64Release else nativeLibraryIncludesLinuxX64Debug
+        }
+    }
+
     sourceSets {
         val commonMain by getting {
             dependencies {
@@ -193,6 +225,7 @@ kotlin {
             //  https://youtrack.jetbrains.com/issue/KT-48153
             // FIXME HIERARCHICAL-BUILD Rename to nativeDarwin
             kotlin.srcDir("src/darwin/kotlin")
+            kotlin.srcDir("src/apple/kotlin")
         }
         val iosMain by getting {
             // TODO HIERARCHICAL-BUILD From 1.5.30-M1 we should be able to commonize cinterops using
@@ -200,6 +233,7 @@ kotlin {
             //  This would also require us to enable hierarchical setup, which is currently blocked by
             //  https://youtrack.jetbrains.com/issue/KT-48153
             kotlin.srcDir("src/darwin/kotlin")
+            kotlin.srcDir("src/apple/kotlin")
         }
         val macosTest by getting {
             // FIXME HIERARCHICAL-BUILD Rename to nativeDarwinTest
@@ -208,6 +242,16 @@ kotlin {
         val iosTest by getting {
             kotlin.srcDir("src/darwinTest/kotlin")
         }
+        val linuxMain by getting {
+            // The darwin implementation only relies on the C-API and POSIX, so it is shared with
+            // Linux until we have a hierarchical setup with a common native source set. APIs that
+            // only exist on Apple platforms are kept in src/apple with Linux actuals in src/linux.
+            kotlin.srcDir("src/darwin/kotlin")
+            kotlin.srcDir("src/linux/kotlin")
+        }
+        val linuxTest by getting {
+            kotlin.srcDir("src/darwinTest/kotlin")
+        }
     }
 
     targets.all {
@@ -301,6 +345,11 @@ val capiIosArm64 by tasks.registering {
     build_C_API_iOS_Arm64(releaseBuild = isReleaseBuild)
 }
 
+// Building for Linux x86_64
+val capiLinuxX64 by tasks.registering {
+    build_C_API_Linux_X64(releaseBuild = isReleaseBuild)
+}
+
 val buildJVMSharedLibs by tasks.registering {
     buildSharedLibrariesForJVM()
 }
@@ -526,6 +575,40 @@ fun Task.build_C_API_iOS_Arm64(releaseBuild: Boolean = false) {
     outputs.file(project.file("$directory/lib/librealm-sync$buildTypeSuffix.a"))
 }
 
+fun Task.build_C_API_Linux_X64(releaseBuild: Boolean = false) {
+    val buildType = if (releaseBuild) "Release" else "Debug"
+    val buildTypeSuffix = if (releaseBuild) "" else "-dbg"
+
+    val directory = "$absoluteCorePath/build-linux_x64$buildTypeSuffix"
+    doLast {
+        exec {
+            commandLine("mkdir", "-p", directory)
+        }
+        exec {
+            workingDir(project.file(directory))
+            commandLine(
+                "cmake",
+                "-DCMAKE_CXX_COMPILER_LAUNCHER=ccache",
+                "-DCMAKE_C_COMPILER_LAUNCHER=ccache",
+                "-DCMAKE_BUILD_TYPE=$buildType",
+                "-DCMAKE_POSITION_INDEPENDENT_CODE=ON",
+                "-DREALM_ENABLE_SYNC=1",
+                "-DREALM_NO_TESTS=1",
+                ".."
+            )
+        }
+        exec {
+            workingDir(project.file(directory))
+            commandLine("cmake", "--build", ".", "-j8")
+        }
+    }
+    outputs.file(project.file("$directory/src/realm/object-store/c_api/librealm-ffi-static$buildTypeSuffix.a"))
+    outputs.file(project.file("$directory/src/realm/librealm$buildTypeSuffix.a"))
+    outputs.file(project.file("$directory/src/realm/parser/librealm-parser$buildTypeSuffix.a"))
+    outputs.file(project.file("$directory/src/realm/object-store/librealm-object-store$buildTypeSuffix.a"))
+    outputs.file(project.file("$directory/src/realm/sync/librealm-sync$buildTypeSuffix.a"))
+}
+
 afterEvaluate {
     // Ensure that Swig wrapper is generated before compiling the JNI layer. This task needs
     // the cpp file as it somehow processes the CMakeList.txt-file, but haven't dug up the
@@ -550,6 +633,10 @@ tasks.named("cinteropRealm_wrapperMacos") {
     dependsOn(capiMacosUniversal)
 }
 
+tasks.named("cinteropRealm_wrapperLinux") {
+    dependsOn(capiLinuxX64)
+}
+
 tasks.named("jvmMainClasses") {
     dependsOn(buildJVMSharedLibs)
 }
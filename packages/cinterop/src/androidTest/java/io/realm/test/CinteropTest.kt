@@ -19,6 +19,7 @@ package io.realm.test
 import androidx.test.ext.junit.runners.AndroidJUnit4
 import androidx.test.platform.app.InstrumentationRegistry
 import io.realm.internal.interop.CoreErrorUtils
+import io.realm.internal.interop.Link
 import io.realm.internal.interop.RealmCoreException
 import io.realm.internal.interop.RealmCoreInvalidQueryException
 import io.realm.internal.interop.RealmCoreLogicException
@@ -488,6 +489,8 @@ class CinteropTest {
         val bar_info = realm_class_info_t()
         realmc.realm_find_class(realm, "bar", found, bar_info)
         assertTrue(found[0])
+        assertEquals(foo_info.key, realmc.realm_find_class_key(realm, "foo"))
+        assertEquals(-1L, realmc.realm_find_class_key(realm, "fo"))
 
         // Output variables
         val foo_int_property = realm_property_info_t()
@@ -540,6 +543,9 @@ class CinteropTest {
 
         realmc.realm_results_count(results, count)
         assertEquals(1, count[0])
+        assertEquals(1L, realmc.realm_results_count_direct(results))
+        val findFirstLink = realmc.realm_query_find_first_boxed(query) as Link
+        assertEquals(realmObjectGetKey, findFirstLink.objKey)
         // TODO Query basics? min, max, sum, average
         //  https://github.com/realm/realm-kotlin/issues/64
         val minFound = booleanArrayOf(false)
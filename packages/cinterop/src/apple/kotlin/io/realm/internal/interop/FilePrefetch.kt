@@ -0,0 +1,28 @@
+package io.realm.internal.interop
+
+import kotlinx.cinterop.alloc
+import kotlinx.cinterop.memScoped
+import kotlinx.cinterop.ptr
+import platform.posix.F_RDADVISE
+import platform.posix.fcntl
+import platform.posix.radvisory
+
+/**
+ * Advises the kernel to read the first [size] bytes of the open file [fd] into the page cache.
+ *
+ * Darwin has no posix_fadvise, but supports issuing read-ahead advice for a range of the file.
+ */
+internal fun adviseWillNeed(fd: Int, size: Long) {
+    memScoped {
+        val advisory = alloc<radvisory>()
+        var offset = 0L
+        while (offset < size) {
+            advisory.ra_offset = offset
+            advisory.ra_count = minOf(size - offset, Int.MAX_VALUE.toLong()).toInt()
+            if (fcntl(fd, F_RDADVISE, advisory.ptr) == -1) {
+                break
+            }
+            offset += advisory.ra_count
+        }
+    }
+}
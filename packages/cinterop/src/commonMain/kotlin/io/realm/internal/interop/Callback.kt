@@ -50,6 +50,19 @@ interface SyncErrorCallback {
     fun onSyncError(pointer: NativePointer, throwable: SyncException)
 }
 
+// Receives the chunks of data streamed by realm_write_copy_to_sink,
+// realm_results_export_arrow_to_sink and the helpers writing packed data. The buffer is reused
+// between calls, so only the first `length` bytes are valid and only during the call.
+interface WriteCopySink {
+    fun write(buffer: ByteArray, length: Int)
+}
+
+// Receives the progress of the operations of migrations set with
+// realm_config_set_schema_migration. Returning false aborts the migration.
+interface MigrationProgressCallback {
+    fun onProgress(operation: Int, processedObjects: Long, totalObjects: Long): Boolean
+}
+
 interface SyncLogCallback {
     // Passes core log levels as shorts to avoid unnecessary jumping between the SDK and JNI
     fun log(logLevel: Short, message: String?)
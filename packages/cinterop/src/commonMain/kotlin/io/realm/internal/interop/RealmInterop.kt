@@ -49,6 +49,13 @@ expect object RealmInterop {
     fun realm_config_set_max_number_of_active_versions(config: NativePointer, maxNumberOfVersions: Long)
     fun realm_config_set_encryption_key(config: NativePointer, encryptionKey: ByteArray)
     fun realm_config_get_encryption_key(config: NativePointer): ByteArray?
+    fun realm_config_set_in_memory(config: NativePointer, inMemory: Boolean)
+    // Advises the OS to read the file at the path into the page cache before it is accessed. Not
+    // part of the C-API and best effort, so failures, including a missing file, are ignored.
+    fun realm_prefetch_file(path: String)
+    // Returns the size of the file at the path in bytes or -1 if it cannot be determined. Not part of
+    // the C-API.
+    fun realm_get_file_size(path: String): Long
 
     fun realm_schema_validate(schema: NativePointer, mode: SchemaValidationMode): Boolean
 
@@ -134,6 +141,10 @@ expect object RealmInterop {
     // RLM_API bool realm_query_delete_all(const realm_query_t*);
     // RLM_API bool realm_results_delete_all(realm_results_t*);
 
+    // Storage maintenance
+    // Functions that need core objects not exposed by the C-API are only declared by the JVM actual
+    fun realm_has_search_index(realm: NativePointer, classKey: ClassKey, col: ColumnKey): Boolean
+
     fun realm_object_add_notification_callback(obj: NativePointer, callback: Callback): NativePointer
     fun realm_results_add_notification_callback(results: NativePointer, callback: Callback): NativePointer
     fun realm_list_add_notification_callback(list: NativePointer, callback: Callback): NativePointer
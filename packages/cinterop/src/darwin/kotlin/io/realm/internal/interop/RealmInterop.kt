@@ -61,9 +61,12 @@ import kotlinx.coroutines.CoroutineDispatcher
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.CoroutineStart
 import kotlinx.coroutines.launch
-import platform.posix.posix_errno
-import platform.posix.pthread_threadid_np
-import platform.posix.strerror
+import platform.posix.O_CLOEXEC
+import platform.posix.O_RDONLY
+import platform.posix.close
+import platform.posix.fstat
+import platform.posix.open
+import platform.posix.stat
 import platform.posix.uint8_tVar
 import realm_wrapper.realm_app_error_t
 import realm_wrapper.realm_class_info_t
@@ -92,6 +95,7 @@ import realm_wrapper.realm_value_t
 import realm_wrapper.realm_value_type
 import realm_wrapper.realm_version_id_t
 import kotlin.collections.set
+import kotlin.native.concurrent.Worker
 import kotlin.native.concurrent.freeze
 import kotlin.native.internal.createCleaner
 
@@ -326,6 +330,35 @@ actual object RealmInterop {
         }
     }
 
+    actual fun realm_config_set_in_memory(config: NativePointer, inMemory: Boolean) {
+        realm_wrapper.realm_config_set_in_memory(config.cptr(), inMemory)
+    }
+
+    actual fun realm_prefetch_file(path: String) {
+        val fd = open(path, O_RDONLY or O_CLOEXEC)
+        if (fd < 0) {
+            return
+        }
+        // The advice is platform specific, see FilePrefetch.kt of the apple and linux source sets
+        memScoped {
+            val fileStat = alloc<stat>()
+            if (fstat(fd, fileStat.ptr) == 0) {
+                adviseWillNeed(fd, fileStat.st_size)
+            }
+        }
+        close(fd)
+    }
+
+    actual fun realm_get_file_size(path: String): Long {
+        memScoped {
+            val fileStat = alloc<stat>()
+            if (stat(path, fileStat.ptr) != 0) {
+                return -1
+            }
+            return fileStat.st_size
+        }
+    }
+
     actual fun realm_config_set_schema(config: NativePointer, schema: NativePointer) {
         realm_wrapper.realm_config_set_schema(config.cptr(), schema.cptr())
     }
@@ -784,6 +817,23 @@ actual object RealmInterop {
         checkedBooleanResult(realm_wrapper.realm_object_delete(obj.cptr()))
     }
 
+    // Only reflects the indexes of the schema, as indexes cannot be changed at runtime through the
+    // C-API
+    actual fun realm_has_search_index(realm: NativePointer, classKey: ClassKey, col: ColumnKey): Boolean {
+        memScoped {
+            val propertyInfo = alloc<realm_property_info_t>()
+            checkedBooleanResult(
+                realm_wrapper.realm_get_property(
+                    realm.cptr(),
+                    classKey.key.toUInt(),
+                    col.key,
+                    propertyInfo.ptr
+                )
+            )
+            return (propertyInfo.flags and PropertyFlag.RLM_PROPERTY_INDEXED.nativeValue.toInt()) != 0
+        }
+    }
+
     actual fun realm_object_add_notification_callback(
         obj: NativePointer,
         callback: Callback
@@ -1414,18 +1464,8 @@ private fun printlnWithTid(s: String) {
     val tid = tid()
     println("<" + tid.toString() + "> $s")
 }
-private fun tid(): ULong {
-    memScoped {
-        initRuntimeIfNeeded()
-        val tidVar = alloc<ULongVar>()
-        pthread_threadid_np(null, tidVar.ptr).ensureUnixCallResult("pthread_threadid_np")
-        return tidVar.value
-    }
-}
-private fun getUnixError() = strerror(posix_errno())!!.toKString()
-private inline fun Int.ensureUnixCallResult(s: String): Int {
-    if (this != 0) {
-        throw Error("$s ${getUnixError()}")
-    }
-    return this
+// Worker ids are used instead of pthread_threadid_np as the latter is not available on Linux
+private fun tid(): Int {
+    initRuntimeIfNeeded()
+    return Worker.current.id
 }
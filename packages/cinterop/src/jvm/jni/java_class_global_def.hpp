@@ -46,6 +46,7 @@ private:
         , m_io_realm_network_transport(env, "io/realm/internal/interop/sync/NetworkTransport", false)
         , m_io_realm_response(env, "io/realm/internal/interop/sync/Response", false)
         , m_io_realm_long_pointer_wrapper(env, "io/realm/internal/interop/LongPointerWrapper", false)
+        , m_io_realm_unmanaged_pointer(env, "io/realm/internal/interop/UnmanagedPointer", false)
         , m_io_realm_sync_exception(env, "io/realm/mongodb/SyncException", false)
         , m_io_realm_mongodb_app_exception(env, "io/realm/mongodb/AppException", false)
         , m_io_realm_sync_log_callback(env, "io/realm/internal/interop/SyncLogCallback", false)
@@ -57,6 +58,7 @@ private:
     jni_util::JavaClass m_io_realm_network_transport;
     jni_util::JavaClass m_io_realm_response;
     jni_util::JavaClass m_io_realm_long_pointer_wrapper;
+    jni_util::JavaClass m_io_realm_unmanaged_pointer;
     jni_util::JavaClass m_io_realm_sync_exception;
     jni_util::JavaClass m_io_realm_mongodb_app_exception;
     jni_util::JavaClass m_io_realm_sync_log_callback;
@@ -102,6 +104,11 @@ public:
         return instance()->m_io_realm_long_pointer_wrapper;
     }
 
+    inline static const jni_util::JavaClass& unmanaged_pointer()
+    {
+        return instance()->m_io_realm_unmanaged_pointer;
+    }
+
     inline static const jni_util::JavaClass& sync_exception()
     {
         return instance()->m_io_realm_sync_exception;
@@ -26,11 +26,12 @@ import java.lang.Long.toHexString
 //  runtime-api mpp-module, which ruins IDE solving of the while type hierarchy around the
 //  pointers, which makes in annoying to work with.
 //  https://issuetracker.google.com/issues/174162078
-class LongPointerWrapper(val ptr: Long, managed: Boolean = true) : NativePointer {
+//
+// The wrapper owns the native handle, which is released by the NativeContext when the wrapper is
+// garbage collected. Handles that are not owned by the JVM are wrapped in an UnmanagedPointer.
+class LongPointerWrapper(val ptr: Long) : NativePointer {
     init {
-        if (managed) {
-            NativeContext.addReference(this)
-        }
+        NativeContext.addReference(this)
     }
 
     override fun toString(): String {
@@ -58,11 +58,9 @@ actual object RealmInterop {
     }
 
     actual fun realm_get_version_id(realm: NativePointer): Long {
-        val version = realm_version_id_t()
-        val found = BooleanArray(1)
-        realmc.realm_get_version_id(realm.cptr(), found, version)
-        return if (found[0]) {
-            version.version
+        val version = realmc.realm_get_version_id_direct(realm.cptr())
+        return if (version >= 0) {
+            version
         } else {
             throw IllegalStateException("No VersionId was available. Reading the VersionId requires a valid read transaction.")
         }
@@ -73,9 +71,7 @@ actual object RealmInterop {
     }
 
     actual fun realm_get_num_versions(realm: NativePointer): Long {
-        val result = LongArray(1)
-        realmc.realm_get_num_versions(realm.cptr(), result)
-        return result.first()
+        return realmc.realm_get_num_versions_direct(realm.cptr())
     }
 
     actual fun realm_schema_new(tables: List<Table>): NativePointer {
@@ -153,6 +149,18 @@ actual object RealmInterop {
         return null
     }
 
+    actual fun realm_config_set_in_memory(config: NativePointer, inMemory: Boolean) {
+        realmc.realm_config_set_in_memory(config.cptr(), inMemory)
+    }
+
+    actual fun realm_prefetch_file(path: String) {
+        realmc.realm_prefetch_file(path)
+    }
+
+    actual fun realm_get_file_size(path: String): Long {
+        return realmc.realm_get_file_size(path)
+    }
+
     actual fun realm_open(config: NativePointer, dispatcher: CoroutineDispatcher?): NativePointer {
         // create a custom Scheduler for JVM if a Coroutine Dispatcher is provided other wise pass null to use the generic one
         val realmPtr = LongPointerWrapper(
@@ -192,7 +200,7 @@ actual object RealmInterop {
     }
 
     actual fun realm_release(p: NativePointer) {
-        realmc.realm_release((p as LongPointerWrapper).ptr)
+        realmc.realm_release(p.cptr())
     }
 
     actual fun realm_is_closed(realm: NativePointer): Boolean {
@@ -232,23 +240,15 @@ actual object RealmInterop {
     }
 
     actual fun realm_object_resolve_in(obj: NativePointer, realm: NativePointer): NativePointer? {
-        val objectPointer = longArrayOf(0)
-        realmc.realm_object_resolve_in(obj.cptr(), realm.cptr(), objectPointer)
-        return if (objectPointer[0] != 0L) {
-            LongPointerWrapper(objectPointer[0])
-        } else {
-            null
-        }
+        return nativePointerOrNull(realmc.realm_object_resolve_in_direct(obj.cptr(), realm.cptr()))
     }
 
     actual fun realm_find_class(realm: NativePointer, name: String): ClassKey {
-        val info = realm_class_info_t()
-        val found = booleanArrayOf(false)
-        realmc.realm_find_class((realm as LongPointerWrapper).ptr, name, found, info)
-        if (!found[0]) {
+        val key = realmc.realm_find_class_key(realm.cptr(), name)
+        if (key < 0) {
             throw IllegalArgumentException("Cannot find class: '$name")
         }
-        return ClassKey(info.key)
+        return ClassKey(key)
     }
 
     actual fun realm_object_as_link(obj: NativePointer): Link {
@@ -261,32 +261,7 @@ actual object RealmInterop {
     }
 
     actual fun <T> realm_get_value(obj: NativePointer, key: ColumnKey): T {
-        // TODO OPTIMIZED Consider optimizing this to construct T in JNI call
-        val cvalue = realm_value_t()
-        realmc.realm_get_value((obj as LongPointerWrapper).ptr, key.key, cvalue)
-        return from_realm_value(cvalue)
-    }
-
-    private fun <T> from_realm_value(value: realm_value_t?): T {
-        return when (value?.type) {
-            realm_value_type_e.RLM_TYPE_STRING ->
-                value.string
-            realm_value_type_e.RLM_TYPE_INT ->
-                value.integer
-            realm_value_type_e.RLM_TYPE_BOOL ->
-                value._boolean
-            realm_value_type_e.RLM_TYPE_FLOAT ->
-                value.fnum
-            realm_value_type_e.RLM_TYPE_DOUBLE ->
-                value.dnum
-            realm_value_type_e.RLM_TYPE_LINK ->
-                value.asLink()
-            realm_value_type_e.RLM_TYPE_NULL,
-            null ->
-                null
-            else ->
-                TODO("Unsupported type for from_realm_value ${value.type}")
-        } as T
+        return realmc.realm_get_value_boxed(obj.cptr(), key.key) as T
     }
 
     actual fun <T> realm_set_value(o: NativePointer, key: ColumnKey, value: T, isDefault: Boolean) {
@@ -299,15 +274,11 @@ actual object RealmInterop {
     }
 
     actual fun realm_list_size(list: NativePointer): Long {
-        val size = LongArray(1)
-        realmc.realm_list_size(list.cptr(), size)
-        return size[0]
+        return realmc.realm_list_size_direct(list.cptr())
     }
 
     actual fun <T> realm_list_get(list: NativePointer, index: Long): T {
-        val cvalue = realm_value_t()
-        realmc.realm_list_get(list.cptr(), index, cvalue)
-        return from_realm_value(cvalue)
+        return realmc.realm_list_get_boxed(list.cptr(), index) as T
     }
 
     actual fun <T> realm_list_add(list: NativePointer, index: Long, value: T) {
@@ -333,13 +304,7 @@ actual object RealmInterop {
         list: NativePointer,
         realm: NativePointer
     ): NativePointer? {
-        val listPointer = longArrayOf(0)
-        realmc.realm_list_resolve_in(list.cptr(), realm.cptr(), listPointer)
-        return if (listPointer[0] != 0L) {
-            LongPointerWrapper(listPointer[0])
-        } else {
-            null
-        }
+        return nativePointerOrNull(realmc.realm_list_resolve_in_direct(list.cptr(), realm.cptr()))
     }
 
     actual fun realm_list_is_valid(list: NativePointer): Boolean {
@@ -405,30 +370,20 @@ actual object RealmInterop {
     }
 
     actual fun realm_object_add_notification_callback(obj: NativePointer, callback: Callback): NativePointer {
-        return LongPointerWrapper(
+        return UnmanagedPointer(
             realmc.register_object_notification_cb(
                 obj.cptr(),
-                object : NotificationCallback {
-                    override fun onChange(pointer: Long) {
-                        callback.onChange(LongPointerWrapper(pointer, managed = false)) // FIXME use managed pointer https://github.com/realm/realm-kotlin/issues/147
-                    }
-                }
-            ),
-            managed = false
+                notificationCallback(callback)
+            )
         )
     }
 
     actual fun realm_results_add_notification_callback(results: NativePointer, callback: Callback): NativePointer {
-        return LongPointerWrapper(
+        return UnmanagedPointer(
             realmc.register_results_notification_cb(
                 results.cptr(),
-                object : NotificationCallback {
-                    override fun onChange(pointer: Long) {
-                        callback.onChange(LongPointerWrapper(pointer, managed = false)) // FIXME use managed pointer https://github.com/realm/realm-kotlin/issues/147
-                    }
-                }
-            ),
-            managed = false
+                notificationCallback(callback)
+            )
         )
     }
 
@@ -436,19 +391,28 @@ actual object RealmInterop {
         list: NativePointer,
         callback: Callback
     ): NativePointer {
-        return LongPointerWrapper(
+        return UnmanagedPointer(
             realmc.register_list_notification_cb(
                 list.cptr(),
-                object : NotificationCallback {
-                    override fun onChange(pointer: Long) {
-                        callback.onChange(LongPointerWrapper(pointer, managed = false)) // FIXME use managed pointer https://github.com/realm/realm-kotlin/issues/147
-                    }
-                }
-            ),
-            managed = false
+                notificationCallback(callback)
+            )
         )
     }
 
+    // Change sets are only valid for the duration of a callback and the callbacks of a registration
+    // are delivered one at a time, so a single pointer is reused for all change sets of the
+    // registration instead of allocating a wrapper per notification.
+    // FIXME use managed pointer https://github.com/realm/realm-kotlin/issues/147
+    private fun notificationCallback(callback: Callback): NotificationCallback {
+        val change = UnmanagedPointer(0)
+        return object : NotificationCallback {
+            override fun onChange(pointer: Long) {
+                change.ptr = pointer
+                callback.onChange(change)
+            }
+        }
+    }
+
     actual fun realm_app_get(
         appConfig: NativePointer,
         syncClientConfig: NativePointer,
@@ -621,7 +585,7 @@ actual object RealmInterop {
 
     actual fun realm_query_parse(realm: NativePointer, table: String, query: String, vararg args: Any?): NativePointer {
         val count = args.size
-        val classKey = classInfo(realm, table).key
+        val classKey = realm_find_class(realm, table).key
         val cArgs = realmc.new_valueArray(count)
         args.mapIndexed { i, arg ->
             realmc.valueArray_setitem(cArgs, i, to_realm_value(arg))
@@ -630,13 +594,7 @@ actual object RealmInterop {
     }
 
     actual fun realm_query_find_first(realm: NativePointer): Link? {
-        val value = realm_value_t()
-        val found = booleanArrayOf(false)
-        realmc.realm_query_find_first(realm.cptr(), value, found)
-        if (!found[0]) {
-            return null
-        }
-        return value.asLink()
+        return realmc.realm_query_find_first_boxed(realm.cptr()) as Link?
     }
 
     actual fun realm_query_find_all(query: NativePointer): NativePointer {
@@ -648,16 +606,12 @@ actual object RealmInterop {
     }
 
     actual fun realm_results_count(results: NativePointer): Long {
-        val count = LongArray(1)
-        realmc.realm_results_count(results.cptr(), count)
-        return count[0]
+        return realmc.realm_results_count_direct(results.cptr())
     }
 
     // TODO OPTIMIZE Getting a range
     actual fun <T> realm_results_get(results: NativePointer, index: Long): Link {
-        val value = realm_value_t()
-        realmc.realm_results_get(results.cptr(), index, value)
-        return value.asLink()
+        return realmc.realm_results_get_boxed(results.cptr(), index) as Link
     }
 
     actual fun realm_get_object(realm: NativePointer, link: Link): NativePointer {
@@ -666,8 +620,7 @@ actual object RealmInterop {
 
     actual fun realm_object_find_with_primary_key(realm: NativePointer, classKey: ClassKey, primaryKey: Any?): NativePointer? {
         val cprimaryKey = to_realm_value(primaryKey)
-        val found = booleanArrayOf(false)
-        return nativePointerOrNull(realmc.realm_object_find_with_primary_key(realm.cptr(), classKey.key, cprimaryKey, found))
+        return nativePointerOrNull(realmc.realm_object_find_with_primary_key_direct(realm.cptr(), classKey.key, cprimaryKey))
     }
 
     actual fun realm_results_delete_all(results: NativePointer) {
@@ -678,24 +631,100 @@ actual object RealmInterop {
         realmc.realm_object_delete((obj as LongPointerWrapper).ptr)
     }
 
+    // Functions below without an actual modifier are JVM only, as they need core objects that are
+    // not exposed by the C-API. They back the JVM only extensions of library-base.
+    fun realm_enumerate_string_column(realm: NativePointer, classKey: ClassKey, col: ColumnKey) {
+        realmc.realm_enumerate_string_column(realm.cptr(), classKey.key, col.key)
+    }
+
+    fun realm_add_search_index(realm: NativePointer, classKey: ClassKey, col: ColumnKey) {
+        realmc.realm_add_search_index(realm.cptr(), classKey.key, col.key)
+    }
+
+    fun realm_remove_search_index(realm: NativePointer, classKey: ClassKey, col: ColumnKey) {
+        realmc.realm_remove_search_index(realm.cptr(), classKey.key, col.key)
+    }
+
+    fun realm_write_copy_to_path(realm: NativePointer, path: String, encryptionKey: ByteArray?) {
+        val key = encryptionKey ?: ByteArray(0)
+        realmc.realm_write_copy_to_path(realm.cptr(), path, key, key.size.toLong())
+    }
+
+    fun realm_write_copy_to_sink(realm: NativePointer, sink: WriteCopySink) {
+        realmc.realm_write_copy_to_sink(realm.cptr(), sink)
+    }
+
+    fun realm_results_export_arrow_to_path(results: NativePointer, columns: List<ColumnKey>, batchSize: Long, path: String) {
+        val keys = LongArray(columns.size) { columns[it].key }
+        realmc.realm_results_export_arrow_to_path(results.cptr(), keys, keys.size.toLong(), batchSize, path)
+    }
+
+    fun realm_results_export_arrow_to_sink(results: NativePointer, columns: List<ColumnKey>, batchSize: Long, sink: WriteCopySink) {
+        val keys = LongArray(columns.size) { columns[it].key }
+        realmc.realm_results_export_arrow_to_sink(results.cptr(), keys, keys.size.toLong(), batchSize, sink)
+    }
+
+    fun realm_ndjson_importer_from_file(path: String): NativePointer {
+        return LongPointerWrapper(realmc.realm_ndjson_importer_from_file(path))
+    }
+
+    fun realm_ndjson_importer_from_buffer(buffer: ByteArray): NativePointer {
+        return LongPointerWrapper(realmc.realm_ndjson_importer_from_buffer(buffer, buffer.size.toLong()))
+    }
+
+    fun realm_ndjson_importer_import(importer: NativePointer, realm: NativePointer, classKey: ClassKey, maxObjects: Long): Long {
+        return realmc.realm_ndjson_importer_import(importer.cptr(), realm.cptr(), classKey.key, maxObjects)
+    }
+
+    fun realm_ndjson_importer_bytes_read(importer: NativePointer): Long {
+        return realmc.realm_ndjson_importer_bytes_read(importer.cptr())
+    }
+
+    fun realm_object_copy_packed(obj: NativePointer, maxDepth: Long, sink: WriteCopySink) {
+        realmc.realm_object_copy_packed(obj.cptr(), maxDepth, sink)
+    }
+
+    fun realm_results_copy_packed(results: NativePointer, maxDepth: Long, sink: WriteCopySink) {
+        realmc.realm_results_copy_packed(results.cptr(), maxDepth, sink)
+    }
+
+    fun realm_config_set_schema_migration(config: NativePointer, plan: ByteArray, callback: MigrationProgressCallback) {
+        realmc.realm_config_set_schema_migration(config.cptr(), plan, plan.size.toLong(), callback)
+    }
+
+    fun realm_get_schema_packed(realm: NativePointer, sink: WriteCopySink) {
+        realmc.realm_get_schema_packed(realm.cptr(), sink)
+    }
+
+    fun realm_results_read_rows(results: NativePointer, columns: List<ColumnKey>, offset: Long, count: Long, sink: WriteCopySink) {
+        val keys = LongArray(columns.size) { columns[it].key }
+        realmc.realm_results_read_rows(results.cptr(), keys, keys.size.toLong(), offset, count, sink)
+    }
+
+    fun realm_read_rows(realm: NativePointer, classKey: ClassKey, objectKeys: LongArray, columns: List<ColumnKey>, sink: WriteCopySink) {
+        val keys = LongArray(columns.size) { columns[it].key }
+        realmc.realm_read_rows(realm.cptr(), classKey.key, objectKeys, objectKeys.size.toLong(), keys, keys.size.toLong(), sink)
+    }
+
+    actual fun realm_has_search_index(realm: NativePointer, classKey: ClassKey, col: ColumnKey): Boolean {
+        return realmc.realm_has_search_index(realm.cptr(), classKey.key, col.key) != 0
+    }
+
     fun NativePointer.cptr(): Long {
-        return (this as LongPointerWrapper).ptr
+        return when (this) {
+            is LongPointerWrapper -> ptr
+            is UnmanagedPointer -> ptr
+            else -> error("Unknown pointer type: $this")
+        }
     }
 
-    private fun nativePointerOrNull(ptr: Long, managed: Boolean = true): NativePointer? {
+    private fun nativePointerOrNull(ptr: Long): NativePointer? {
         return if (ptr != 0L) {
-            LongPointerWrapper(ptr, managed)
+            LongPointerWrapper(ptr)
         } else {
             null
         }
     }
-
-    private fun realm_value_t.asLink(): Link {
-        if (this.type != realm_value_type_e.RLM_TYPE_LINK) {
-            error("Value is not of type link: $this.type")
-        }
-        return Link(this.link.target_table, this.link.target)
-    }
 }
 
 private class JVMScheduler(dispatcher: CoroutineDispatcher) {
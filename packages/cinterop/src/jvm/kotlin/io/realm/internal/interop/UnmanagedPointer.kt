@@ -0,0 +1,35 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal.interop
+
+import java.lang.Long.toHexString
+
+// JVM/Android specific pointer to a native handle that is not owned by the JVM, like notification
+// tokens that are released explicitly and change sets that are only valid for the duration of a
+// callback. Opposed to LongPointerWrapper these are not tracked by the NativeContext, so they don't
+// need a phantom reference. Inside the interop layer these handles are kept as raw longs and only
+// wrapped when handed out as a NativePointer. It is a plain class, so the JNI code can construct it
+// through its constructor instead of depending on compiler generated boxing methods. The pointer
+// is mutable, so notification callbacks can reuse one instance for all change sets.
+class UnmanagedPointer(ptr: Long) : NativePointer {
+    var ptr: Long = ptr
+        internal set
+
+    override fun toString(): String {
+        return toHexString(ptr)
+    }
+}
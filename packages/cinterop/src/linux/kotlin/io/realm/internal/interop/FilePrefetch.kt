@@ -0,0 +1,13 @@
+package io.realm.internal.interop
+
+import platform.posix.POSIX_FADV_WILLNEED
+import platform.posix.posix_fadvise
+
+/**
+ * Advises the kernel to read the first [size] bytes of the open file [fd] into the page cache.
+ *
+ * The read-ahead is asynchronous, so this returns before the file has been read.
+ */
+internal fun adviseWillNeed(fd: Int, size: Long) {
+    posix_fadvise(fd, 0, size, POSIX_FADV_WILLNEED)
+}
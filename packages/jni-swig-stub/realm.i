@@ -93,7 +93,7 @@ return $jnicall;
                realm_results_t*, realm_notification_token_t*, realm_object_changes_t*,
                realm_list_t*, realm_app_credentials_t*, realm_app_config_t*, realm_app_t*,
                realm_sync_client_config_t*, realm_user_t*, realm_sync_config_t*,
-               realm_http_completion_func_t, realm_http_transport_t*};
+               realm_http_completion_func_t, realm_http_transport_t*, realm_ndjson_importer_t*};
 
 // For all functions returning a pointer or bool, check for null/false and throw an error if
 // realm_get_last_error returns true.
@@ -101,31 +101,6 @@ return $jnicall;
 // we have a distinction (type map, etc.) in the C API that we can use for targeting the type map.
 bool realm_object_is_valid(const realm_object_t*);
 
-%{
-void throw_as_java_exception(JNIEnv *jenv) {
-    realm_error_t error;
-    if (realm_get_last_error(&error)) {
-        std::string message("[" + std::to_string(error.error) + "]: " + error.message);
-        realm_clear_last_error();
-
-        // Invoke CoreErrorUtils.coreErrorAsThrowable() to retrieve an exception instance that
-        // maps to the core error.
-        jclass error_type_class = (jenv)->FindClass("io/realm/internal/interop/CoreErrorUtils");
-        static jmethodID error_type_as_exception = (jenv)->GetStaticMethodID(error_type_class,
-                                                                      "coreErrorAsThrowable",
-                                                                      "(ILjava/lang/String;)Ljava/lang/Throwable;");
-        jstring error_message = (jenv)->NewStringUTF(message.c_str());
-
-        jobject exception = (jenv)->CallStaticObjectMethod(
-                error_type_class,
-                error_type_as_exception,
-                jint(error.error),
-                error_message);
-        (jenv)->Throw(reinterpret_cast<jthrowable>(exception));
-    }
-}
-%}
-
 %typemap(out) SWIGTYPE* {
     if (!result) {
         throw_as_java_exception(jenv);
@@ -167,6 +142,14 @@ void throw_as_java_exception(JNIEnv *jenv) {
 %apply int8_t[] {uint8_t *key};
 %apply int8_t[] {uint8_t *out_key};
 
+// Enable passing the column keys of Arrow exports and the keys of rows as long[]
+%apply int64_t[] {int64_t *col_keys};
+%apply int64_t[] {int64_t *obj_keys};
+
+// Enable passing the buffers of JSON imports and migration plans as byte[]
+%apply int8_t[] {int8_t *ndjson_data};
+%apply int8_t[] {int8_t *migration_plan};
+
 // Enable passing output argument pointers as long[]
 %apply int64_t[] {void **};
 // Type map for int64_t has an erroneous cast, don't know how to fix it except with this
@@ -238,6 +221,9 @@ void throw_as_java_exception(JNIEnv *jenv) {
 // Swig doesn't understand __attribute__ so eliminate it
 #define __attribute__(x)
 
+// Shared with the hand written helpers, but not part of the wrapped API
+%ignore "throw_as_java_exception";
+
 %include "realm.h"
 %include "src/main/jni/realm_api_helpers.h"
 
@@ -0,0 +1,470 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "arrow_ipc.hpp"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <realm/obj.hpp>
+#include <realm/table.hpp>
+
+namespace realm::arrow_ipc {
+namespace {
+
+// Enum and union values of the Arrow format, see format/Schema.fbs and format/Message.fbs of
+// https://github.com/apache/arrow
+constexpr int16_t metadata_version_v5 = 4;
+constexpr int16_t endianness_little = 0;
+constexpr uint8_t header_schema = 1;
+constexpr uint8_t header_record_batch = 3;
+constexpr uint8_t type_int = 2;
+constexpr uint8_t type_floating_point = 3;
+constexpr uint8_t type_utf8 = 5;
+constexpr uint8_t type_bool = 6;
+constexpr int16_t precision_single = 1;
+constexpr int16_t precision_double = 2;
+
+constexpr uint32_t continuation_marker = 0xFFFFFFFF;
+// Buffers of the message body must start at multiples of 8 bytes
+constexpr size_t body_alignment = 8;
+
+size_t align(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// Minimal writer of FlatBuffers, the serialization format of Arrow metadata. Unlike the FlatBuffers
+// library it writes front to back, with tables written before the objects they reference, which
+// keeps all offsets pointing forward as the format requires. Scalars are written in the byte order
+// of the host, which is little-endian on all supported platforms.
+class FlatBufferWriter {
+public:
+    // Writes an object and returns its position
+    using ObjectWriter = std::function<size_t(FlatBufferWriter&)>;
+
+    class Table {
+    public:
+        template <typename T>
+        Table& scalar(uint16_t id, T value)
+        {
+            Field field{id, sizeof(T), std::vector<uint8_t>(sizeof(T)), nullptr};
+            std::memcpy(field.bytes.data(), &value, sizeof(T));
+            m_fields.push_back(std::move(field));
+            return *this;
+        }
+
+        Table& offset(uint16_t id, ObjectWriter object)
+        {
+            m_fields.push_back(Field{id, sizeof(uint32_t), std::vector<uint8_t>(sizeof(uint32_t)), std::move(object)});
+            return *this;
+        }
+
+    private:
+        friend class FlatBufferWriter;
+
+        struct Field {
+            uint16_t id;
+            size_t size;
+            std::vector<uint8_t> bytes;
+            ObjectWriter object;
+        };
+
+        std::vector<Field> m_fields;
+    };
+
+    std::vector<uint8_t> finish(const ObjectWriter& root)
+    {
+        m_data.assign(sizeof(uint32_t), 0);
+        patch(0, root(*this));
+        pad(8);
+        return std::move(m_data);
+    }
+
+    size_t table(Table table)
+    {
+        auto& fields = table.m_fields;
+        // Lay out the fields by decreasing size, so they are aligned to their size
+        std::stable_sort(fields.begin(), fields.end(), [](const auto& a, const auto& b) {
+            return a.size > b.size;
+        });
+        uint16_t num_ids = 0;
+        for (const auto& field : fields) {
+            num_ids = std::max<uint16_t>(num_ids, field.id + 1);
+        }
+        std::vector<uint16_t> vtable(2 + num_ids, 0);
+        size_t size = sizeof(int32_t);
+        for (const auto& field : fields) {
+            size = align(size, field.size);
+            vtable[2 + field.id] = uint16_t(size);
+            size += field.size;
+        }
+        vtable[0] = uint16_t(vtable.size() * sizeof(uint16_t));
+        vtable[1] = uint16_t(size);
+
+        pad(2);
+        size_t vtable_position = m_data.size();
+        for (uint16_t entry : vtable) {
+            append(entry);
+        }
+        // Tables start at multiples of 8 bytes, so their 8 byte fields are aligned
+        pad(8);
+        size_t position = m_data.size();
+        append(int32_t(position - vtable_position));
+        m_data.resize(position + size);
+        for (const auto& field : fields) {
+            std::memcpy(m_data.data() + position + vtable[2 + field.id], field.bytes.data(), field.size);
+        }
+        for (const auto& field : fields) {
+            if (field.object) {
+                size_t at = position + vtable[2 + field.id];
+                patch(at, field.object(*this));
+            }
+        }
+        return position;
+    }
+
+    size_t string(const std::string& value)
+    {
+        pad(4);
+        size_t position = m_data.size();
+        append(uint32_t(value.size()));
+        m_data.insert(m_data.end(), value.begin(), value.end());
+        m_data.push_back(0);
+        return position;
+    }
+
+    size_t table_vector(const std::vector<ObjectWriter>& objects)
+    {
+        pad(4);
+        size_t position = m_data.size();
+        append(uint32_t(objects.size()));
+        size_t first = m_data.size();
+        m_data.resize(first + objects.size() * sizeof(uint32_t));
+        for (size_t i = 0; i < objects.size(); ++i) {
+            patch(first + i * sizeof(uint32_t), objects[i](*this));
+        }
+        return position;
+    }
+
+    // Writes a vector of structs of two longs, which is the layout of both the FieldNode and the
+    // Buffer structs
+    size_t long_pair_vector(const std::vector<std::pair<int64_t, int64_t>>& values)
+    {
+        // The elements following the length must start at a multiple of 8 bytes
+        pad(4);
+        if (m_data.size() % 8 == 0) {
+            append(uint32_t(0));
+        }
+        size_t position = m_data.size();
+        append(uint32_t(values.size()));
+        for (const auto& value : values) {
+            append(value.first);
+            append(value.second);
+        }
+        return position;
+    }
+
+private:
+    template <typename T>
+    void append(T value)
+    {
+        size_t position = m_data.size();
+        m_data.resize(position + sizeof(T));
+        std::memcpy(m_data.data() + position, &value, sizeof(T));
+    }
+
+    void pad(size_t alignment)
+    {
+        m_data.resize(align(m_data.size(), alignment), 0);
+    }
+
+    // Points the offset at the given position to the object at target
+    void patch(size_t at, size_t target)
+    {
+        uint32_t offset = uint32_t(target - at);
+        std::memcpy(m_data.data() + at, &offset, sizeof(offset));
+    }
+
+    std::vector<uint8_t> m_data;
+};
+
+using Table = FlatBufferWriter::Table;
+
+// Accumulates the Arrow buffers of a column for a record batch
+class ColumnBuilder {
+public:
+    ColumnBuilder(ColKey key, std::string name)
+        : m_key(key)
+        , m_name(std::move(name))
+        , m_type(key.get_type())
+    {
+        if (key.is_collection()) {
+            throw std::invalid_argument("List properties cannot be exported to Arrow: " + m_name);
+        }
+        switch (m_type) {
+            case col_type_Int:
+            case col_type_Bool:
+            case col_type_Float:
+            case col_type_Double:
+            case col_type_String:
+                break;
+            default:
+                throw std::invalid_argument("Properties of this type cannot be exported to Arrow: " + m_name);
+        }
+    }
+
+    size_t write_field(FlatBufferWriter& writer) const
+    {
+        uint8_t type_type;
+        Table type;
+        switch (m_type) {
+            case col_type_Int:
+                type_type = type_int;
+                type.scalar<int32_t>(0, 64).scalar<uint8_t>(1, 1);
+                break;
+            case col_type_Bool:
+                type_type = type_bool;
+                break;
+            case col_type_Float:
+                type_type = type_floating_point;
+                type.scalar<int16_t>(0, precision_single);
+                break;
+            case col_type_Double:
+                type_type = type_floating_point;
+                type.scalar<int16_t>(0, precision_double);
+                break;
+            default:
+                type_type = type_utf8;
+                break;
+        }
+        return writer.table(Table()
+            .offset(0, [this](FlatBufferWriter& w) { return w.string(m_name); })
+            .scalar<uint8_t>(1, m_key.is_nullable())
+            .scalar<uint8_t>(2, type_type)
+            .offset(3, [type](FlatBufferWriter& w) { return w.table(type); })
+            // Readers expect the children of a field to be present, even if empty
+            .offset(5, [](FlatBufferWriter& w) { return w.table_vector({}); }));
+    }
+
+    void reset()
+    {
+        m_length = 0;
+        m_null_count = 0;
+        m_validity.clear();
+        m_values.clear();
+        m_data.clear();
+        if (m_type == col_type_String) {
+            append_value(int32_t(0));
+        }
+    }
+
+    void append(const Obj& obj)
+    {
+        Mixed value = obj.get_any(m_key);
+        size_t row = m_length++;
+        bool is_null = value.is_null();
+        if (m_key.is_nullable()) {
+            m_validity.resize(align(m_length, 8) / 8, 0);
+            if (is_null) {
+                ++m_null_count;
+            }
+            else {
+                m_validity[row / 8] |= uint8_t(1 << (row % 8));
+            }
+        }
+        switch (m_type) {
+            case col_type_Int:
+                append_value(is_null ? int64_t(0) : value.get_int());
+                break;
+            case col_type_Bool:
+                m_values.resize(align(m_length, 8) / 8, 0);
+                if (!is_null && value.get_bool()) {
+                    m_values[row / 8] |= uint8_t(1 << (row % 8));
+                }
+                break;
+            case col_type_Float:
+                append_value(is_null ? 0.0f : value.get_float());
+                break;
+            case col_type_Double:
+                append_value(is_null ? 0.0 : value.get_double());
+                break;
+            default: {
+                if (!is_null) {
+                    StringData string = value.get_string();
+                    m_data.insert(m_data.end(), string.data(), string.data() + string.size());
+                }
+                if (m_data.size() > size_t(std::numeric_limits<int32_t>::max())) {
+                    throw std::invalid_argument("The strings of '" + m_name + "' exceed 2 GB in a batch. Use a smaller batch size.");
+                }
+                append_value(int32_t(m_data.size()));
+                break;
+            }
+        }
+    }
+
+    int64_t null_count() const
+    {
+        return int64_t(m_null_count);
+    }
+
+    // The buffers of the column in the order of the Arrow layout of its type. The validity bitmap is
+    // left empty if there are no nulls, as readers then treat all values as valid.
+    std::vector<const std::vector<uint8_t>*> buffers() const
+    {
+        static const std::vector<uint8_t> empty;
+        std::vector<const std::vector<uint8_t>*> buffers{m_null_count == 0 ? &empty : &m_validity, &m_values};
+        if (m_type == col_type_String) {
+            buffers.push_back(&m_data);
+        }
+        return buffers;
+    }
+
+private:
+    template <typename T>
+    void append_value(T value)
+    {
+        size_t position = m_values.size();
+        m_values.resize(position + sizeof(T));
+        std::memcpy(m_values.data() + position, &value, sizeof(T));
+    }
+
+    ColKey m_key;
+    std::string m_name;
+    ColumnType m_type;
+    size_t m_length = 0;
+    size_t m_null_count = 0;
+    std::vector<uint8_t> m_validity;
+    // Fixed width values, bits of booleans or offsets into the UTF-8 data of strings
+    std::vector<uint8_t> m_values;
+    std::vector<uint8_t> m_data;
+};
+
+// Writes an encapsulated message, which is the metadata prefixed by the continuation marker and its
+// size, followed by the body
+void write_message(std::ostream& out, const std::vector<uint8_t>& metadata,
+                   const std::vector<const std::vector<uint8_t>*>& body)
+{
+    static const char padding[body_alignment] = {};
+    uint32_t prefix[2] = {continuation_marker, uint32_t(metadata.size())};
+    out.write(reinterpret_cast<const char*>(prefix), sizeof(prefix));
+    out.write(reinterpret_cast<const char*>(metadata.data()), std::streamsize(metadata.size()));
+    for (const auto* buffer : body) {
+        out.write(reinterpret_cast<const char*>(buffer->data()), std::streamsize(buffer->size()));
+        out.write(padding, std::streamsize(align(buffer->size(), body_alignment) - buffer->size()));
+    }
+    if (!out) {
+        throw std::runtime_error("Could not write the Arrow stream");
+    }
+}
+
+std::vector<uint8_t> schema_message(const std::vector<ColumnBuilder>& columns)
+{
+    std::vector<FlatBufferWriter::ObjectWriter> fields;
+    for (const auto& column : columns) {
+        fields.push_back([&column](FlatBufferWriter& w) { return column.write_field(w); });
+    }
+    return FlatBufferWriter().finish([&](FlatBufferWriter& writer) {
+        return writer.table(Table()
+            .scalar<int16_t>(0, metadata_version_v5)
+            .scalar<uint8_t>(1, header_schema)
+            .offset(2, [&](FlatBufferWriter& w) {
+                return w.table(Table()
+                    .scalar<int16_t>(0, endianness_little)
+                    .offset(1, [&](FlatBufferWriter& w) { return w.table_vector(fields); }));
+            })
+            .scalar<int64_t>(3, 0));
+    });
+}
+
+void write_record_batch(std::ostream& out, int64_t length, const std::vector<ColumnBuilder>& columns)
+{
+    std::vector<std::pair<int64_t, int64_t>> nodes;
+    std::vector<std::pair<int64_t, int64_t>> buffer_locations;
+    std::vector<const std::vector<uint8_t>*> body;
+    int64_t body_length = 0;
+    for (const auto& column : columns) {
+        nodes.emplace_back(length, column.null_count());
+        for (const auto* buffer : column.buffers()) {
+            buffer_locations.emplace_back(body_length, int64_t(buffer->size()));
+            body.push_back(buffer);
+            body_length += int64_t(align(buffer->size(), body_alignment));
+        }
+    }
+    std::vector<uint8_t> metadata = FlatBufferWriter().finish([&](FlatBufferWriter& writer) {
+        return writer.table(Table()
+            .scalar<int16_t>(0, metadata_version_v5)
+            .scalar<uint8_t>(1, header_record_batch)
+            .offset(2, [&](FlatBufferWriter& w) {
+                return w.table(Table()
+                    .scalar<int64_t>(0, length)
+                    .offset(1, [&](FlatBufferWriter& w) { return w.long_pair_vector(nodes); })
+                    .offset(2, [&](FlatBufferWriter& w) { return w.long_pair_vector(buffer_locations); }));
+            })
+            .scalar<int64_t>(3, body_length));
+    });
+    write_message(out, metadata, body);
+}
+
+} // namespace
+
+size_t write_stream(Results& results, const std::vector<ColKey>& columns, size_t batch_size, std::ostream& out)
+{
+    if (batch_size == 0) {
+        throw std::invalid_argument("The batch size must be positive");
+    }
+    ConstTableRef table = results.get_table();
+    if (!table) {
+        throw std::invalid_argument("Only results of objects can be exported to Arrow");
+    }
+    std::vector<ColumnBuilder> builders;
+    builders.reserve(columns.size());
+    for (ColKey key : columns) {
+        if (!table->valid_column(key)) {
+            throw std::invalid_argument("Unknown column: " + std::to_string(key.value));
+        }
+        builders.emplace_back(key, std::string(table->get_column_name(key)));
+    }
+
+    write_message(out, schema_message(builders), {});
+    size_t size = results.size();
+    for (size_t start = 0; start < size; start += batch_size) {
+        size_t end = std::min(size, start + batch_size);
+        for (auto& builder : builders) {
+            builder.reset();
+        }
+        for (size_t row = start; row < end; ++row) {
+            Obj obj = results.get(row);
+            for (auto& builder : builders) {
+                builder.append(obj);
+            }
+        }
+        write_record_batch(out, int64_t(end - start), builders);
+    }
+    // End-of-stream marker
+    uint32_t end_of_stream[2] = {continuation_marker, 0};
+    out.write(reinterpret_cast<const char*>(end_of_stream), sizeof(end_of_stream));
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("Could not write the Arrow stream");
+    }
+    return size;
+}
+
+} // namespace realm::arrow_ipc
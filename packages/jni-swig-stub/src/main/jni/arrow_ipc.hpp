@@ -0,0 +1,41 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_ARROW_IPC_HPP
+#define REALM_ARROW_IPC_HPP
+
+#include <ostream>
+#include <vector>
+#include <realm/keys.hpp>
+#include <realm/object-store/results.hpp>
+
+namespace realm::arrow_ipc {
+
+// Writes the columns of the objects of results to out in the Arrow IPC streaming format, as a
+// schema message followed by record batches of at most batch_size rows and the end-of-stream
+// marker.
+//
+// Integer, boolean, float, double and string columns are supported and mapped to the Arrow Int64,
+// Bool, Float32, Float64 and Utf8 types. Nullable columns are exported as nullable fields with a
+// validity bitmap. Throws std::invalid_argument for any other column and std::runtime_error if
+// writing to out fails.
+//
+// Returns the number of rows written.
+size_t write_stream(Results& results, const std::vector<ColKey>& columns, size_t batch_size, std::ostream& out);
+
+} // namespace realm::arrow_ipc
+
+#endif // REALM_ARROW_IPC_HPP
@@ -0,0 +1,253 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dynamic_rows.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <realm/list.hpp>
+#include <realm/table.hpp>
+
+namespace realm::dynamic_rows {
+namespace {
+
+// Same tags as the values of backup journals on the Kotlin side
+constexpr char tag_null = 0;
+constexpr char tag_int = 1;
+constexpr char tag_bool = 2;
+constexpr char tag_float = 3;
+constexpr char tag_double = 4;
+constexpr char tag_string = 5;
+constexpr char tag_object = 6;
+constexpr char tag_list = 7;
+
+// Type byte of properties that cannot be read dynamically
+constexpr char type_unsupported = 0;
+
+class Writer {
+public:
+    explicit Writer(std::ostream& out)
+        : m_out(out)
+    {
+    }
+
+    void write_byte(char value)
+    {
+        m_out.put(value);
+    }
+
+    void write_int(uint32_t value)
+    {
+        write_little_endian(value, 4);
+    }
+
+    void write_long(uint64_t value)
+    {
+        write_little_endian(value, 8);
+    }
+
+    void write_string(StringData value)
+    {
+        write_int(uint32_t(value.size()));
+        m_out.write(value.data(), std::streamsize(value.size()));
+    }
+
+    void write_value(Mixed value)
+    {
+        if (value.is_null()) {
+            write_byte(tag_null);
+            return;
+        }
+        switch (value.get_type()) {
+            case type_Int:
+                write_byte(tag_int);
+                write_long(uint64_t(value.get_int()));
+                break;
+            case type_Bool:
+                write_byte(tag_bool);
+                write_byte(value.get_bool() ? 1 : 0);
+                break;
+            case type_Float: {
+                float f = value.get_float();
+                uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(bits));
+                write_byte(tag_float);
+                write_int(bits);
+                break;
+            }
+            case type_Double: {
+                double d = value.get_double();
+                uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                write_byte(tag_double);
+                write_long(bits);
+                break;
+            }
+            case type_String:
+                write_byte(tag_string);
+                write_string(value.get_string());
+                break;
+            default:
+                throw std::invalid_argument("Unsupported value type: " + std::to_string(int(value.get_type())));
+        }
+    }
+
+    void write_link(ObjKey key)
+    {
+        if (!key || key.is_unresolved()) {
+            write_byte(tag_null);
+            return;
+        }
+        write_byte(tag_object);
+        write_long(uint64_t(key.value));
+    }
+
+    void finish()
+    {
+        m_out.flush();
+        if (!m_out) {
+            throw std::runtime_error("Could not write the rows");
+        }
+    }
+
+private:
+    std::ostream& m_out;
+
+    void write_little_endian(uint64_t value, size_t bytes)
+    {
+        char buffer[8];
+        for (size_t i = 0; i < bytes; ++i) {
+            buffer[i] = char(value >> (i * 8));
+        }
+        m_out.write(buffer, std::streamsize(bytes));
+    }
+};
+
+char type_of(const realm_property_info_t& property)
+{
+    if (property.collection_type != RLM_COLLECTION_TYPE_NONE && property.collection_type != RLM_COLLECTION_TYPE_LIST) {
+        return type_unsupported;
+    }
+    switch (property.type) {
+        case RLM_PROPERTY_TYPE_INT:
+            return tag_int;
+        case RLM_PROPERTY_TYPE_BOOL:
+            return tag_bool;
+        case RLM_PROPERTY_TYPE_FLOAT:
+            return tag_float;
+        case RLM_PROPERTY_TYPE_DOUBLE:
+            return tag_double;
+        case RLM_PROPERTY_TYPE_STRING:
+            return tag_string;
+        case RLM_PROPERTY_TYPE_OBJECT:
+            return tag_object;
+        default:
+            return type_unsupported;
+    }
+}
+
+void check_type(const Table& table, ColKey col)
+{
+    switch (col.get_type()) {
+        case col_type_Int:
+        case col_type_Bool:
+        case col_type_Float:
+        case col_type_Double:
+        case col_type_String:
+        case col_type_Link:
+        case col_type_LinkList:
+            if (col.is_set() || col.is_dictionary()) {
+                break;
+            }
+            return;
+        default:
+            break;
+    }
+    throw std::invalid_argument("Unsupported type of '" + std::string(table.get_class_name()) + "." +
+                                std::string(table.get_column_name(col)) + "'");
+}
+
+} // namespace
+
+void write_schema(const std::vector<ClassSchema>& classes, std::ostream& out)
+{
+    Writer writer(out);
+    writer.write_int(uint32_t(classes.size()));
+    for (const ClassSchema& schema : classes) {
+        writer.write_string(schema.info.name);
+        writer.write_long(uint64_t(schema.info.key));
+        writer.write_string(schema.info.primary_key ? schema.info.primary_key : "");
+        writer.write_byte((schema.info.flags & RLM_CLASS_EMBEDDED) != 0 ? 1 : 0);
+        std::vector<const realm_property_info_t*> persisted;
+        for (const realm_property_info_t& property : schema.properties) {
+            if (property.type != RLM_PROPERTY_TYPE_LINKING_OBJECTS) {
+                persisted.push_back(&property);
+            }
+        }
+        writer.write_int(uint32_t(persisted.size()));
+        for (const realm_property_info_t* property : persisted) {
+            writer.write_string(property->name);
+            writer.write_long(uint64_t(property->key));
+            writer.write_byte(type_of(*property));
+            writer.write_byte(property->collection_type == RLM_COLLECTION_TYPE_LIST ? 1 : 0);
+            writer.write_byte((property->flags & RLM_PROPERTY_NULLABLE) != 0 ? 1 : 0);
+            writer.write_string(property->link_target ? property->link_target : "");
+        }
+    }
+    writer.finish();
+}
+
+void write_rows(const std::vector<Obj>& objects, const std::vector<ColKey>& columns, std::ostream& out)
+{
+    Writer writer(out);
+    if (!objects.empty()) {
+        for (ColKey col : columns) {
+            check_type(*objects.front().get_table(), col);
+        }
+    }
+    for (const Obj& obj : objects) {
+        writer.write_long(uint64_t(obj.get_key().value));
+        for (ColKey col : columns) {
+            if (col.get_type() == col_type_LinkList) {
+                LnkLst list = obj.get_linklist(col);
+                size_t size = list.size();
+                writer.write_byte(tag_list);
+                writer.write_int(uint32_t(size));
+                for (size_t i = 0; i < size; ++i) {
+                    writer.write_link(list.get(i));
+                }
+            }
+            else if (col.get_type() == col_type_Link) {
+                writer.write_link(obj.get<ObjKey>(col));
+            }
+            else if (col.is_list()) {
+                LstBasePtr list = obj.get_listbase_ptr(col);
+                size_t size = list->size();
+                writer.write_byte(tag_list);
+                writer.write_int(uint32_t(size));
+                for (size_t i = 0; i < size; ++i) {
+                    writer.write_value(list->get_any(i));
+                }
+            }
+            else {
+                writer.write_value(obj.get_any(col));
+            }
+        }
+    }
+    writer.finish();
+}
+
+} // namespace realm::dynamic_rows
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_DYNAMIC_ROWS_HPP
+#define REALM_DYNAMIC_ROWS_HPP
+
+#include <ostream>
+#include <vector>
+#include <realm/obj.hpp>
+#include "realm.h"
+
+namespace realm::dynamic_rows {
+
+// A class of the schema of a realm along with its persisted and computed properties
+struct ClassSchema {
+    realm_class_info_t info;
+    std::vector<realm_property_info_t> properties;
+};
+
+// Writes the classes to out for dynamic access without model classes. The schema is an int with the
+// number of classes followed by, per class, the name, the class key as a long, the name of the
+// primary key or an empty string, a byte that is 1 for embedded classes and an int with the number
+// of properties followed by the properties.
+//
+// A property is the name, the column key as a long, a type byte, a byte that is 1 for lists and 0
+// otherwise, a byte that is 1 for nullable properties and the name of the target class of links or
+// an empty string. The type byte is the tag of the values of the property in rows, see write_rows,
+// or 0 for types that cannot be read dynamically, including sets and dictionaries. Computed
+// properties are omitted.
+void write_schema(const std::vector<ClassSchema>& classes, std::ostream& out);
+
+// Writes a row per object to out with the object key as a long followed by the values of columns
+// in order, so rows of many objects are decoded in a single pass instead of reading every value
+// through the C-API.
+//
+// Values are a tag byte followed by nothing for null (0), a long for integers (1), a byte for
+// booleans (2), the raw bits of floats (3) and doubles (4), a string (5), the object key of the
+// target as a long for links (6), or an int size followed by the elements for lists (7). Strings are
+// an int length followed by the UTF-8 bytes, and ints and longs are little-endian. Throws
+// std::invalid_argument for columns of unsupported types and std::runtime_error if writing to out
+// fails.
+void write_rows(const std::vector<Obj>& objects, const std::vector<ColKey>& columns, std::ostream& out);
+
+} // namespace realm::dynamic_rows
+
+#endif // REALM_DYNAMIC_ROWS_HPP
@@ -0,0 +1,530 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ndjson_importer.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <realm/list.hpp>
+#include <realm/obj.hpp>
+#include <realm/table.hpp>
+
+namespace realm::ndjson {
+namespace {
+
+struct JsonValue {
+    enum class Type { Null, Bool, Integer, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    int64_t integer = 0;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> elements;
+    std::vector<std::pair<std::string, JsonValue>> members;
+};
+
+// Parser of a single JSON document. Expects the text to be null terminated, as std::string is.
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text)
+        : m_pos(text.data())
+        , m_end(text.data() + text.size())
+    {
+    }
+
+    JsonValue parse()
+    {
+        JsonValue value = parse_value(0);
+        skip_whitespace();
+        if (m_pos != m_end) {
+            fail("Unexpected characters after the JSON value");
+        }
+        return value;
+    }
+
+private:
+    // Bounds the recursion for nested arrays and objects
+    static constexpr int max_depth = 64;
+
+    [[noreturn]] static void fail(const std::string& message)
+    {
+        throw std::invalid_argument(message);
+    }
+
+    void skip_whitespace()
+    {
+        while (m_pos != m_end && (*m_pos == ' ' || *m_pos == '\t' || *m_pos == '\r' || *m_pos == '\n')) {
+            ++m_pos;
+        }
+    }
+
+    void expect(char c)
+    {
+        skip_whitespace();
+        if (m_pos == m_end || *m_pos != c) {
+            fail(std::string("Expected '") + c + "'");
+        }
+        ++m_pos;
+    }
+
+    // Skips the comma between elements of an array or members of an object, if present
+    bool skip_separator()
+    {
+        skip_whitespace();
+        if (m_pos != m_end && *m_pos == ',') {
+            ++m_pos;
+            return true;
+        }
+        return false;
+    }
+
+    void expect_literal(const char* literal)
+    {
+        for (const char* c = literal; *c; ++c, ++m_pos) {
+            if (m_pos == m_end || *m_pos != *c) {
+                fail(std::string("Invalid literal, expected '") + literal + "'");
+            }
+        }
+    }
+
+    JsonValue parse_value(int depth)
+    {
+        if (depth > max_depth) {
+            fail("JSON value is nested too deeply");
+        }
+        skip_whitespace();
+        if (m_pos == m_end) {
+            fail("Unexpected end of line");
+        }
+        JsonValue value;
+        switch (*m_pos) {
+            case '{':
+                value.type = JsonValue::Type::Object;
+                ++m_pos;
+                skip_whitespace();
+                if (m_pos != m_end && *m_pos == '}') {
+                    ++m_pos;
+                    return value;
+                }
+                while (true) {
+                    skip_whitespace();
+                    std::string name = parse_string();
+                    expect(':');
+                    value.members.emplace_back(std::move(name), parse_value(depth + 1));
+                    if (!skip_separator()) {
+                        break;
+                    }
+                }
+                expect('}');
+                return value;
+            case '[':
+                value.type = JsonValue::Type::Array;
+                ++m_pos;
+                skip_whitespace();
+                if (m_pos != m_end && *m_pos == ']') {
+                    ++m_pos;
+                    return value;
+                }
+                while (true) {
+                    value.elements.push_back(parse_value(depth + 1));
+                    if (!skip_separator()) {
+                        break;
+                    }
+                }
+                expect(']');
+                return value;
+            case '"':
+                value.type = JsonValue::Type::String;
+                value.string = parse_string();
+                return value;
+            case 't':
+                expect_literal("true");
+                value.type = JsonValue::Type::Bool;
+                value.boolean = true;
+                return value;
+            case 'f':
+                expect_literal("false");
+                value.type = JsonValue::Type::Bool;
+                return value;
+            case 'n':
+                expect_literal("null");
+                return value;
+            default:
+                return parse_number();
+        }
+    }
+
+    std::string parse_string()
+    {
+        if (m_pos == m_end || *m_pos != '"') {
+            fail("Expected a string");
+        }
+        ++m_pos;
+        std::string result;
+        while (true) {
+            const char* run = m_pos;
+            while (m_pos != m_end && *m_pos != '"' && *m_pos != '\\' && static_cast<unsigned char>(*m_pos) >= 0x20) {
+                ++m_pos;
+            }
+            result.append(run, m_pos);
+            if (m_pos == m_end) {
+                fail("Unterminated string");
+            }
+            char c = *m_pos++;
+            if (c == '"') {
+                return result;
+            }
+            if (c != '\\') {
+                fail("Control characters must be escaped in strings");
+            }
+            if (m_pos == m_end) {
+                fail("Unterminated string");
+            }
+            switch (*m_pos++) {
+                case '"': result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/': result += '/'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'u': append_utf8(result, parse_code_point()); break;
+                default: fail("Invalid escape sequence");
+            }
+        }
+    }
+
+    uint32_t parse_hex4()
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i, ++m_pos) {
+            if (m_pos == m_end) {
+                fail("Invalid unicode escape sequence");
+            }
+            char c = *m_pos;
+            value <<= 4;
+            if (c >= '0' && c <= '9') {
+                value |= uint32_t(c - '0');
+            }
+            else if (c >= 'a' && c <= 'f') {
+                value |= uint32_t(c - 'a' + 10);
+            }
+            else if (c >= 'A' && c <= 'F') {
+                value |= uint32_t(c - 'A' + 10);
+            }
+            else {
+                fail("Invalid unicode escape sequence");
+            }
+        }
+        return value;
+    }
+
+    // Parses the digits of a \u escape sequence, combining surrogate pairs
+    uint32_t parse_code_point()
+    {
+        uint32_t code_point = parse_hex4();
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+            if (m_end - m_pos < 2 || m_pos[0] != '\\' || m_pos[1] != 'u') {
+                fail("Unpaired surrogate in unicode escape sequence");
+            }
+            m_pos += 2;
+            uint32_t low = parse_hex4();
+            if (low < 0xDC00 || low > 0xDFFF) {
+                fail("Unpaired surrogate in unicode escape sequence");
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+        else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+            fail("Unpaired surrogate in unicode escape sequence");
+        }
+        return code_point;
+    }
+
+    static void append_utf8(std::string& out, uint32_t code_point)
+    {
+        if (code_point < 0x80) {
+            out += char(code_point);
+        }
+        else if (code_point < 0x800) {
+            out += char(0xC0 | (code_point >> 6));
+            out += char(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000) {
+            out += char(0xE0 | (code_point >> 12));
+            out += char(0x80 | ((code_point >> 6) & 0x3F));
+            out += char(0x80 | (code_point & 0x3F));
+        }
+        else {
+            out += char(0xF0 | (code_point >> 18));
+            out += char(0x80 | ((code_point >> 12) & 0x3F));
+            out += char(0x80 | ((code_point >> 6) & 0x3F));
+            out += char(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    bool skip_digits()
+    {
+        const char* start = m_pos;
+        while (m_pos != m_end && *m_pos >= '0' && *m_pos <= '9') {
+            ++m_pos;
+        }
+        return m_pos != start;
+    }
+
+    JsonValue parse_number()
+    {
+        // Validate the JSON number syntax, which is stricter than strtod
+        const char* start = m_pos;
+        if (*m_pos == '-') {
+            ++m_pos;
+        }
+        if (!skip_digits()) {
+            fail("Invalid JSON value");
+        }
+        bool integral = true;
+        if (m_pos != m_end && *m_pos == '.') {
+            ++m_pos;
+            integral = false;
+            if (!skip_digits()) {
+                fail("Invalid number");
+            }
+        }
+        if (m_pos != m_end && (*m_pos == 'e' || *m_pos == 'E')) {
+            ++m_pos;
+            integral = false;
+            if (m_pos != m_end && (*m_pos == '+' || *m_pos == '-')) {
+                ++m_pos;
+            }
+            if (!skip_digits()) {
+                fail("Invalid number");
+            }
+        }
+        JsonValue value;
+        if (integral) {
+            errno = 0;
+            long long integer = std::strtoll(start, nullptr, 10);
+            if (errno != ERANGE) {
+                value.type = JsonValue::Type::Integer;
+                value.integer = int64_t(integer);
+                return value;
+            }
+        }
+        value.type = JsonValue::Type::Number;
+        value.number = std::strtod(start, nullptr);
+        return value;
+    }
+
+    const char* m_pos;
+    const char* m_end;
+};
+
+bool is_blank(const std::string& line)
+{
+    return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+class ObjectImporter {
+public:
+    ObjectImporter(TableRef table, ColKey primary_key)
+        : m_table(std::move(table))
+        , m_primary_key(primary_key)
+    {
+    }
+
+    Obj create(const JsonValue* primary_key)
+    {
+        if (!m_primary_key) {
+            return m_table->create_object();
+        }
+        if (!primary_key) {
+            throw std::invalid_argument("Missing primary key '" + column_name(m_table, m_primary_key) + "'");
+        }
+        return m_table->create_object_with_primary_key(to_mixed(m_table, m_primary_key, *primary_key));
+    }
+
+    void set(Obj& obj, ColKey col, const JsonValue& value)
+    {
+        bool is_link = col.get_type() == col_type_Link || col.get_type() == col_type_LinkList;
+        if (col.is_list()) {
+            if (value.type != JsonValue::Type::Array) {
+                throw std::invalid_argument("Expected an array for '" + column_name(m_table, col) + "'");
+            }
+            if (is_link) {
+                LnkLst list = obj.get_linklist(col);
+                list.clear();
+                for (const auto& element : value.elements) {
+                    list.add(link_target(col, element));
+                }
+            }
+            else {
+                LstBasePtr list = obj.get_listbase_ptr(col);
+                list->clear();
+                for (size_t i = 0; i < value.elements.size(); ++i) {
+                    list->insert_any(i, to_mixed(m_table, col, value.elements[i]));
+                }
+            }
+        }
+        else if (is_link) {
+            if (value.type == JsonValue::Type::Null) {
+                obj.set_null(col);
+            }
+            else {
+                obj.set(col, link_target(col, value));
+            }
+        }
+        else {
+            obj.set_any(col, to_mixed(m_table, col, value));
+        }
+    }
+
+private:
+    static std::string column_name(const TableRef& table, ColKey col)
+    {
+        return std::string(table->get_column_name(col));
+    }
+
+    // Finds or creates the object a link points to by its primary key
+    ObjKey link_target(ColKey col, const JsonValue& primary_key)
+    {
+        TableRef target = m_table->get_link_target(col);
+        ColKey target_primary_key = target->get_primary_key_column();
+        if (!target_primary_key) {
+            throw std::invalid_argument("Links of '" + column_name(m_table, col) +
+                                        "' cannot be imported, as their target class has no primary key");
+        }
+        return target->create_object_with_primary_key(to_mixed(target, target_primary_key, primary_key)).get_key();
+    }
+
+    // The returned value refers to the strings of value, so it must not outlive it
+    static Mixed to_mixed(const TableRef& table, ColKey col, const JsonValue& value)
+    {
+        if (value.type == JsonValue::Type::Null) {
+            if (!col.is_nullable()) {
+                throw std::invalid_argument("'" + column_name(table, col) + "' cannot be null");
+            }
+            return Mixed();
+        }
+        switch (col.get_type()) {
+            case col_type_Int:
+                if (value.type == JsonValue::Type::Integer) {
+                    return Mixed(value.integer);
+                }
+                break;
+            case col_type_Bool:
+                if (value.type == JsonValue::Type::Bool) {
+                    return Mixed(value.boolean);
+                }
+                break;
+            case col_type_Float:
+                if (value.type == JsonValue::Type::Integer) {
+                    return Mixed(float(value.integer));
+                }
+                if (value.type == JsonValue::Type::Number) {
+                    return Mixed(float(value.number));
+                }
+                break;
+            case col_type_Double:
+                if (value.type == JsonValue::Type::Integer) {
+                    return Mixed(double(value.integer));
+                }
+                if (value.type == JsonValue::Type::Number) {
+                    return Mixed(value.number);
+                }
+                break;
+            case col_type_String:
+                if (value.type == JsonValue::Type::String) {
+                    return Mixed(StringData(value.string));
+                }
+                break;
+            default:
+                throw std::invalid_argument("Properties of the type of '" + column_name(table, col) +
+                                            "' cannot be imported");
+        }
+        throw std::invalid_argument("Invalid value for '" + column_name(table, col) + "'");
+    }
+
+    TableRef m_table;
+    ColKey m_primary_key;
+};
+
+} // namespace
+
+Importer::Importer(std::unique_ptr<std::istream> in)
+    : m_in(std::move(in))
+{
+}
+
+size_t Importer::import(TableRef table, const PropertyResolver& resolve_property, size_t max_objects)
+{
+    if (table->get_key() != m_table_key) {
+        m_table_key = table->get_key();
+        m_columns.clear();
+    }
+    ColKey primary_key = table->get_primary_key_column();
+    ObjectImporter importer(table, primary_key);
+    auto column = [&](const std::string& name) {
+        auto it = m_columns.find(name);
+        if (it == m_columns.end()) {
+            it = m_columns.emplace(name, resolve_property(name)).first;
+        }
+        return it->second;
+    };
+
+    size_t imported = 0;
+    while (imported < max_objects && std::getline(*m_in, m_line)) {
+        ++m_line_number;
+        m_bytes_read += m_line.size() + (m_in->eof() ? 0 : 1);
+        if (is_blank(m_line)) {
+            continue;
+        }
+        try {
+            JsonValue value = JsonParser(m_line).parse();
+            if (value.type != JsonValue::Type::Object) {
+                throw std::invalid_argument("Expected a JSON object");
+            }
+            const JsonValue* primary_key_value = nullptr;
+            if (primary_key) {
+                for (const auto& member : value.members) {
+                    if (column(member.first) == primary_key) {
+                        primary_key_value = &member.second;
+                    }
+                }
+            }
+            Obj obj = importer.create(primary_key_value);
+            for (const auto& member : value.members) {
+                ColKey col = column(member.first);
+                // Members without a property are ignored
+                if (col && col != primary_key) {
+                    importer.set(obj, col, member.second);
+                }
+            }
+        }
+        catch (const std::invalid_argument& e) {
+            throw std::invalid_argument("Line " + std::to_string(m_line_number) + ": " + e.what());
+        }
+        ++imported;
+    }
+    if (m_in->bad()) {
+        throw std::runtime_error("Could not read the JSON input");
+    }
+    return imported;
+}
+
+} // namespace realm::ndjson
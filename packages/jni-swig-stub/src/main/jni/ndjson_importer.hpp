@@ -0,0 +1,69 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_NDJSON_IMPORTER_HPP
+#define REALM_NDJSON_IMPORTER_HPP
+
+#include <functional>
+#include <istream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <realm/keys.hpp>
+#include <realm/table_ref.hpp>
+
+namespace realm::ndjson {
+
+// Resolves the column of a property of the imported class by its public name. Returns an invalid
+// column key for unknown properties.
+using PropertyResolver = std::function<ColKey(const std::string& name)>;
+
+// Imports objects from newline delimited JSON, with one JSON object per line. The input is read
+// incrementally, so it can be imported in batches of objects spread over several write
+// transactions.
+//
+// Members of the JSON objects are mapped to the properties of the class by name and members
+// without a property are ignored. Objects of classes with a primary key are upserted by their
+// primary key, which must be present. Links and lists of links are given as the primary keys of the
+// target objects, which are created if they do not exist yet. Properties missing from a JSON object
+// keep their current value, or the default value of their type for new objects.
+class Importer {
+public:
+    explicit Importer(std::unique_ptr<std::istream> in);
+
+    // Imports at most max_objects objects into table, which must be part of a write transaction.
+    // Returns the number of imported objects, which is 0 once the end of the input is reached.
+    // Throws std::invalid_argument for malformed lines and values not matching their property.
+    size_t import(TableRef table, const PropertyResolver& resolve_property, size_t max_objects);
+
+    // The number of bytes of the input consumed so far
+    uint64_t bytes_read() const
+    {
+        return m_bytes_read;
+    }
+
+private:
+    std::unique_ptr<std::istream> m_in;
+    std::string m_line;
+    size_t m_line_number = 0;
+    uint64_t m_bytes_read = 0;
+    TableKey m_table_key;
+    std::unordered_map<std::string, ColKey> m_columns;
+};
+
+} // namespace realm::ndjson
+
+#endif // REALM_NDJSON_IMPORTER_HPP
@@ -0,0 +1,311 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "packed_graph.hpp"
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <realm/list.hpp>
+#include <realm/table.hpp>
+
+namespace realm::packed_graph {
+namespace {
+
+constexpr char kind_class = 1;
+constexpr char kind_object = 2;
+
+// Same tags as the values of backup journals on the Kotlin side
+constexpr char tag_null = 0;
+constexpr char tag_int = 1;
+constexpr char tag_bool = 2;
+constexpr char tag_float = 3;
+constexpr char tag_double = 4;
+constexpr char tag_string = 5;
+constexpr char tag_object = 6;
+constexpr char tag_list = 7;
+
+// Little-endian encoding of records, which are buffered as the classes of the objects an object
+// links to have to be written before it
+class Encoder {
+public:
+    void write_byte(char value)
+    {
+        m_buffer.push_back(value);
+    }
+
+    void write_int(uint32_t value)
+    {
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            m_buffer.push_back(char(value >> (i * 8)));
+        }
+    }
+
+    void write_long(uint64_t value)
+    {
+        for (size_t i = 0; i < sizeof(value); ++i) {
+            m_buffer.push_back(char(value >> (i * 8)));
+        }
+    }
+
+    void write_string(StringData value)
+    {
+        write_int(uint32_t(value.size()));
+        m_buffer.append(value.data(), value.size());
+    }
+
+    const std::string& buffer() const
+    {
+        return m_buffer;
+    }
+
+    void clear()
+    {
+        m_buffer.clear();
+    }
+
+private:
+    std::string m_buffer;
+};
+
+struct ObjectId {
+    uint32_t table;
+    int64_t object;
+
+    bool operator==(const ObjectId& other) const
+    {
+        return table == other.table && object == other.object;
+    }
+};
+
+struct ObjectIdHash {
+    size_t operator()(const ObjectId& id) const
+    {
+        return std::hash<int64_t>()(id.object) * 31 + id.table;
+    }
+};
+
+class GraphWriter {
+public:
+    GraphWriter(size_t max_depth, std::ostream& out)
+        : m_max_depth(max_depth)
+        , m_out(out)
+    {
+    }
+
+    void write(const std::vector<Obj>& roots)
+    {
+        Encoder header;
+        header.write_int(uint32_t(roots.size()));
+        for (const Obj& root : roots) {
+            header.write_int(discover(root, 0).second);
+        }
+        flush(header);
+        while (!m_pending.empty()) {
+            auto [obj, depth] = std::move(m_pending.front());
+            m_pending.pop_front();
+            write_object(obj, depth);
+        }
+        m_out.flush();
+        if (!m_out) {
+            throw std::runtime_error("Could not write the object graph");
+        }
+    }
+
+private:
+    struct ClassInfo {
+        uint32_t index;
+        std::vector<ColKey> columns;
+    };
+
+    size_t m_max_depth;
+    std::ostream& m_out;
+    Encoder m_encoder;
+    Encoder m_class_records;
+    std::unordered_map<uint32_t, ClassInfo> m_classes;
+    std::unordered_map<ObjectId, uint32_t, ObjectIdHash> m_objects;
+    // Objects are written breadth first, so each object is reached at its minimal depth
+    std::deque<std::pair<Obj, size_t>> m_pending;
+
+    void flush(Encoder& encoder)
+    {
+        m_out.write(encoder.buffer().data(), std::streamsize(encoder.buffer().size()));
+        encoder.clear();
+    }
+
+    // Returns the class and object index of obj, queueing it to be written if not seen before
+    std::pair<uint32_t, uint32_t> discover(const Obj& obj, size_t depth)
+    {
+        const ClassInfo& info = class_info(obj.get_table());
+        ObjectId id{obj.get_table()->get_key().value, obj.get_key().value};
+        auto [it, inserted] = m_objects.emplace(id, uint32_t(m_objects.size()));
+        if (inserted) {
+            m_pending.emplace_back(obj, depth);
+        }
+        return {info.index, it->second};
+    }
+
+    // Encodes a class record the first time the class is seen, which is written before the record
+    // of the object referring to it
+    const ClassInfo& class_info(const ConstTableRef& table)
+    {
+        auto it = m_classes.find(table->get_key().value);
+        if (it != m_classes.end()) {
+            return it->second;
+        }
+        ClassInfo info{uint32_t(m_classes.size()), {}};
+        Encoder& record = m_class_records;
+        record.write_byte(kind_class);
+        record.write_long(table->get_key().value);
+        record.write_string(table->get_class_name());
+        auto keys = table->get_column_keys();
+        record.write_int(uint32_t(keys.size()));
+        for (ColKey col : keys) {
+            check_type(table, col);
+            record.write_string(table->get_column_name(col));
+            info.columns.push_back(col);
+        }
+        return m_classes.emplace(table->get_key().value, std::move(info)).first->second;
+    }
+
+    static void check_type(const ConstTableRef& table, ColKey col)
+    {
+        switch (col.get_type()) {
+            case col_type_Int:
+            case col_type_Bool:
+            case col_type_Float:
+            case col_type_Double:
+            case col_type_String:
+            case col_type_Link:
+            case col_type_LinkList:
+                return;
+            default:
+                throw std::invalid_argument("Unsupported type of '" + std::string(table->get_class_name()) + "." +
+                                            std::string(table->get_column_name(col)) + "'");
+        }
+    }
+
+    void write_object(const Obj& obj, size_t depth)
+    {
+        const ClassInfo& info = m_classes.at(obj.get_table()->get_key().value);
+        m_encoder.write_byte(kind_object);
+        m_encoder.write_int(info.index);
+        m_encoder.write_long(obj.get_key().value);
+        bool follow_links = depth < m_max_depth;
+        for (ColKey col : info.columns) {
+            if (col.get_type() == col_type_LinkList) {
+                write_link_list(obj, col, depth + 1, follow_links);
+            }
+            else if (col.get_type() == col_type_Link) {
+                ObjKey key = obj.get<ObjKey>(col);
+                if (!follow_links || !key || key.is_unresolved()) {
+                    m_encoder.write_byte(tag_null);
+                }
+                else {
+                    write_link(obj.get_table()->get_link_target(col)->get_object(key), depth + 1);
+                }
+            }
+            else if (col.is_list()) {
+                LstBasePtr list = obj.get_listbase_ptr(col);
+                size_t size = list->size();
+                m_encoder.write_byte(tag_list);
+                m_encoder.write_int(uint32_t(size));
+                for (size_t i = 0; i < size; ++i) {
+                    write_value(list->get_any(i));
+                }
+            }
+            else {
+                write_value(obj.get_any(col));
+            }
+        }
+        flush(m_class_records);
+        flush(m_encoder);
+    }
+
+    void write_link_list(const Obj& obj, ColKey col, size_t depth, bool follow_links)
+    {
+        m_encoder.write_byte(tag_list);
+        if (!follow_links) {
+            m_encoder.write_int(0);
+            return;
+        }
+        LnkLst list = obj.get_linklist(col);
+        size_t size = list.size();
+        m_encoder.write_int(uint32_t(size));
+        for (size_t i = 0; i < size; ++i) {
+            write_link(list.get_object(i), depth);
+        }
+    }
+
+    void write_link(const Obj& target, size_t depth)
+    {
+        auto [class_index, object_index] = discover(target, depth);
+        m_encoder.write_byte(tag_object);
+        m_encoder.write_int(class_index);
+        m_encoder.write_int(object_index);
+    }
+
+    void write_value(Mixed value)
+    {
+        if (value.is_null()) {
+            m_encoder.write_byte(tag_null);
+            return;
+        }
+        switch (value.get_type()) {
+            case type_Int:
+                m_encoder.write_byte(tag_int);
+                m_encoder.write_long(uint64_t(value.get_int()));
+                break;
+            case type_Bool:
+                m_encoder.write_byte(tag_bool);
+                m_encoder.write_byte(value.get_bool() ? 1 : 0);
+                break;
+            case type_Float: {
+                float f = value.get_float();
+                uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(bits));
+                m_encoder.write_byte(tag_float);
+                m_encoder.write_int(bits);
+                break;
+            }
+            case type_Double: {
+                double d = value.get_double();
+                uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                m_encoder.write_byte(tag_double);
+                m_encoder.write_long(bits);
+                break;
+            }
+            case type_String:
+                m_encoder.write_byte(tag_string);
+                m_encoder.write_string(value.get_string());
+                break;
+            default:
+                throw std::invalid_argument("Unsupported value type: " + std::to_string(int(value.get_type())));
+        }
+    }
+};
+
+} // namespace
+
+void write(const std::vector<Obj>& roots, size_t max_depth, std::ostream& out)
+{
+    GraphWriter(max_depth, out).write(roots);
+}
+
+} // namespace realm::packed_graph
@@ -0,0 +1,49 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_PACKED_GRAPH_HPP
+#define REALM_PACKED_GRAPH_HPP
+
+#include <ostream>
+#include <vector>
+#include <realm/obj.hpp>
+
+namespace realm::packed_graph {
+
+// Writes the objects reachable from roots by following at most max_depth links to out, so they can
+// be decoded into unmanaged objects without reading each property through the C-API.
+//
+// The graph starts with the number of roots and their object indices as ints, followed by a record
+// per class and object. A class record is the byte 1, the table key as a long, the class name and
+// the number of columns as an int followed by the column names. An object record is the byte 2, the
+// index of its class record as an int, the object key as a long and a value per column of its class.
+// Objects are indexed in the order of their records and every class record precedes the records
+// referring to it.
+//
+// Values are a tag byte followed by nothing for null, a long for integers, a byte for booleans, the
+// raw bits of floats and doubles, a string, the class index and object index as ints for links, or
+// an int size followed by the elements for lists. Strings are an int length followed by the UTF-8
+// bytes, and ints and longs are little-endian. Links beyond max_depth are written as null and lists
+// of links beyond max_depth as empty lists.
+//
+// Objects reachable through multiple paths, including cycles, are only written once. Throws
+// std::invalid_argument for columns of unsupported types and std::runtime_error if writing to out
+// fails.
+void write(const std::vector<Obj>& roots, size_t max_depth, std::ostream& out);
+
+} // namespace realm::packed_graph
+
+#endif // REALM_PACKED_GRAPH_HPP
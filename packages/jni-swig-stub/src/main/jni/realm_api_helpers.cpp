@@ -17,8 +17,27 @@
 #include "realm_api_helpers.h"
 #include <vector>
 #include <thread>
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <sstream>
+#include <ostream>
+#include <sys/stat.h>
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <realm/object-store/c_api/types.hpp>
 #include <realm/object-store/c_api/util.hpp>
+#include <realm/object-store/object_schema.hpp>
+#include <realm/index_string.hpp>
+#include <realm/util/file.hpp>
 #include "java_method.hpp"
+#include "arrow_ipc.hpp"
+#include "ndjson_importer.hpp"
+#include "packed_graph.hpp"
+#include "schema_migration.hpp"
+#include "dynamic_rows.hpp"
 
 using namespace realm::jni_util;
 using namespace realm::_impl;
@@ -265,8 +284,9 @@ void app_complete_result_callback(void* userdata, void* result, const realm_app_
     static JavaMethod java_notify_onsuccess(env, java_callback_class, "onSuccess",
                                             "(Ljava/lang/Object;)V");
 
-    static JavaClass native_pointer_class(env, "io/realm/internal/interop/LongPointerWrapper");
-    static JavaMethod native_pointer_constructor(env, native_pointer_class, "<init>", "(JZ)V");
+    // The result is not owned by the JVM
+    static JavaClass native_pointer_class(env, "io/realm/internal/interop/UnmanagedPointer");
+    static JavaMethod native_pointer_constructor(env, native_pointer_class, "<init>", "(J)V");
 
     if (env->ExceptionCheck()) {
         env->ExceptionDescribe();
@@ -278,7 +298,7 @@ void app_complete_result_callback(void* userdata, void* result, const realm_app_
         // Remember to clone user object or else it will be invalidated right after we leave this callback
         void* cloned_result = realm_clone(result);
         jobject pointer = env->NewObject(native_pointer_class, native_pointer_constructor,
-                                         reinterpret_cast<jlong>(cloned_result), false);
+                                         reinterpret_cast<jlong>(cloned_result));
         env->CallVoidMethod(static_cast<jobject>(userdata), java_notify_onsuccess, pointer);
     }
 }
@@ -464,15 +484,24 @@ void set_log_callback(realm_sync_client_config_t* sync_client_config, jobject lo
                                               });
 }
 
+// Wraps the pointer in a LongPointerWrapper if the JVM owns it and in an UnmanagedPointer otherwise
 jobject wrap_pointer(JNIEnv* jenv, jlong pointer, jboolean managed = false) {
-    static JavaMethod pointer_wrapper_constructor(jenv,
-                                                  JavaClassGlobalDef::long_pointer_wrapper(),
-                                                  "<init>",
-                                                  "(JZ)V");
-    return jenv->NewObject(JavaClassGlobalDef::long_pointer_wrapper(),
-                           pointer_wrapper_constructor,
-                           pointer,
-                           managed);
+    if (managed) {
+        static JavaMethod pointer_wrapper_constructor(jenv,
+                                                      JavaClassGlobalDef::long_pointer_wrapper(),
+                                                      "<init>",
+                                                      "(J)V");
+        return jenv->NewObject(JavaClassGlobalDef::long_pointer_wrapper(),
+                               pointer_wrapper_constructor,
+                               pointer);
+    }
+    static JavaMethod unmanaged_pointer_constructor(jenv,
+                                                    JavaClassGlobalDef::unmanaged_pointer(),
+                                                    "<init>",
+                                                    "(J)V");
+    return jenv->NewObject(JavaClassGlobalDef::unmanaged_pointer(),
+                           unmanaged_pointer_constructor,
+                           pointer);
 }
 
 jobject convert_sync_exception(JNIEnv* jenv, const realm_sync_error_t error) {
@@ -523,3 +552,702 @@ void sync_set_error_handler(realm_sync_config_t* sync_config, jobject error_hand
                                             get_env(true)->DeleteGlobalRef(static_cast<jobject>(userdata));
                                         });
 }
+
+void throw_as_java_exception(JNIEnv *jenv) {
+    realm_error_t error;
+    if (realm_get_last_error(&error)) {
+        std::string message("[" + std::to_string(error.error) + "]: " + error.message);
+        realm_clear_last_error();
+
+        // Invoke CoreErrorUtils.coreErrorAsThrowable() to retrieve an exception instance that
+        // maps to the core error.
+        jclass error_type_class = (jenv)->FindClass("io/realm/internal/interop/CoreErrorUtils");
+        static jmethodID error_type_as_exception = (jenv)->GetStaticMethodID(error_type_class,
+                                                                      "coreErrorAsThrowable",
+                                                                      "(ILjava/lang/String;)Ljava/lang/Throwable;");
+        jstring error_message = (jenv)->NewStringUTF(message.c_str());
+
+        jobject exception = (jenv)->CallStaticObjectMethod(
+                error_type_class,
+                error_type_as_exception,
+                jint(error.error),
+                error_message);
+        (jenv)->Throw(reinterpret_cast<jthrowable>(exception));
+    }
+}
+
+static void throw_unsupported_value_type(JNIEnv* jenv, int type) {
+    jenv->ThrowNew(jenv->FindClass("java/lang/UnsupportedOperationException"),
+                   ("Unsupported value type: " + std::to_string(type)).c_str());
+}
+
+static jobject realm_value_to_jobject(JNIEnv* jenv, const realm_value_t& value) {
+    static JavaClass long_class(jenv, "java/lang/Long");
+    static JavaMethod long_value_of(jenv, long_class, "valueOf", "(J)Ljava/lang/Long;", true);
+    static JavaClass boolean_class(jenv, "java/lang/Boolean");
+    static JavaMethod boolean_value_of(jenv, boolean_class, "valueOf", "(Z)Ljava/lang/Boolean;", true);
+    static JavaClass float_class(jenv, "java/lang/Float");
+    static JavaMethod float_value_of(jenv, float_class, "valueOf", "(F)Ljava/lang/Float;", true);
+    static JavaClass double_class(jenv, "java/lang/Double");
+    static JavaMethod double_value_of(jenv, double_class, "valueOf", "(D)Ljava/lang/Double;", true);
+    static JavaClass link_class(jenv, "io/realm/internal/interop/Link");
+    static JavaMethod link_constructor(jenv, link_class, "<init>", "(JJ)V");
+
+    switch (value.type) {
+        case RLM_TYPE_NULL:
+            return nullptr;
+        case RLM_TYPE_STRING:
+            return to_jstring(jenv, realm::StringData(value.string.data, value.string.size));
+        case RLM_TYPE_INT:
+            return jenv->CallStaticObjectMethod(long_class, long_value_of, jlong(value.integer));
+        case RLM_TYPE_BOOL:
+            return jenv->CallStaticObjectMethod(boolean_class, boolean_value_of, jboolean(value.boolean));
+        case RLM_TYPE_FLOAT:
+            return jenv->CallStaticObjectMethod(float_class, float_value_of, jfloat(value.fnum));
+        case RLM_TYPE_DOUBLE:
+            return jenv->CallStaticObjectMethod(double_class, double_value_of, jdouble(value.dnum));
+        case RLM_TYPE_LINK:
+            return jenv->NewObject(link_class, link_constructor,
+                                   jlong(value.link.target_table), jlong(value.link.target));
+        default:
+            throw_unsupported_value_type(jenv, value.type);
+            return nullptr;
+    }
+}
+
+// Converts the value types that can be boxed, returning false for any other type
+static bool mixed_to_realm_value(const realm::Mixed& mixed, realm::TableKey link_target, realm_value_t& out) {
+    if (mixed.is_null()) {
+        out.type = RLM_TYPE_NULL;
+        return true;
+    }
+    switch (mixed.get_type()) {
+        case realm::type_Int:
+            out.type = RLM_TYPE_INT;
+            out.integer = mixed.get_int();
+            return true;
+        case realm::type_Bool:
+            out.type = RLM_TYPE_BOOL;
+            out.boolean = mixed.get_bool();
+            return true;
+        case realm::type_String: {
+            realm::StringData string = mixed.get_string();
+            out.type = RLM_TYPE_STRING;
+            out.string = realm_string_t{string.data(), string.size()};
+            return true;
+        }
+        case realm::type_Float:
+            out.type = RLM_TYPE_FLOAT;
+            out.fnum = mixed.get_float();
+            return true;
+        case realm::type_Double:
+            out.type = RLM_TYPE_DOUBLE;
+            out.dnum = mixed.get_double();
+            return true;
+        case realm::type_Link:
+            out.type = RLM_TYPE_LINK;
+            out.link.target_table = link_target.value;
+            out.link.target = mixed.get<realm::ObjKey>().value;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static jobject mixed_to_jobject(JNIEnv* jenv, const realm::Mixed& value, realm::TableKey link_target) {
+    realm_value_t converted;
+    if (!mixed_to_realm_value(value, link_target, converted)) {
+        throw_unsupported_value_type(jenv, int(value.get_type()));
+        return nullptr;
+    }
+    return realm_value_to_jobject(jenv, converted);
+}
+
+// Direct reads from the object store types behind the C-API handles. They run the same
+// validation as the C-API getters inside wrap_err, so errors are recorded as the last error once
+// and reported by the caller, but the Mixed value is boxed directly instead of going through the
+// C-API's generic value conversion.
+static bool realm_get_value_direct(realm_object_t* object, int64_t key, realm::Mixed& value, realm::TableKey& link_target) {
+    return realm::c_api::wrap_err([&]() {
+        object->verify_attached();
+        const realm::Obj& obj = object->obj();
+        realm::ColKey col_key(key);
+        obj.get_table()->report_invalid_key(col_key);
+        if (col_key.is_collection()) {
+            throw realm::c_api::InvalidPropertyKeyException("Getting collection properties not supported");
+        }
+        value = obj.get_any(col_key);
+        if (!value.is_null() && value.get_type() == realm::type_Link) {
+            link_target = obj.get_table()->get_link_target(col_key)->get_key();
+        }
+        return true;
+    });
+}
+
+static bool realm_list_get_direct(realm_list_t* list, int64_t index, realm::Mixed& value, realm::TableKey& link_target) {
+    return realm::c_api::wrap_err([&]() {
+        list->verify_attached();
+        // Negative indices wrap around and are reported as out of bounds by the list
+        value = list->get_any(size_t(index));
+        if (!value.is_null() && value.get_type() == realm::type_Link) {
+            link_target = list->get_object_schema().table_key;
+        }
+        return true;
+    });
+}
+
+jobject realm_get_value_boxed(realm_object_t* object, int64_t key) {
+    auto jenv = get_env();
+    realm::Mixed value;
+    realm::TableKey link_target;
+    if (!realm_get_value_direct(object, key, value, link_target)) {
+        throw_as_java_exception(jenv);
+        return nullptr;
+    }
+    return mixed_to_jobject(jenv, value, link_target);
+}
+
+jobject realm_list_get_boxed(realm_list_t* list, int64_t index) {
+    auto jenv = get_env();
+    realm::Mixed value;
+    realm::TableKey link_target;
+    if (!realm_list_get_direct(list, index, value, link_target)) {
+        throw_as_java_exception(jenv);
+        return nullptr;
+    }
+    return mixed_to_jobject(jenv, value, link_target);
+}
+
+jobject realm_results_get_boxed(realm_results_t* results, int64_t index) {
+    auto jenv = get_env();
+    realm_value_t value;
+    if (!realm_results_get(results, index, &value)) {
+        throw_as_java_exception(jenv);
+        return nullptr;
+    }
+    return realm_value_to_jobject(jenv, value);
+}
+
+int64_t realm_get_version_id_direct(realm_t* realm) {
+    bool found = false;
+    realm_version_id_t version;
+    if (!realm_get_version_id(realm, &found, &version)) {
+        throw_as_java_exception(get_env());
+        return -1;
+    }
+    return found ? int64_t(version.version) : -1;
+}
+
+int64_t realm_get_num_versions_direct(realm_t* realm) {
+    uint64_t count = 0;
+    if (!realm_get_num_versions(realm, &count)) {
+        throw_as_java_exception(get_env());
+    }
+    return int64_t(count);
+}
+
+int64_t realm_find_class_key(realm_t* realm, const char* name) {
+    bool found = false;
+    realm_class_info_t info;
+    if (!realm_find_class(realm, name, &found, &info)) {
+        throw_as_java_exception(get_env());
+        return -1;
+    }
+    return found ? int64_t(info.key) : -1;
+}
+
+int64_t realm_list_size_direct(realm_list_t* list) {
+    size_t size = 0;
+    if (!realm_list_size(list, &size)) {
+        throw_as_java_exception(get_env());
+    }
+    return int64_t(size);
+}
+
+int64_t realm_results_count_direct(realm_results_t* results) {
+    size_t count = 0;
+    if (!realm_results_count(results, &count)) {
+        throw_as_java_exception(get_env());
+    }
+    return int64_t(count);
+}
+
+realm_object_t* realm_object_resolve_in_direct(realm_object_t* object, realm_t* target_realm) {
+    realm_object_t* resolved = nullptr;
+    if (!realm_object_resolve_in(object, target_realm, &resolved)) {
+        throw_as_java_exception(get_env());
+        return nullptr;
+    }
+    return resolved;
+}
+
+realm_list_t* realm_list_resolve_in_direct(realm_list_t* list, realm_t* target_realm) {
+    realm_list_t* resolved = nullptr;
+    if (!realm_list_resolve_in(list, target_realm, &resolved)) {
+        throw_as_java_exception(get_env());
+        return nullptr;
+    }
+    return resolved;
+}
+
+realm_object_t* realm_object_find_with_primary_key_direct(realm_t* realm, int64_t class_key, realm_value_t primary_key) {
+    bool found = false;
+    return realm_object_find_with_primary_key(realm, realm_class_key_t(class_key), primary_key, &found);
+}
+
+jobject realm_query_find_first_boxed(realm_query_t* query) {
+    auto jenv = get_env();
+    bool found = false;
+    realm_value_t value;
+    if (!realm_query_find_first(query, &value, &found)) {
+        throw_as_java_exception(jenv);
+        return nullptr;
+    }
+    return found ? realm_value_to_jobject(jenv, value) : nullptr;
+}
+
+bool realm_enumerate_string_column(realm_t* realm, int64_t class_key, int64_t col_key) {
+    return realm::c_api::wrap_err([&]() {
+        auto& shared_realm = *realm;
+        shared_realm->verify_in_write();
+        auto table = shared_realm->read_group().get_table(realm::TableKey(uint32_t(class_key)));
+        realm::ColKey col(col_key);
+        if (table->get_column_type(col) != realm::type_String || col.is_collection()) {
+            throw std::invalid_argument("Only string properties can be enumerated: " +
+                                        std::string(table->get_column_name(col)));
+        }
+        table->enumerate_string_column(col);
+        return true;
+    });
+}
+
+bool realm_add_search_index(realm_t* realm, int64_t class_key, int64_t col_key) {
+    return realm::c_api::wrap_err([&]() {
+        auto& shared_realm = *realm;
+        shared_realm->verify_in_write();
+        auto table = shared_realm->read_group().get_table(realm::TableKey(uint32_t(class_key)));
+        realm::ColKey col(col_key);
+        if (col.is_collection() || !realm::StringIndex::type_supported(table->get_column_type(col))) {
+            throw std::invalid_argument("Search indexes are not supported for property: " +
+                                        std::string(table->get_column_name(col)));
+        }
+        table->add_search_index(col);
+        return true;
+    });
+}
+
+bool realm_remove_search_index(realm_t* realm, int64_t class_key, int64_t col_key) {
+    return realm::c_api::wrap_err([&]() {
+        auto& shared_realm = *realm;
+        shared_realm->verify_in_write();
+        auto table = shared_realm->read_group().get_table(realm::TableKey(uint32_t(class_key)));
+        realm::ColKey col(col_key);
+        if (col == table->get_primary_key_column()) {
+            throw std::invalid_argument("Cannot remove the search index of the primary key: " +
+                                        std::string(table->get_column_name(col)));
+        }
+        table->remove_search_index(col);
+        return true;
+    });
+}
+
+int32_t realm_has_search_index(realm_t* realm, int64_t class_key, int64_t col_key) {
+    try {
+        auto table = (*realm)->read_group().get_table(realm::TableKey(uint32_t(class_key)));
+        return table->has_search_index(realm::ColKey(col_key)) ? 1 : 0;
+    } catch (...) {
+        realm::c_api::set_last_exception(std::current_exception());
+        throw_as_java_exception(get_env());
+        return -1;
+    }
+}
+
+bool realm_write_copy_to_path(realm_t* realm, const char* path, const uint8_t* key, size_t key_size) {
+    return realm::c_api::wrap_err([&]() {
+        if (realm::util::File::exists(path)) {
+            throw std::invalid_argument("A file already exists at: " + std::string(path));
+        }
+        // Writing the group only writes the data reachable from its version and leaves out the
+        // free space of the file, so the copy is compacted
+        const char* encryption_key = key_size == 0 ? nullptr : reinterpret_cast<const char*>(key);
+        (*realm)->read_group().write(path, encryption_key);
+        return true;
+    });
+}
+
+namespace {
+// Stream buffer that hands the written data to a WriteCopySink in chunks through a single reused
+// Java byte array, so the copy is never held in memory in full
+class WriteCopySinkBuffer : public std::streambuf {
+public:
+    WriteCopySinkBuffer(JNIEnv* env, jobject sink)
+        : m_env(env)
+        , m_sink(sink)
+        , m_buffer(chunk_size)
+        , m_array(env->NewByteArray(chunk_size))
+    {
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+    }
+
+    ~WriteCopySinkBuffer()
+    {
+        m_env->DeleteLocalRef(m_array);
+    }
+
+protected:
+    int_type overflow(int_type c) override
+    {
+        if (!flush_chunk()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override
+    {
+        return flush_chunk() ? 0 : -1;
+    }
+
+private:
+    static constexpr jsize chunk_size = 64 * 1024;
+
+    // Returns false if the sink threw, which leaves the exception pending and fails the stream,
+    // so no further JNI calls are made
+    bool flush_chunk()
+    {
+        static JavaClass sink_class(m_env, "io/realm/internal/interop/WriteCopySink");
+        static JavaMethod write_method(m_env, sink_class, "write", "([BI)V");
+        jsize length = jsize(pptr() - pbase());
+        if (length > 0) {
+            m_env->SetByteArrayRegion(m_array, 0, length, reinterpret_cast<const jbyte*>(pbase()));
+            m_env->CallVoidMethod(m_sink, write_method, m_array, length);
+            if (m_env->ExceptionCheck()) {
+                return false;
+            }
+        }
+        setp(m_buffer.data(), m_buffer.data() + m_buffer.size());
+        return true;
+    }
+
+    JNIEnv* m_env;
+    jobject m_sink;
+    std::vector<char> m_buffer;
+    jbyteArray m_array;
+};
+}
+
+bool realm_write_copy_to_sink(realm_t* realm, jobject sink) {
+    auto jenv = get_env();
+    bool written = realm::c_api::wrap_err([&]() {
+        WriteCopySinkBuffer buffer(jenv, sink);
+        std::ostream out(&buffer);
+        (*realm)->read_group().write(out);
+        out.flush();
+        return true;
+    });
+    if (jenv->ExceptionCheck()) {
+        // Let the exception thrown by the sink propagate instead of any error caused by aborting
+        // the write
+        realm_clear_last_error();
+        return true;
+    }
+    return written;
+}
+
+static std::vector<realm::ColKey> to_col_keys(const int64_t* col_keys, size_t num_cols) {
+    std::vector<realm::ColKey> keys;
+    keys.reserve(num_cols);
+    for (size_t i = 0; i < num_cols; ++i) {
+        keys.emplace_back(col_keys[i]);
+    }
+    return keys;
+}
+
+bool realm_results_export_arrow_to_path(realm_results_t* results, int64_t* col_keys, size_t num_cols, int64_t batch_size, const char* path) {
+    return realm::c_api::wrap_err([&]() {
+        if (realm::util::File::exists(path)) {
+            throw std::invalid_argument("A file already exists at: " + std::string(path));
+        }
+        std::ofstream out(path, std::ios::binary);
+        if (!out) {
+            throw std::runtime_error("Could not open: " + std::string(path));
+        }
+        try {
+            realm::arrow_ipc::write_stream(*results, to_col_keys(col_keys, num_cols), size_t(batch_size), out);
+            out.close();
+            if (!out) {
+                throw std::runtime_error("Could not write to: " + std::string(path));
+            }
+        } catch (...) {
+            // Don't leave an incomplete export behind
+            out.close();
+            realm::util::File::try_remove(path);
+            throw;
+        }
+        return true;
+    });
+}
+
+bool realm_results_export_arrow_to_sink(realm_results_t* results, int64_t* col_keys, size_t num_cols, int64_t batch_size, jobject sink) {
+    auto jenv = get_env();
+    bool written = realm::c_api::wrap_err([&]() {
+        WriteCopySinkBuffer buffer(jenv, sink);
+        std::ostream out(&buffer);
+        realm::arrow_ipc::write_stream(*results, to_col_keys(col_keys, num_cols), size_t(batch_size), out);
+        return true;
+    });
+    if (jenv->ExceptionCheck()) {
+        // Let the exception thrown by the sink propagate instead of the error caused by aborting
+        // the export
+        realm_clear_last_error();
+        return true;
+    }
+    return written;
+}
+
+static bool copy_packed(const std::vector<realm::Obj>& roots, int64_t max_depth, jobject sink) {
+    auto jenv = get_env();
+    bool written = realm::c_api::wrap_err([&]() {
+        if (max_depth < 0) {
+            throw std::invalid_argument("The depth must not be negative");
+        }
+        WriteCopySinkBuffer buffer(jenv, sink);
+        std::ostream out(&buffer);
+        realm::packed_graph::write(roots, size_t(max_depth), out);
+        return true;
+    });
+    if (jenv->ExceptionCheck()) {
+        // Let the exception thrown by the sink propagate instead of the error caused by aborting
+        // the copy
+        realm_clear_last_error();
+        return true;
+    }
+    return written;
+}
+
+bool realm_object_copy_packed(realm_object_t* obj, int64_t max_depth, jobject sink) {
+    std::vector<realm::Obj> roots;
+    bool valid = realm::c_api::wrap_err([&]() {
+        if (!obj->is_valid()) {
+            throw std::logic_error("Cannot copy an invalid object");
+        }
+        roots.push_back(obj->obj());
+        return true;
+    });
+    return valid && copy_packed(roots, max_depth, sink);
+}
+
+bool realm_results_copy_packed(realm_results_t* results, int64_t max_depth, jobject sink) {
+    std::vector<realm::Obj> roots;
+    bool valid = realm::c_api::wrap_err([&]() {
+        if (!results->get_table()) {
+            throw std::invalid_argument("Only results of objects can be copied");
+        }
+        size_t size = results->size();
+        roots.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            roots.push_back(results->get(i));
+        }
+        return true;
+    });
+    return valid && copy_packed(roots, max_depth, sink);
+}
+
+struct realm_ndjson_importer : realm::c_api::WrapC, realm::ndjson::Importer {
+    using Importer::Importer;
+};
+
+realm_ndjson_importer_t* realm_ndjson_importer_from_file(const char* path) {
+    auto importer = realm::c_api::wrap_err([&]() {
+        auto in = std::make_unique<std::ifstream>(path, std::ios::binary);
+        if (!*in) {
+            throw std::invalid_argument("Could not open: " + std::string(path));
+        }
+        return new realm_ndjson_importer_t(std::move(in));
+    });
+    if (!importer) {
+        throw_as_java_exception(get_env());
+    }
+    return importer;
+}
+
+realm_ndjson_importer_t* realm_ndjson_importer_from_buffer(int8_t* ndjson_data, size_t size) {
+    return new realm_ndjson_importer_t(std::make_unique<std::istringstream>(
+            std::string(reinterpret_cast<const char*>(ndjson_data), size)));
+}
+
+int64_t realm_ndjson_importer_import(realm_ndjson_importer_t* importer, realm_t* realm, int64_t class_key, int64_t max_objects) {
+    int64_t imported = 0;
+    bool success = realm::c_api::wrap_err([&]() {
+        auto& shared_realm = *realm;
+        shared_realm->verify_in_write();
+        auto table = shared_realm->read_group().get_table(realm::TableKey(uint32_t(class_key)));
+        // Properties are resolved by their public names through the schema of the realm
+        auto resolve_property = [&](const std::string& name) {
+            bool found = false;
+            realm_property_info_t info;
+            if (!realm_find_property(realm, realm_class_key_t(class_key), name.c_str(), &found, &info)) {
+                throw std::runtime_error("Could not look up property: " + name);
+            }
+            return found ? realm::ColKey(info.key) : realm::ColKey();
+        };
+        imported = int64_t(importer->import(table, resolve_property, size_t(max_objects)));
+        return true;
+    });
+    if (!success) {
+        throw_as_java_exception(get_env());
+        return -1;
+    }
+    return imported;
+}
+
+int64_t realm_ndjson_importer_bytes_read(realm_ndjson_importer_t* importer) {
+    return int64_t(importer->bytes_read());
+}
+
+// Streams the output of write to sink, letting an exception thrown by the sink propagate instead
+// of the error caused by aborting the write
+template <typename F>
+static bool stream_to_sink(jobject sink, F write) {
+    auto jenv = get_env();
+    bool written = realm::c_api::wrap_err([&]() {
+        WriteCopySinkBuffer buffer(jenv, sink);
+        std::ostream out(&buffer);
+        write(out);
+        return true;
+    });
+    if (jenv->ExceptionCheck()) {
+        realm_clear_last_error();
+        return true;
+    }
+    return written;
+}
+
+bool realm_get_schema_packed(realm_t* realm, jobject sink) {
+    std::vector<realm::dynamic_rows::ClassSchema> classes;
+    size_t num_classes = realm_get_num_classes(realm);
+    std::vector<realm_class_key_t> keys(num_classes);
+    if (!realm_get_class_keys(realm, keys.data(), keys.size(), &num_classes)) {
+        return false;
+    }
+    for (realm_class_key_t key : keys) {
+        realm::dynamic_rows::ClassSchema schema;
+        if (!realm_get_class(realm, key, &schema.info)) {
+            return false;
+        }
+        size_t num_properties = schema.info.num_properties + schema.info.num_computed_properties;
+        schema.properties.resize(num_properties);
+        if (!realm_get_class_properties(realm, key, schema.properties.data(), num_properties, &num_properties)) {
+            return false;
+        }
+        schema.properties.resize(num_properties);
+        classes.push_back(std::move(schema));
+    }
+    return stream_to_sink(sink, [&](std::ostream& out) {
+        realm::dynamic_rows::write_schema(classes, out);
+    });
+}
+
+bool realm_results_read_rows(realm_results_t* results, int64_t* col_keys, size_t num_cols, int64_t offset, int64_t count, jobject sink) {
+    std::vector<realm::Obj> objects;
+    bool valid = realm::c_api::wrap_err([&]() {
+        if (!results->get_table()) {
+            throw std::invalid_argument("Only results of objects can be read as rows");
+        }
+        size_t end = std::min(results->size(), size_t(std::max<int64_t>(offset, 0) + std::max<int64_t>(count, 0)));
+        for (size_t i = size_t(std::max<int64_t>(offset, 0)); i < end; ++i) {
+            objects.push_back(results->get(i));
+        }
+        return true;
+    });
+    return valid && stream_to_sink(sink, [&](std::ostream& out) {
+        realm::dynamic_rows::write_rows(objects, to_col_keys(col_keys, num_cols), out);
+    });
+}
+
+bool realm_read_rows(realm_t* realm, int64_t class_key, int64_t* obj_keys, size_t num_objects, int64_t* col_keys, size_t num_cols, jobject sink) {
+    std::vector<realm::Obj> objects;
+    bool valid = realm::c_api::wrap_err([&]() {
+        auto table = (*realm)->read_group().get_table(realm::TableKey(uint32_t(class_key)));
+        objects.reserve(num_objects);
+        for (size_t i = 0; i < num_objects; ++i) {
+            objects.push_back(table->get_object(realm::ObjKey(obj_keys[i])));
+        }
+        return true;
+    });
+    return valid && stream_to_sink(sink, [&](std::ostream& out) {
+        realm::dynamic_rows::write_rows(objects, to_col_keys(col_keys, num_cols), out);
+    });
+}
+
+bool realm_config_set_schema_migration(realm_config_t* config, int8_t* migration_plan, size_t size, jobject progress_callback) {
+    return realm::c_api::wrap_err([&]() {
+        auto plan = std::make_shared<realm::schema_migration::Plan>(reinterpret_cast<const char*>(migration_plan), size);
+        // The callback is shared by the copies of the config made when opening realms and released
+        // with the last of them
+        std::shared_ptr<_jobject> callback(get_env()->NewGlobalRef(progress_callback), [](jobject ref) {
+            get_env(true)->DeleteGlobalRef(ref);
+        });
+        config->migration_function = [plan, callback](realm::SharedRealm old_realm, realm::SharedRealm realm, realm::Schema& schema) {
+            auto env = get_env(true);
+            static JavaClass callback_class(env, "io/realm/internal/interop/MigrationProgressCallback");
+            static JavaMethod on_progress(env, callback_class, "onProgress", "(IJJ)Z");
+            plan->run(old_realm, realm, schema, [&](size_t operation, size_t processed, size_t total) {
+                jboolean proceed = env->CallBooleanMethod(callback.get(), on_progress, jint(operation),
+                                                          jlong(processed), jlong(total));
+                if (env->ExceptionCheck()) {
+                    // Failures of the callback are rethrown by the SDK, so only the abort is reported
+                    env->ExceptionClear();
+                    proceed = false;
+                }
+                if (!proceed) {
+                    throw std::runtime_error("The migration was aborted by its progress callback");
+                }
+            });
+        };
+        return true;
+    });
+}
+
+void realm_prefetch_file(const char* path) {
+#if !defined(_WIN32)
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+#if defined(__APPLE__)
+    // Darwin has no posix_fadvise, but supports issuing read-ahead advice for a range of the file
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0) {
+        off_t offset = 0;
+        while (offset < file_stat.st_size) {
+            struct radvisory advisory;
+            advisory.ra_offset = offset;
+            advisory.ra_count = int(std::min<off_t>(file_stat.st_size - offset, INT_MAX));
+            if (fcntl(fd, F_RDADVISE, &advisory) == -1) {
+                break;
+            }
+            offset += advisory.ra_count;
+        }
+    }
+#else
+    // The read-ahead is asynchronous, so this returns before the file has been read
+    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+    close(fd);
+#else
+    (void) path;
+#endif
+}
+
+int64_t realm_get_file_size(const char* path) {
+    struct stat file_stat;
+    if (stat(path, &file_stat) != 0) {
+        return -1;
+    }
+    return int64_t(file_stat.st_size);
+}
@@ -52,4 +52,152 @@ sync_set_error_handler(realm_sync_config_t* sync_config, jobject error_handler);
 void
 complete_http_request(void* request_context, jobject j_response);
 
+// Throws the last core error as a Java exception if one is pending
+void
+throw_as_java_exception(JNIEnv *jenv);
+
+// Value accessors converting the realm_value_t directly into the corresponding boxed Java value
+// (String, Long, Boolean, Float, Double, Link or null) to avoid allocating and populating an
+// intermediate realm_value_t proxy through multiple JNI calls.
+jobject
+realm_get_value_boxed(realm_object_t* object, int64_t key);
+
+jobject
+realm_list_get_boxed(realm_list_t* list, int64_t index);
+
+jobject
+realm_results_get_boxed(realm_results_t* results, int64_t index);
+
+// Scalar variants of C-API functions that report their result through output parameters. SWIG maps
+// output parameters to Java arrays that are allocated and copied back on every call, so these
+// return the result directly instead and throw pending core errors as Java exceptions.
+int64_t
+realm_get_version_id_direct(realm_t* realm);
+
+int64_t
+realm_get_num_versions_direct(realm_t* realm);
+
+// Returns the class key of the class named 'name' or -1 if no such class exists
+int64_t
+realm_find_class_key(realm_t* realm, const char* name);
+
+int64_t
+realm_list_size_direct(realm_list_t* list);
+
+int64_t
+realm_results_count_direct(realm_results_t* results);
+
+// Returns the resolved object or null if it was deleted in the target realm
+realm_object_t*
+realm_object_resolve_in_direct(realm_object_t* object, realm_t* target_realm);
+
+// Returns the resolved list or null if it was deleted in the target realm
+realm_list_t*
+realm_list_resolve_in_direct(realm_list_t* list, realm_t* target_realm);
+
+realm_object_t*
+realm_object_find_with_primary_key_direct(realm_t* realm, int64_t class_key, realm_value_t primary_key);
+
+// Returns the Link of the first object matching the query or null if there is no match
+jobject
+realm_query_find_first_boxed(realm_query_t* query);
+
+// Storage maintenance operations that are not exposed by the C-API and are implemented directly
+// against core. They must be called inside a write transaction.
+bool
+realm_enumerate_string_column(realm_t* realm, int64_t class_key, int64_t col_key);
+
+bool
+realm_add_search_index(realm_t* realm, int64_t class_key, int64_t col_key);
+
+bool
+realm_remove_search_index(realm_t* realm, int64_t class_key, int64_t col_key);
+
+// Returns 1 if the column has a search index and 0 if not. Returned as an integer as boolean results
+// are treated as error indicators by the type maps.
+int32_t
+realm_has_search_index(realm_t* realm, int64_t class_key, int64_t col_key);
+
+// Writes a compacted copy of the version of the realm to a new file at path, encrypted with key if
+// key_size is not 0
+bool
+realm_write_copy_to_path(realm_t* realm, const char* path, const uint8_t* key, size_t key_size);
+
+// Streams a compacted, unencrypted copy of the version of the realm in chunks to sink, an
+// io.realm.internal.interop.WriteCopySink
+bool
+realm_write_copy_to_sink(realm_t* realm, jobject sink);
+
+// Writes the columns col_keys of the objects of results to a new file at path in the Arrow IPC
+// streaming format, in record batches of batch_size rows
+bool
+realm_results_export_arrow_to_path(realm_results_t* results, int64_t* col_keys, size_t num_cols, int64_t batch_size, const char* path);
+
+// Streams the columns col_keys of the objects of results in the Arrow IPC streaming format in
+// chunks to sink, an io.realm.internal.interop.WriteCopySink
+bool
+realm_results_export_arrow_to_sink(realm_results_t* results, int64_t* col_keys, size_t num_cols, int64_t batch_size, jobject sink);
+
+// Streams the graph of objects reachable from obj by following at most max_depth links in the packed
+// format of packed_graph.hpp in chunks to sink, an io.realm.internal.interop.WriteCopySink
+bool
+realm_object_copy_packed(realm_object_t* obj, int64_t max_depth, jobject sink);
+
+// Streams the graph of objects reachable from the objects of results by following at most max_depth
+// links in the packed format of packed_graph.hpp in chunks to sink
+bool
+realm_results_copy_packed(realm_results_t* results, int64_t max_depth, jobject sink);
+
+// Incremental importer of newline delimited JSON into a realm, see ndjson_importer.hpp. Released with
+// realm_release.
+typedef struct realm_ndjson_importer realm_ndjson_importer_t;
+
+// Creates an importer reading the file at path
+realm_ndjson_importer_t*
+realm_ndjson_importer_from_file(const char* path);
+
+// Creates an importer reading a copy of the first size bytes of ndjson_data
+realm_ndjson_importer_t*
+realm_ndjson_importer_from_buffer(int8_t* ndjson_data, size_t size);
+
+// Imports at most max_objects objects of the class class_key in the current write transaction of
+// realm. Returns the number of imported objects, which is 0 once all input has been imported.
+int64_t
+realm_ndjson_importer_import(realm_ndjson_importer_t* importer, realm_t* realm, int64_t class_key, int64_t max_objects);
+
+// Returns the number of bytes of the input consumed by the importer
+int64_t
+realm_ndjson_importer_bytes_read(realm_ndjson_importer_t* importer);
+
+// Streams the classes and properties of the schema of realm in the format of dynamic_rows.hpp in
+// chunks to sink, an io.realm.internal.interop.WriteCopySink
+bool
+realm_get_schema_packed(realm_t* realm, jobject sink);
+
+// Streams the rows of the objects of results from offset up to offset + count with the values of the
+// columns col_keys in the format of dynamic_rows.hpp in chunks to sink
+bool
+realm_results_read_rows(realm_results_t* results, int64_t* col_keys, size_t num_cols, int64_t offset, int64_t count, jobject sink);
+
+// Streams the rows of the objects obj_keys of the class class_key with the values of the columns
+// col_keys in the format of dynamic_rows.hpp in chunks to sink
+bool
+realm_read_rows(realm_t* realm, int64_t class_key, int64_t* obj_keys, size_t num_objects, int64_t* col_keys, size_t num_cols, jobject sink);
+
+// Sets the migration function of config to run the bulk operations of the migration plan of size
+// bytes, see schema_migration.hpp, reporting progress to progress_callback, an
+// io.realm.internal.interop.MigrationProgressCallback. The migration is aborted if the callback
+// returns false.
+bool
+realm_config_set_schema_migration(realm_config_t* config, int8_t* migration_plan, size_t size, jobject progress_callback);
+
+// Advises the OS to read the file at path into the page cache ahead of it being accessed. This is a
+// best effort operation that silently ignores any failure.
+void
+realm_prefetch_file(const char* path);
+
+// Returns the size of the file at path in bytes or -1 if the size cannot be determined
+int64_t
+realm_get_file_size(const char* path);
+
 #endif //TEST_REALM_API_HELPERS_H
@@ -0,0 +1,618 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "schema_migration.hpp"
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <realm/query.hpp>
+#include <realm/table.hpp>
+#include <realm/table_view.hpp>
+#include <realm/object-store/object_store.hpp>
+
+namespace realm::schema_migration {
+namespace {
+
+constexpr char op_rename = 1;
+constexpr char op_convert = 2;
+constexpr char op_split = 3;
+constexpr char op_merge = 4;
+constexpr char op_set = 5;
+constexpr char op_delete = 6;
+
+// Same tags as the values of backup journals on the Kotlin side
+constexpr char tag_null = 0;
+constexpr char tag_int = 1;
+constexpr char tag_bool = 2;
+constexpr char tag_float = 3;
+constexpr char tag_double = 4;
+constexpr char tag_string = 5;
+
+constexpr size_t progress_interval = 10000;
+
+// 2^63, the first float or double that is out of range of int64_t
+constexpr double int64_limit = 9223372036854775808.0;
+
+class Decoder {
+public:
+    Decoder(const char* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+    {
+    }
+
+    bool at_end() const
+    {
+        return m_position == m_size;
+    }
+
+    char read_byte()
+    {
+        require(1);
+        return m_data[m_position++];
+    }
+
+    uint32_t read_int()
+    {
+        return uint32_t(read_little_endian(4));
+    }
+
+    uint64_t read_long()
+    {
+        return read_little_endian(8);
+    }
+
+    std::string read_string()
+    {
+        size_t length = read_int();
+        require(length);
+        std::string value(m_data + m_position, length);
+        m_position += length;
+        return value;
+    }
+
+private:
+    const char* m_data;
+    size_t m_size;
+    size_t m_position = 0;
+
+    void require(size_t bytes) const
+    {
+        if (m_size - m_position < bytes) {
+            throw std::invalid_argument("Truncated migration plan");
+        }
+    }
+
+    uint64_t read_little_endian(size_t bytes)
+    {
+        require(bytes);
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= uint64_t(uint8_t(m_data[m_position++])) << (i * 8);
+        }
+        return value;
+    }
+};
+
+std::vector<Plan::Part> parse_template(const std::string& format)
+{
+    std::vector<Plan::Part> parts;
+    std::string literal;
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+            literal += c;
+            ++i;
+        }
+        else if (c == '{') {
+            size_t end = format.find('}', i + 1);
+            if (end == std::string::npos || end == i + 1) {
+                throw std::invalid_argument("Invalid merge template: '" + format + "'");
+            }
+            if (!literal.empty()) {
+                parts.push_back({false, std::move(literal)});
+                literal.clear();
+            }
+            parts.push_back({true, format.substr(i + 1, end - i - 1)});
+            i = end;
+        }
+        else if (c == '}') {
+            throw std::invalid_argument("Invalid merge template: '" + format + "'");
+        }
+        else {
+            literal += c;
+        }
+    }
+    if (!literal.empty()) {
+        parts.push_back({false, std::move(literal)});
+    }
+    return parts;
+}
+
+template <typename T>
+std::string format_floating(T value)
+{
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "Infinity" : "-Infinity";
+    }
+    // The shortest representation that parses back to the same value
+    char buffer[32];
+    for (int precision = 1; precision <= std::numeric_limits<T>::max_digits10; ++precision) {
+        std::snprintf(buffer, sizeof(buffer), "%.*g", precision, double(value));
+        if (T(std::strtod(buffer, nullptr)) == value) {
+            break;
+        }
+    }
+    return buffer;
+}
+
+std::string format(Mixed value)
+{
+    switch (value.get_type()) {
+        case type_Int:
+            return std::to_string(value.get_int());
+        case type_Bool:
+            return value.get_bool() ? "true" : "false";
+        case type_Float:
+            return format_floating(value.get_float());
+        case type_Double:
+            return format_floating(value.get_double());
+        case type_String:
+            return std::string(value.get_string());
+        default:
+            throw std::invalid_argument("Unsupported value type: " + std::to_string(int(value.get_type())));
+    }
+}
+
+[[noreturn]] void cannot_convert(Mixed value, const char* type)
+{
+    throw std::invalid_argument("Cannot convert '" + format(value) + "' to " + type + " without losing information");
+}
+
+int64_t to_int(Mixed value)
+{
+    switch (value.get_type()) {
+        case type_Int:
+            return value.get_int();
+        case type_Bool:
+            return value.get_bool() ? 1 : 0;
+        case type_Float:
+        case type_Double: {
+            double d = value.get_type() == type_Float ? double(value.get_float()) : value.get_double();
+            if (d != std::trunc(d) || d < -int64_limit || d >= int64_limit) {
+                cannot_convert(value, "int");
+            }
+            return int64_t(d);
+        }
+        case type_String: {
+            StringData s = value.get_string();
+            int64_t result;
+            auto [end, error] = std::from_chars(s.data(), s.data() + s.size(), result);
+            if (error != std::errc() || end != s.data() + s.size() || s.size() == 0) {
+                cannot_convert(value, "int");
+            }
+            return result;
+        }
+        default:
+            cannot_convert(value, "int");
+    }
+}
+
+bool to_bool(Mixed value)
+{
+    switch (value.get_type()) {
+        case type_Bool:
+            return value.get_bool();
+        case type_Int:
+            if (value.get_int() == 0 || value.get_int() == 1) {
+                return value.get_int() == 1;
+            }
+            break;
+        case type_String:
+            if (value.get_string() == "true" || value.get_string() == "false") {
+                return value.get_string() == "true";
+            }
+            break;
+        default:
+            break;
+    }
+    cannot_convert(value, "bool");
+}
+
+// Strictly parses a string value as a whole, accepting the formats of format_floating. Floats are
+// parsed directly to avoid rounding twice.
+template <typename T>
+T parse_floating(Mixed value, const char* type)
+{
+    std::string s(value.get_string());
+    char* end = nullptr;
+    T result;
+    if constexpr (std::is_same_v<T, float>) {
+        result = std::strtof(s.c_str(), &end);
+    }
+    else {
+        result = std::strtod(s.c_str(), &end);
+    }
+    if (s.empty() || std::isspace(uint8_t(s[0])) || end != s.c_str() + s.size()) {
+        cannot_convert(value, type);
+    }
+    return result;
+}
+
+double to_double(Mixed value)
+{
+    switch (value.get_type()) {
+        case type_Double:
+            return value.get_double();
+        case type_Float:
+            return double(value.get_float());
+        case type_Int: {
+            double d = double(value.get_int());
+            if (d >= int64_limit || int64_t(d) != value.get_int()) {
+                cannot_convert(value, "double");
+            }
+            return d;
+        }
+        case type_String:
+            return parse_floating<double>(value, "double");
+        default:
+            cannot_convert(value, "double");
+    }
+}
+
+float to_float(Mixed value)
+{
+    if (value.get_type() == type_Float) {
+        return value.get_float();
+    }
+    if (value.get_type() == type_String) {
+        return parse_floating<float>(value, "float");
+    }
+    double d = to_double(value);
+    float f = float(d);
+    if (!std::isnan(d) && double(f) != d) {
+        cannot_convert(value, "float");
+    }
+    return f;
+}
+
+const char* type_name(ColKey col)
+{
+    switch (col.get_type()) {
+        case col_type_Int:
+            return "int";
+        case col_type_Bool:
+            return "bool";
+        case col_type_Float:
+            return "float";
+        case col_type_Double:
+            return "double";
+        case col_type_String:
+            return "string";
+        default:
+            return "unsupported";
+    }
+}
+
+struct Column {
+    TableRef table;
+    ColKey key;
+    std::string name;
+};
+
+Column find_column(Group& group, const std::string& class_name, const std::string& property, const char* when)
+{
+    TableRef table = ObjectStore::table_for_object_type(group, class_name);
+    ColKey key = table ? table->get_column_key(property) : ColKey();
+    std::string name = class_name + "." + property;
+    if (!key) {
+        throw std::invalid_argument("Property '" + name + "' does not exist " + when + " the migration");
+    }
+    if (key.is_collection() || std::string(type_name(key)) == "unsupported") {
+        throw std::invalid_argument("Property '" + name + "' has an unsupported type");
+    }
+    return {table, key, std::move(name)};
+}
+
+// Converts value to the type of col, holding converted strings in storage
+Mixed convert(Mixed value, const Column& col, std::string& storage)
+{
+    if (value.is_null()) {
+        if (!col.key.is_nullable()) {
+            throw std::invalid_argument("Cannot set null to the required property '" + col.name + "'");
+        }
+        return Mixed();
+    }
+    switch (col.key.get_type()) {
+        case col_type_Int:
+            return Mixed(to_int(value));
+        case col_type_Bool:
+            return Mixed(to_bool(value));
+        case col_type_Float:
+            return Mixed(to_float(value));
+        case col_type_Double:
+            return Mixed(to_double(value));
+        default:
+            storage = format(value);
+            return Mixed(StringData(storage));
+    }
+}
+
+// Sets value converted to the type of col on obj, adding the property and object to errors
+void set(Obj& obj, const Column& col, Mixed value, std::string& storage)
+{
+    try {
+        obj.set_any(col.key, convert(value, col, storage));
+    }
+    catch (const std::invalid_argument& e) {
+        throw std::invalid_argument("Could not migrate '" + col.name + "' of object " +
+                                    std::to_string(obj.get_key().value) + ": " + e.what());
+    }
+}
+
+class Reporter {
+public:
+    Reporter(const ProgressHandler& progress, size_t operation, size_t total)
+        : m_progress(progress)
+        , m_operation(operation)
+        , m_total(total)
+    {
+    }
+
+    void processed()
+    {
+        if (++m_processed % progress_interval == 0) {
+            m_progress(m_operation, m_processed, m_total);
+        }
+    }
+
+    void done()
+    {
+        m_progress(m_operation, m_total, m_total);
+    }
+
+private:
+    const ProgressHandler& m_progress;
+    size_t m_operation;
+    size_t m_total;
+    size_t m_processed = 0;
+};
+
+} // namespace
+
+Plan::Plan(const char* data, size_t size)
+{
+    Decoder decoder(data, size);
+    uint32_t count = decoder.read_int();
+    for (uint32_t i = 0; i < count; ++i) {
+        Operation op{};
+        op.kind = decoder.read_byte();
+        op.class_name = decoder.read_string();
+        switch (op.kind) {
+            case op_rename:
+                op.arguments.push_back(decoder.read_string());
+                op.arguments.push_back(decoder.read_string());
+                break;
+            case op_convert:
+            case op_delete:
+                op.arguments.push_back(decoder.read_string());
+                break;
+            case op_split: {
+                op.arguments.push_back(decoder.read_string());
+                op.arguments.push_back(decoder.read_string());
+                uint32_t targets = decoder.read_int();
+                if (targets == 0 || op.arguments[1].empty()) {
+                    throw std::invalid_argument("Splits require a separator and at least one target");
+                }
+                for (uint32_t j = 0; j < targets; ++j) {
+                    op.arguments.push_back(decoder.read_string());
+                }
+                break;
+            }
+            case op_merge:
+                op.arguments.push_back(decoder.read_string());
+                op.arguments.push_back(decoder.read_string());
+                op.parts = parse_template(op.arguments[1]);
+                break;
+            case op_set:
+                op.arguments.push_back(decoder.read_string());
+                switch (op.value_tag = decoder.read_byte()) {
+                    case tag_null:
+                        break;
+                    case tag_int:
+                        op.int_value = int64_t(decoder.read_long());
+                        break;
+                    case tag_bool:
+                        op.int_value = decoder.read_byte() != 0 ? 1 : 0;
+                        break;
+                    case tag_float: {
+                        uint32_t bits = decoder.read_int();
+                        std::memcpy(&op.float_value, &bits, sizeof(bits));
+                        break;
+                    }
+                    case tag_double: {
+                        uint64_t bits = decoder.read_long();
+                        std::memcpy(&op.double_value, &bits, sizeof(bits));
+                        break;
+                    }
+                    case tag_string:
+                        op.text = decoder.read_string();
+                        break;
+                    default:
+                        throw std::invalid_argument("Unknown value tag in migration plan: " +
+                                                    std::to_string(int(op.value_tag)));
+                }
+                break;
+            default:
+                throw std::invalid_argument("Unknown migration operation: " + std::to_string(int(op.kind)));
+        }
+        m_operations.push_back(std::move(op));
+    }
+    if (!decoder.at_end()) {
+        throw std::invalid_argument("Trailing data in migration plan");
+    }
+}
+
+void Plan::run(const SharedRealm& old_realm, const SharedRealm& realm, Schema& schema,
+               const ProgressHandler& progress) const
+{
+    Group& old_group = old_realm->read_group();
+    Group& group = realm->read_group();
+    std::string storage;
+    for (size_t index = 0; index < m_operations.size(); ++index) {
+        const Operation& op = m_operations[index];
+        const std::vector<std::string>& args = op.arguments;
+        switch (op.kind) {
+            case op_rename: {
+                ObjectStore::rename_property(group, schema, op.class_name, args[0], args[1]);
+                TableRef table = ObjectStore::table_for_object_type(group, op.class_name);
+                Reporter(progress, index, table->size()).done();
+                break;
+            }
+            case op_convert: {
+                Column source = find_column(old_group, op.class_name, args[0], "before");
+                Column target = find_column(group, op.class_name, args[0], "after");
+                Reporter reporter(progress, index, target.table->size());
+                for (Obj obj : *target.table) {
+                    set(obj, target, source.table->get_object(obj.get_key()).get_any(source.key), storage);
+                    reporter.processed();
+                }
+                reporter.done();
+                break;
+            }
+            case op_split: {
+                Column source = find_column(old_group, op.class_name, args[0], "before");
+                if (source.key.get_type() != col_type_String) {
+                    throw std::invalid_argument("Property '" + source.name + "' must be a string to be split");
+                }
+                std::vector<Column> targets;
+                for (size_t i = 2; i < args.size(); ++i) {
+                    targets.push_back(find_column(group, op.class_name, args[i], "after"));
+                }
+                const std::string& separator = args[1];
+                Reporter reporter(progress, index, targets[0].table->size());
+                for (Obj obj : *targets[0].table) {
+                    Mixed value = source.table->get_object(obj.get_key()).get_any(source.key);
+                    if (!value.is_null()) {
+                        // Parts are copied, as converting them reuses the storage of strings
+                        std::string remainder(value.get_string());
+                        for (size_t i = 0; i < targets.size(); ++i) {
+                            size_t end = i + 1 < targets.size() ? remainder.find(separator) : std::string::npos;
+                            std::string part = remainder.substr(0, end);
+                            remainder = end == std::string::npos ? "" : remainder.substr(end + separator.size());
+                            set(obj, targets[i], Mixed(StringData(part)), storage);
+                        }
+                    }
+                    reporter.processed();
+                }
+                reporter.done();
+                break;
+            }
+            case op_merge: {
+                Column target = find_column(group, op.class_name, args[0], "after");
+                std::vector<Column> sources;
+                for (const Part& part : op.parts) {
+                    if (part.is_property) {
+                        sources.push_back(find_column(old_group, op.class_name, part.text, "before"));
+                    }
+                }
+                Reporter reporter(progress, index, target.table->size());
+                std::string merged;
+                for (Obj obj : *target.table) {
+                    Obj old_obj = sources.empty() ? Obj() : sources[0].table->get_object(obj.get_key());
+                    merged.clear();
+                    auto source = sources.begin();
+                    for (const Part& part : op.parts) {
+                        if (!part.is_property) {
+                            merged += part.text;
+                            continue;
+                        }
+                        // Null values are merged as empty strings
+                        Mixed value = old_obj.get_any((source++)->key);
+                        if (!value.is_null()) {
+                            merged += format(value);
+                        }
+                    }
+                    set(obj, target, Mixed(StringData(merged)), storage);
+                    reporter.processed();
+                }
+                reporter.done();
+                break;
+            }
+            case op_set: {
+                Column target = find_column(group, op.class_name, args[0], "after");
+                Mixed value;
+                switch (op.value_tag) {
+                    case tag_int:
+                        value = Mixed(op.int_value);
+                        break;
+                    case tag_bool:
+                        value = Mixed(op.int_value != 0);
+                        break;
+                    case tag_float:
+                        value = Mixed(op.float_value);
+                        break;
+                    case tag_double:
+                        value = Mixed(op.double_value);
+                        break;
+                    case tag_string:
+                        value = Mixed(StringData(op.text));
+                        break;
+                    default:
+                        break;
+                }
+                // Converted once, as the same value is set on all objects
+                std::string converted_storage;
+                Mixed converted;
+                try {
+                    converted = convert(value, target, converted_storage);
+                }
+                catch (const std::invalid_argument& e) {
+                    throw std::invalid_argument("Could not set '" + target.name + "': " + e.what());
+                }
+                Reporter reporter(progress, index, target.table->size());
+                for (Obj obj : *target.table) {
+                    obj.set_any(target.key, converted);
+                    reporter.processed();
+                }
+                reporter.done();
+                break;
+            }
+            case op_delete: {
+                TableRef table = ObjectStore::table_for_object_type(group, op.class_name);
+                if (!table) {
+                    throw std::invalid_argument("Class '" + op.class_name + "' does not exist after the migration");
+                }
+                TableView matches = table->query(args[0]).find_all();
+                Reporter reporter(progress, index, matches.size());
+                matches.clear();
+                reporter.done();
+                break;
+            }
+        }
+    }
+}
+
+} // namespace realm::schema_migration
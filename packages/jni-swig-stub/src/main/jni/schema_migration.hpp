@@ -0,0 +1,91 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REALM_SCHEMA_MIGRATION_HPP
+#define REALM_SCHEMA_MIGRATION_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <realm/object-store/schema.hpp>
+#include <realm/object-store/shared_realm.hpp>
+
+namespace realm::schema_migration {
+
+// Receives the index of the running operation, the number of objects it has processed and the
+// total number of objects it processes. Called every few thousand objects and when the operation
+// completes.
+using ProgressHandler = std::function<void(size_t operation, size_t processed, size_t total)>;
+
+// A list of bulk operations run by the migration function of a realm, so migrations of large realms
+// do not have to cross into the SDK for every object.
+//
+// A plan is an int with the number of operations, each being a kind byte and the class name
+// followed by its arguments:
+// - 1, rename: the old and new property name.
+// - 2, convert: the property name. Values are converted from the type of the property before the
+//   migration to its type after the migration.
+// - 3, split: the source property, the separator and an int with the number of target properties
+//   followed by their names. The source value is split at the separator into at most as many parts
+//   as there are targets, the last target receiving the remainder, and the parts are converted to
+//   the type of their target.
+// - 4, merge: the target property and a template like "{street}, {city}" where properties in braces
+//   are replaced by their values formatted as strings. "{{" and "}}" are literal braces.
+// - 5, set: the property name and a value, which is converted to the type of the property and set
+//   on all objects.
+// - 6, delete: a query string. All objects of the class matching the query are deleted.
+//
+// Strings are an int length followed by the UTF-8 bytes, ints are little-endian and values are
+// encoded with the tags of backup journals on the Kotlin side. Sources of convert, split and merge
+// are read from the realm before the migration and all other properties refer to the schema after
+// the migration. Only properties of type int, bool, float, double and string are supported.
+class Plan {
+public:
+    // Throws std::invalid_argument if the plan is malformed
+    Plan(const char* data, size_t size);
+
+    // Runs the operations in order. Throws std::invalid_argument if a property does not exist, has
+    // an unsupported type or a value cannot be converted without losing information, which aborts
+    // the migration.
+    void run(const SharedRealm& old_realm, const SharedRealm& realm, Schema& schema,
+             const ProgressHandler& progress) const;
+
+    struct Part {
+        bool is_property;
+        std::string text;
+    };
+
+    struct Operation {
+        char kind;
+        std::string class_name;
+        std::vector<std::string> arguments;
+        // Parsed template of merge operations
+        std::vector<Part> parts;
+        // Value of set operations, where string values are held by text
+        char value_tag;
+        int64_t int_value;
+        double double_value;
+        float float_value;
+        std::string text;
+    };
+
+private:
+    std::vector<Operation> m_operations;
+};
+
+} // namespace realm::schema_migration
+
+#endif // REALM_SCHEMA_MIGRATION_HPP
@@ -53,6 +53,7 @@ kotlin {
     }
     ios()
     macosX64("macos") {}
+    linuxX64("linux") {}
     sourceSets {
         commonMain {
             dependencies {
@@ -104,18 +105,26 @@ kotlin {
         }
         getByName("macosMain") {
             // TODO HMPP Should be shared source set
+            kotlin.srcDir("src/native/kotlin")
             kotlin.srcDir("src/darwin/kotlin")
         }
         getByName("iosArm64Main") {
             // TODO HMPP Should be shared source set
+            kotlin.srcDir("src/native/kotlin")
             kotlin.srcDir("src/darwin/kotlin")
             kotlin.srcDir("src/ios/kotlin")
         }
         getByName("iosX64Main") {
             // TODO HMPP Should be shared source set
+            kotlin.srcDir("src/native/kotlin")
             kotlin.srcDir("src/darwin/kotlin")
             kotlin.srcDir("src/ios/kotlin")
         }
+        getByName("linuxMain") {
+            // TODO HMPP Should be shared source set
+            kotlin.srcDir("src/native/kotlin")
+            kotlin.srcDir("src/linux/kotlin")
+        }
     }
 
     // See https://kotlinlang.org/docs/reference/mpp-publish-lib.html#publish-a-multiplatform-library
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.readChangeLog
+
+/**
+ * Reader of change logs written for realms configured with [RealmConfiguration.Builder.changeLog].
+ *
+ * A change log is an append-only file with an entry per committed write transaction. Entries are
+ * addressed by their byte offset in the file, so consumers can tail the log by persisting the
+ * [ChangeLogEntry.nextOffset] of the last processed entry and reading from it later, also from
+ * another process.
+ *
+ * Consecutive entries cover consecutive versions of the realm, i.e. the
+ * [ChangeLogEntry.firstVersion] of an entry follows the [ChangeLogEntry.version] of the previous
+ * entry. Versions whose changes are missing from the log are covered by entries of type
+ * [ChangeLogEntry.Type.GAP]. If the first version of an entry does not follow the version of the
+ * previous one, the realm was written to while it was not open with the change log, and the
+ * versions in between are missing as well. Consumers must resynchronize from the realm itself when
+ * versions are missing.
+ */
+public object ChangeLog {
+
+    /**
+     * The offset of the first entry of a change log.
+     */
+    public const val START_OFFSET: Long = 8
+
+    /**
+     * The default upper bound of the number of bytes read by [read].
+     */
+    public const val DEFAULT_READ_SIZE: Int = 1024 * 1024
+
+    /**
+     * Reads the complete entries of the change log at [path] starting at [offset].
+     *
+     * At most [maxBytes] bytes of the log are read, except if the first entry is larger, in which
+     * case only that entry is read. An entry that is still being appended is not returned until it
+     * is complete.
+     *
+     * @param path the path of the change log.
+     * @param offset the offset of the first entry to read, i.e. [START_OFFSET] or the
+     * [ChangeLogEntry.nextOffset] of a previously read entry.
+     * @param maxBytes the upper bound of the number of bytes to read.
+     * @return the entries starting at [offset], which is empty if there are no new entries or if
+     * no change log exists at [path] yet.
+     * @throws IllegalArgumentException if the file at [path] is not a change log or if [offset] is
+     * before [START_OFFSET].
+     */
+    public fun read(path: String, offset: Long = START_OFFSET, maxBytes: Int = DEFAULT_READ_SIZE): List<ChangeLogEntry> {
+        if (offset < START_OFFSET) {
+            throw IllegalArgumentException("Offset must be at least $START_OFFSET: $offset")
+        }
+        if (maxBytes <= 0) {
+            throw IllegalArgumentException("maxBytes must be positive: $maxBytes")
+        }
+        return readChangeLog(path, offset, maxBytes)
+    }
+}
+
+/**
+ * The changes of a committed write transaction, or a gap of versions whose changes are missing
+ * from the change log.
+ */
+public class ChangeLogEntry internal constructor(
+    /**
+     * The kind of entry.
+     */
+    public val type: Type,
+
+    /**
+     * The first version of the realm covered by the entry. Versions before [version] were
+     * committed by write transactions without changes.
+     */
+    public val firstVersion: Long,
+
+    /**
+     * The version of the realm committed by the write transaction, or the last missing version of
+     * a gap.
+     */
+    public val version: Long,
+
+    /**
+     * The changed objects, ordered with deleted objects first, then inserted and modified objects.
+     * Empty for gaps.
+     */
+    public val changes: List<ObjectChange>,
+
+    /**
+     * The offset of the entry in the change log.
+     */
+    public val offset: Long,
+
+    /**
+     * The offset of the following entry in the change log.
+     */
+    public val nextOffset: Long
+) {
+    public enum class Type {
+        /**
+         * The changes of the write transaction that committed [version].
+         */
+        CHANGES,
+
+        /**
+         * The changes of the versions from [firstVersion] to [version] are missing from the log,
+         * either because they were committed by another process, realm instance or
+         * synchronization, or because they could not be appended to the log.
+         */
+        GAP
+    }
+
+    override fun toString(): String =
+        "ChangeLogEntry(type=$type, firstVersion=$firstVersion, version=$version, changes=$changes, offset=$offset)"
+}
+
+/**
+ * The change of an object by a write transaction.
+ */
+public class ObjectChange internal constructor(
+    /**
+     * The kind of change.
+     */
+    public val type: Type,
+
+    /**
+     * The name of the class of the object.
+     */
+    public val className: String,
+
+    /**
+     * The key of the object, which is unique among the objects of the class in a version of the
+     * realm. Keys of deleted objects can be reused.
+     */
+    public val objectKey: Long,
+
+    /**
+     * The primary key of the object, or `null` if the class does not have a primary key.
+     */
+    public val primaryKey: Any?,
+
+    /**
+     * The values of the changed properties by property name, excluding the primary key. Inserted
+     * objects contain all properties and deleted objects none. Integral and char values are
+     * [Long]s, referenced objects are [ObjectReference]s and lists are [List]s.
+     */
+    public val values: Map<String, Any?>
+) {
+    public enum class Type {
+        INSERTED,
+        MODIFIED,
+        DELETED
+    }
+
+    override fun toString(): String =
+        "ObjectChange(type=$type, className=$className, objectKey=$objectKey, primaryKey=$primaryKey, values=$values)"
+}
+
+/**
+ * A reference to an object in an [ObjectChange].
+ */
+public data class ObjectReference internal constructor(
+    public val className: String,
+    public val objectKey: Long,
+    public val primaryKey: Any?
+)
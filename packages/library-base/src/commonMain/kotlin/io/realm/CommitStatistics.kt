@@ -0,0 +1,72 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import kotlin.time.Duration
+
+/**
+ * A snapshot of the commit statistics of the write transactions of a [Realm].
+ *
+ * Committing a write transaction writes the modified data to the realm file and synchronizes the
+ * file to disk, so the commit time reflects the cost of disk I/O, while the remaining time of the
+ * write transactions is spent running the write blocks. Only durations are measured, so the
+ * statistics don't tell how many bytes a commit wrote or how many times it synced the file.
+ *
+ * @see RealmConfiguration.Builder.collectCommitStatistics
+ * @see Realm.commitStatistics
+ */
+public class CommitStatistics internal constructor(
+    /**
+     * The number of committed write transactions.
+     */
+    public val commits: Long,
+
+    /**
+     * The total time spent committing write transactions.
+     */
+    public val commitTime: Duration,
+
+    /**
+     * The longest time spent committing a single write transaction.
+     */
+    public val maxCommitTime: Duration,
+
+    /**
+     * The number of commits by duration. Each entry maps the upper bound of a range of durations to
+     * the number of commits that took longer than the previous upper bound and at most this long.
+     * The last entry has an upper bound of [Duration.INFINITE].
+     */
+    public val commitTimeHistogram: Map<Duration, Long>,
+
+    /**
+     * The total time write transactions held the write lock, including running the write blocks
+     * and committing.
+     */
+    public val transactionTime: Duration,
+
+    /**
+     * The size of the realm file in bytes when the snapshot was taken, or -1 if it cannot be
+     * determined.
+     */
+    public val fileSize: Long
+) {
+    override fun toString(): String {
+        return "CommitStatistics(commits=$commits, commitTime=$commitTime, maxCommitTime=$maxCommitTime, " +
+            "commitTimeHistogram=$commitTimeHistogram, transactionTime=$transactionTime, " +
+            "fileSize=$fileSize)"
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+/**
+ * An estimate of which search indexes the query behind a [RealmResults] can use, derived from the
+ * query string by a heuristic. It is not reported by the query engine.
+ *
+ * The query engine can use a search index to look up matching objects directly when the query
+ * requires an indexed property to be equal to a value. The estimate lists the indexed properties
+ * that appear in such equality conditions combined with the rest of the query by `AND` at the top
+ * level, including conditions from the queries that the results were derived from.
+ *
+ * The heuristic does not model the query optimizer of core:
+ * - Which of the [candidateProperties] is used, if any, is decided by core.
+ * - Conditions inside `OR` branches or parentheses, `IN`, `ANY`/`ALL`/`NONE`, `@links`, key
+ *   paths traversing links and subqueries are not considered, even where core might use an
+ *   index for them.
+ * - `SORT`, `DISTINCT` and `LIMIT` are ignored.
+ *
+ * @see RealmResults.estimatedIndexUsage
+ */
+public class EstimatedIndexUsage internal constructor(
+    /**
+     * The indexed properties of the top level equality conditions of the query in order of
+     * appearance. Core may use the index of any of them to look up the matching objects.
+     */
+    public val candidateProperties: List<String>
+) {
+    /**
+     * Whether the query has at least one condition that core may evaluate with a search index.
+     * If `false` the query is likely evaluated by scanning all objects.
+     */
+    public val mayUseIndex: Boolean
+        get() = candidateProperties.isNotEmpty()
+
+    override fun toString(): String {
+        return "EstimatedIndexUsage(candidateProperties=$candidateProperties)"
+    }
+}
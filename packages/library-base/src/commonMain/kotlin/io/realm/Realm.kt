@@ -19,6 +19,7 @@ import io.realm.internal.InternalRealmConfiguration
 import io.realm.internal.RealmImpl
 import kotlinx.coroutines.flow.Flow
 import kotlin.reflect.KClass
+import io.realm.internal.restoreBackup as restoreRealmBackup
 
 /**
  * A Realm instance is the main entry point for interacting with a persisted realm.
@@ -44,6 +45,11 @@ interface Realm : TypedRealm {
          */
         public const val ENCRYPTION_KEY_LENGTH = io.realm.internal.interop.Constants.ENCRYPTION_KEY_LENGTH
 
+        /**
+         * Default number of objects encoded in each chunk by [bulkInsert].
+         */
+        public const val DEFAULT_BULK_INSERT_CHUNK_SIZE = 1000
+
         /**
          * Open a realm instance.
          *
@@ -56,6 +62,32 @@ interface Realm : TypedRealm {
         public fun open(configuration: RealmConfiguration): Realm {
             return RealmImpl(configuration as InternalRealmConfiguration)
         }
+
+        /**
+         * Restores a realm from a backup snapshot written with `Realm.writeBackupSnapshot` and the
+         * backup journal of the write transactions committed after it. The snapshot is copied to the
+         * path of [configuration] and the journal is replayed on top of it in a single write
+         * transaction. Neither the snapshot nor the journal are modified.
+         *
+         * A journal that ends with a partially appended record, e.g. because the process died
+         * while appending it, is restored up to the last complete record. The journal is read into
+         * memory in full, so its size should be bounded by writing snapshots regularly.
+         *
+         * The backup journal of [configuration] is not appended to while restoring.
+         *
+         * This is only supported on JVM and Android.
+         *
+         * @param configuration the configuration of the restored realm. It must use the schema and
+         * encryption key of the backed up realm.
+         * @param snapshotPath the path of the backup snapshot.
+         * @param journalPath the path of the backup journal.
+         * @return the number of write transactions replayed from the journal.
+         * @throws IllegalArgumentException if a file already exists at the path of [configuration]
+         * or if the journal is not a valid backup journal.
+         */
+        public fun restoreBackup(configuration: RealmConfiguration, snapshotPath: String, journalPath: String): Long {
+            return restoreRealmBackup(configuration as InternalRealmConfiguration, snapshotPath, journalPath)
+        }
     }
 
     /**
@@ -101,6 +133,26 @@ interface Realm : TypedRealm {
      */
     fun <R> writeBlocking(block: MutableRealm.() -> R): R
 
+    /**
+     * Insert a large number of unmanaged objects in a single write transaction.
+     *
+     * Objects are collected and encoded in chunks of [chunkSize] objects on
+     * [kotlinx.coroutines.Dispatchers.Default], while previously encoded chunks are inserted on the
+     * Realm Write Dispatcher. This keeps reading the objects' properties and traversing their
+     * object graphs out of the write transaction. The semantics of inserting each object is
+     * the same as [MutableRealm.copyToRealm]. Managed objects are ignored.
+     *
+     * If collecting [objects] or inserting an object fails, the transaction is rolled back and no
+     * objects are inserted.
+     *
+     * @param objects the unmanaged objects to insert.
+     * @param chunkSize the number of objects encoded before handing them over to the writer.
+     * @return the number of objects inserted.
+     * @throws IllegalArgumentException if [chunkSize] is not positive or if an object with an
+     * existing primary key is inserted.
+     */
+    suspend fun <T : RealmObject> bulkInsert(objects: Flow<T>, chunkSize: Int = DEFAULT_BULK_INSERT_CHUNK_SIZE): Long
+
     /**
      * Observe changes to the Realm. If there is any change to the Realm, the flow will emit the
      * updated Realm. The flow will continue running indefinitely until canceled.
@@ -111,6 +163,26 @@ interface Realm : TypedRealm {
      */
     fun observe(): Flow<Realm>
 
+    /**
+     * Returns a snapshot of the commit statistics collected for the write transactions of this
+     * realm since it was opened, along with the current size of the realm file.
+     *
+     * @throws IllegalStateException if the realm was not configured to collect commit statistics
+     * with [RealmConfiguration.Builder.collectCommitStatistics].
+     */
+    fun commitStatistics(): CommitStatistics
+
+    /**
+     * Returns whether the changes of the last write transaction committed through this realm could
+     * not be appended to the change log configured with [RealmConfiguration.Builder.changeLog].
+     *
+     * The write transaction stays committed. The next write transaction appends an entry of type
+     * [ChangeLogEntry.Type.GAP] for the missing versions and resumes logging.
+     *
+     * @throws IllegalStateException if the realm was not configured with a change log.
+     */
+    fun isChangeLogInterrupted(): Boolean
+
     /**
      * Close this Realm and all underlying resources. Accessing any methods or Realm Objects after this
      * method has been called will then an [IllegalStateException].
@@ -19,12 +19,14 @@ package io.realm
 import io.realm.internal.REPLACED_BY_IR
 import io.realm.internal.RealmConfigurationImpl
 import io.realm.internal.RealmObjectCompanion
+import io.realm.internal.SchemaMigrationSetup
 import io.realm.internal.platform.createDefaultSystemLogger
 import io.realm.internal.platform.singleThreadDispatcher
 import io.realm.log.LogLevel
 import io.realm.log.RealmLogger
 import kotlinx.coroutines.CoroutineDispatcher
 import kotlin.reflect.KClass
+import kotlin.time.Duration
 
 /**
  * Configuration for log events created by a Realm instance.
@@ -95,6 +97,14 @@ interface RealmConfiguration {
      */
     public val deleteRealmIfMigrationNeeded: Boolean
 
+    /**
+     * The bulk operations migrating the data of the realm when its schema version is increased.
+     * See the `RealmConfiguration.Builder.migration` extension for details.
+     *
+     * @return null if no migration is configured.
+     */
+    public val migration: SchemaMigration?
+
     /**
      * 64 byte key used to encrypt and decrypt the Realm file.
      *
@@ -102,6 +112,55 @@ interface RealmConfiguration {
      */
     val encryptionKey: ByteArray?
 
+    /**
+     * Flag indicating whether the realm is kept in memory instead of being persisted to disk.
+     */
+    public val inMemory: Boolean
+
+    /**
+     * Flag indicating whether the realm file is read into the page cache ahead of being accessed when
+     * the realm is opened. See [Builder.prefetchFile] for details.
+     */
+    public val prefetchFile: Boolean
+
+    /**
+     * Flag indicating whether commit statistics are collected for the write transactions of the
+     * realm. See [Builder.collectCommitStatistics] for details.
+     */
+    public val collectCommitStatistics: Boolean
+
+    /**
+     * Queries taking longer than this to evaluate are reported as warnings to the configured
+     * loggers. See [Builder.slowQueryThreshold] for details.
+     *
+     * @return null if slow queries are not reported.
+     */
+    public val slowQueryThreshold: Duration?
+
+    /**
+     * Write transactions holding the write lock for longer than this are reported as warnings to
+     * the configured loggers. See [Builder.longTransactionThreshold] for details.
+     *
+     * @return null if long running write transactions are not reported.
+     */
+    public val longTransactionThreshold: Duration?
+
+    /**
+     * Path of the backup journal that committed write transactions are appended to. See
+     * [Builder.backupJournal] for details.
+     *
+     * @return null if write transactions are not journaled.
+     */
+    public val backupJournalPath: String?
+
+    /**
+     * Path of the change log that the changes of committed write transactions are appended to. See
+     * [Builder.changeLog] for details.
+     *
+     * @return null if no change log is written.
+     */
+    public val changeLogPath: String?
+
     companion object {
         /**
          * Create a configuration using default values except for schema, path and name.
@@ -143,6 +202,14 @@ interface RealmConfiguration {
         protected var deleteRealmIfMigrationNeeded: Boolean = false
         protected var schemaVersion: Long = 0
         protected var encryptionKey: ByteArray? = null
+        protected var inMemory: Boolean = false
+        protected var prefetchFile: Boolean = false
+        protected var collectCommitStatistics: Boolean = false
+        protected var slowQueryThreshold: Duration? = null
+        protected var longTransactionThreshold: Duration? = null
+        protected var backupJournalPath: String? = null
+        protected var changeLogPath: String? = null
+        protected var migration: SchemaMigrationSetup? = null
 
         /**
          * Creates the RealmConfiguration based on the builder properties.
@@ -274,6 +341,9 @@ interface RealmConfiguration {
             return apply { this.schemaVersion = schemaVersion } as S
         }
 
+        // Called from the JVM only `migration` extension, as migrations run natively through JNI
+        internal fun schemaMigration(migration: SchemaMigrationSetup) = apply { this.migration = migration } as S
+
         /**
          * Sets the 64 byte key used to encrypt and decrypt the Realm file. If no key is provided the Realm file
          * will be unencrypted.
@@ -285,6 +355,121 @@ interface RealmConfiguration {
         fun encryptionKey(encryptionKey: ByteArray) =
             apply { this.encryptionKey = validateEncryptionKey(encryptionKey) } as S
 
+        /**
+         * Keeps the realm in memory instead of persisting it to disk. This avoids the cost of
+         * writing and syncing data to the file system, which makes it suitable for caches and tests.
+         *
+         * The data is shared by all instances of the realm with the same path, including those used
+         * internally for background writes and notifications, for as long as at least one of them is
+         * open. When the last instance is closed all data is lost. The realm still uses the
+         * configured path for its auxiliary files, such as the lock file, so distinct in-memory
+         * realms must use distinct paths.
+         */
+        fun inMemory() = apply { this.inMemory = true } as S
+
+        /**
+         * Advises the operating system to read the realm file into its page cache in the background
+         * when the realm is opened. Reads of data that is not in the page cache otherwise cause page
+         * faults that have to wait for the disk, which can make the first queries on a large realm
+         * slow when it has not been accessed recently.
+         *
+         * The advice is best effort and does not delay opening the realm. It is ignored for
+         * [inMemory] realms and on platforms that don't support it.
+         */
+        fun prefetchFile() = apply { this.prefetchFile = true } as S
+
+        /**
+         * Collects statistics about the time spent committing write transactions, which includes
+         * writing the changes to the realm file and synchronizing it to disk, and about the time
+         * write transactions hold the write lock. This allows attributing the latency of writes to
+         * committing rather than to running the write blocks. The statistics are available through
+         * [Realm.commitStatistics] and are logged at debug level when the realm is closed.
+         *
+         * Only the duration of commits is measured, not the bytes written or the number of syncs
+         * to disk they cause. Collecting statistics adds the cost of reading the clock to every
+         * write transaction, so it is disabled by default.
+         */
+        fun collectCommitStatistics() = apply { this.collectCommitStatistics = true } as S
+
+        /**
+         * Reports queries that take longer than [threshold] to evaluate as warnings to the configured
+         * loggers, including the query string and the number of matching objects.
+         *
+         * The measured time covers parsing the query and evaluating its results. As queries are
+         * otherwise evaluated lazily when first accessed, enabling this causes queries to be
+         * evaluated when they are created. This is intended for diagnosing performance issues and
+         * is disabled by default.
+         *
+         * @param threshold the duration a query must exceed to be reported.
+         */
+        fun slowQueryThreshold(threshold: Duration) =
+            apply { this.slowQueryThreshold = validateThreshold(threshold) } as S
+
+        /**
+         * Reports write transactions that hold the write lock for longer than [threshold] as warnings
+         * to the configured loggers. The report includes the name of the coroutine that started the
+         * transaction, if any, and the stack trace of the call to [Realm.write] or
+         * [Realm.writeBlocking].
+         *
+         * Other writes are blocked while a transaction holds the write lock, so long running
+         * transactions delay all writes to the realm. This is intended for diagnosing performance
+         * issues and is disabled by default.
+         *
+         * @param threshold the duration a write transaction must exceed to be reported.
+         */
+        fun longTransactionThreshold(threshold: Duration) =
+            apply { this.longTransactionThreshold = validateThreshold(threshold) } as S
+
+        /**
+         * Appends the changes of every write transaction committed through the realm to an
+         * append-only backup journal at [path]. Together with a backup snapshot written with
+         * `Realm.writeBackupSnapshot` the journal allows restoring the realm with
+         * [Realm.restoreBackup], so only the journal has to be backed up after each snapshot
+         * instead of the full realm.
+         *
+         * Records identify objects by their primary key, so all classes of the schema must have a
+         * primary key. Each record holds the inserted objects, the modified properties of modified
+         * objects and the primary keys of the deleted objects of a transaction, and is appended and
+         * synced to disk after the transaction is committed. This adds the cost of encoding the
+         * changes and writing the record to every write transaction. If appending a record fails,
+         * the transaction stays committed and the error is logged. Journaling then stops until a
+         * new backup snapshot is written.
+         *
+         * Only write transactions of the [Realm] opened with this configuration are journaled.
+         * Writes from other processes or realm instances are not. Journaling is not supported for
+         * [inMemory] realms, and cannot be combined with the JVM only `migration` extension, as
+         * migrated objects are not recorded.
+         *
+         * @param path the path of the backup journal.
+         */
+        fun backupJournal(path: String) = apply { this.backupJournalPath = path } as S
+
+        /**
+         * Appends the changes of every write transaction committed through the realm to an
+         * append-only change log at [path], which downstream consumers can tail with
+         * [ChangeLog.read] to capture the changes of the realm without comparing versions of it.
+         *
+         * Each entry holds the inserted, modified and deleted objects of a transaction by class,
+         * object key and primary key, along with the values of all properties of inserted objects
+         * and of the modified properties of modified objects. The properties modified by a
+         * transaction are tracked while it runs, so the cost of an entry is proportional to the
+         * changes of the transaction. Entries are appended after the transaction is committed
+         * without syncing the log to disk. If appending an entry fails, the transaction stays
+         * committed, the error is logged and [Realm.isChangeLogInterrupted] returns `true`. The
+         * next write transaction appends an entry of type [ChangeLogEntry.Type.GAP] for the
+         * versions that could not be logged and resumes logging.
+         *
+         * The log is never truncated, so it must be rotated by the consumers if needed. Only the
+         * changes of write transactions of the [Realm] opened with this configuration are logged.
+         * Versions committed by other processes, realm instances or synchronization are logged as
+         * gaps with the next write transaction of the realm, so a single realm instance should
+         * write to a log. Cannot be combined with the JVM only `migration` extension, as migrated
+         * objects are not recorded.
+         *
+         * @param path the path of the change log.
+         */
+        fun changeLog(path: String) = apply { this.changeLogPath = path } as S
+
         /**
          * TODO Evaluate if this should be part of the public API. For now keep it internal.
          *
@@ -302,6 +487,13 @@ interface RealmConfiguration {
             }
             return encryptionKey
         }
+
+        protected fun validateThreshold(threshold: Duration): Duration {
+            if (threshold.isNegative()) {
+                throw IllegalArgumentException("Only non-negative thresholds are allowed. Yours was: $threshold")
+            }
+            return threshold
+        }
     }
 
     /**
@@ -334,7 +526,15 @@ interface RealmConfiguration {
                 writeDispatcher ?: singleThreadDispatcher(name),
                 schemaVersion,
                 deleteRealmIfMigrationNeeded,
-                encryptionKey
+                encryptionKey,
+                inMemory,
+                prefetchFile,
+                collectCommitStatistics,
+                slowQueryThreshold,
+                longTransactionThreshold,
+                backupJournalPath,
+                changeLogPath,
+                migration
             )
         }
     }
@@ -41,6 +41,20 @@ interface RealmResults<T : RealmObject> : List<T>, Queryable<T>, Versioned {
      */
     fun observe(): Flow<RealmResults<T>>
 
+    /**
+     * Estimates whether the query behind these results can use a search index to find the
+     * matching objects.
+     *
+     * This is meant as a hint when tuning which properties should be indexed against the queries
+     * of an app, see [io.realm.annotations.Index]. The estimate is a heuristic over the query
+     * conditions and the indexes present in the version of the realm that the results belong to,
+     * not a report from the query engine. See [EstimatedIndexUsage] for its limitations.
+     *
+     * @return the estimated index usage of the query.
+     * @throws IllegalStateException if the realm has been closed.
+     */
+    fun estimatedIndexUsage(): EstimatedIndexUsage
+
     /**
      * Delete all objects from this result from the realm.
      */
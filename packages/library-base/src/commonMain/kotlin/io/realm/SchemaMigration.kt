@@ -0,0 +1,158 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.JournalEncoder
+
+/**
+ * A list of bulk operations that migrate the data of a realm when it is opened with a higher
+ * [RealmConfiguration.schemaVersion] than the one it was written with. See the
+ * `RealmConfiguration.Builder.migration` extension, which is only available on JVM and Android.
+ *
+ * Operations are run natively in the order they were added, inside the write transaction that
+ * updates the schema, so migrating millions of objects does not require creating an object or
+ * reading a property through the SDK per object. Classes and properties are referenced by their
+ * names in the schema. Properties read by [convertProperty], [splitProperty] and
+ * [mergeProperties] are read from the realm as it was before the migration, while all other
+ * properties refer to the schema after the migration.
+ *
+ * Operations only support properties of type `Byte`, `Char`, `Short`, `Int`, `Long`, `Boolean`,
+ * `Float`, `Double` and `String`. A value that cannot be converted to the type of a property
+ * without losing information, like `"abc"` to `Int` or `1.5` to `Long`, fails the migration, which
+ * leaves the realm unchanged.
+ */
+public class SchemaMigration private constructor(private val plan: ByteArray) {
+
+    /**
+     * Builder of [SchemaMigration]s.
+     */
+    public class Builder {
+
+        private val encoder = JournalEncoder()
+        private var operations = 0
+
+        /**
+         * Renames the property [oldName] of [className] to [newName] while keeping its values.
+         * [newName] must be part of the schema after the migration, [oldName] must not be, and
+         * both must have the same type.
+         */
+        public fun renameProperty(className: String, oldName: String, newName: String): Builder =
+            add(OP_RENAME, className) {
+                encoder.writeString(oldName)
+                encoder.writeString(newName)
+            }
+
+        /**
+         * Converts the values of [property] of [className] from its type before the migration to
+         * its type after the migration. Numbers are converted to strings in their shortest form
+         * and strings are parsed as numbers or as `true` and `false`, while `Boolean`s convert to
+         * and from the integers 0 and 1.
+         */
+        public fun convertProperty(className: String, property: String): Builder =
+            add(OP_CONVERT, className) {
+                encoder.writeString(property)
+            }
+
+        /**
+         * Splits the string values of [source] of [className] at [separator] into the [targets],
+         * like `fullName` into `firstName` and `lastName`. Values are split into at most as many
+         * parts as there are targets, so the last target receives the remainder, and targets
+         * without a part receive an empty string. Parts are converted to the types of their
+         * targets. Targets of objects with a null value are left untouched.
+         */
+        public fun splitProperty(className: String, source: String, separator: String, targets: List<String>): Builder {
+            if (separator.isEmpty()) {
+                throw IllegalArgumentException("The separator must not be empty")
+            }
+            if (targets.isEmpty()) {
+                throw IllegalArgumentException("At least one target property is required")
+            }
+            return add(OP_SPLIT, className) {
+                encoder.writeString(source)
+                encoder.writeString(separator)
+                encoder.writeInt(targets.size)
+                targets.forEach { encoder.writeString(it) }
+            }
+        }
+
+        /**
+         * Sets [target] of [className] to [template] with each property name in braces replaced
+         * by the value of the property formatted as a string, like `"{street}, {city}"`. Null
+         * values are replaced by empty strings and `{{` and `}}` are literal braces. The result is
+         * converted to the type of [target].
+         */
+        public fun mergeProperties(className: String, target: String, template: String): Builder =
+            add(OP_MERGE, className) {
+                encoder.writeString(target)
+                encoder.writeString(template)
+            }
+
+        /**
+         * Sets [property] of all objects of [className] to [value], which is converted to the type
+         * of the property. This is useful to initialize new properties with a value that differs
+         * from their default.
+         */
+        public fun setValue(className: String, property: String, value: Any?): Builder {
+            when (value) {
+                null, is Byte, is Char, is Short, is Int, is Long, is Boolean, is Float, is Double, is String -> Unit
+                else -> throw IllegalArgumentException("Unsupported value type: ${value::class.simpleName}")
+            }
+            return add(OP_SET, className) {
+                encoder.writeString(property)
+                encoder.writeValue(value)
+            }
+        }
+
+        /**
+         * Deletes all objects of [className] matching [query], which is a query in the Realm Query
+         * Language on the properties of the class, including properties that are removed by the
+         * migration.
+         */
+        public fun deleteWhere(className: String, query: String): Builder =
+            add(OP_DELETE, className) {
+                encoder.writeString(query)
+            }
+
+        /**
+         * Creates the migration from the added operations.
+         */
+        public fun build(): SchemaMigration {
+            val plan = JournalEncoder()
+            plan.writeInt(operations)
+            plan.writeBytes(encoder.toByteArray())
+            return SchemaMigration(plan.toByteArray())
+        }
+
+        private inline fun add(kind: Byte, className: String, arguments: () -> Unit): Builder = apply {
+            encoder.writeByte(kind)
+            encoder.writeString(className)
+            arguments()
+            operations++
+        }
+    }
+
+    internal fun encode(): ByteArray = plan
+
+    private companion object {
+        const val OP_RENAME: Byte = 1
+        const val OP_CONVERT: Byte = 2
+        const val OP_SPLIT: Byte = 3
+        const val OP_MERGE: Byte = 4
+        const val OP_SET: Byte = 5
+        const val OP_DELETE: Byte = 6
+    }
+}
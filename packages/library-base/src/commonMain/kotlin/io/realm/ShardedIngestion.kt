@@ -0,0 +1,151 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.EncodedObject
+import io.realm.internal.MutableRealmImpl
+import io.realm.internal.RealmImpl
+import io.realm.internal.encodeObject
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.Dispatchers
+import kotlinx.coroutines.async
+import kotlinx.coroutines.awaitAll
+import kotlinx.coroutines.channels.Channel
+import kotlinx.coroutines.coroutineScope
+import kotlinx.coroutines.flow.Flow
+import kotlinx.coroutines.flow.collect
+import kotlinx.coroutines.launch
+import kotlinx.coroutines.withContext
+
+/**
+ * Utility for bulk ingestion of unmanaged objects into a set of realms that shards data across
+ * multiple files.
+ *
+ * Objects are routed to a realm by the [shard] function and grouped into batches of [batchSize]
+ * objects. Each batch is inserted in a single write transaction on the writer of the target realm,
+ * so writes to the same file are still serialized, while writes to different files run in
+ * parallel on their individual write dispatchers. Objects are routed and batched by a single
+ * coroutine, while the properties of the batched objects are read by one encoder per realm. Both
+ * run on the [dispatcher], which by default is the shared pool of [Dispatchers.Default], so the
+ * batches of different realms are encoded in parallel and the next batches are prepared while
+ * previous transactions are being committed. Managed objects are ignored.
+ *
+ * Routing never waits for a slow realm. Batches routed to a realm that cannot keep up are buffered
+ * until its encoder gets to them, so memory use grows with the number of objects pending for the
+ * slowest realm.
+ *
+ * ```
+ * val ingestion = ShardedIngestion(listOf(realm1, realm2)) { person: Person -> person.id % 2 }
+ * val inserted = ingestion.ingest(persons.asFlow())
+ * ```
+ *
+ * @param realms the realms to distribute the objects across.
+ * @param batchSize the number of objects inserted in each transaction.
+ * @param dispatcher the dispatcher on which objects are routed, batched and encoded.
+ * @param shard function returning the index in [realms] of the realm an object should be inserted
+ * into.
+ */
+class ShardedIngestion<T : RealmObject>(
+    val realms: List<Realm>,
+    val batchSize: Int = DEFAULT_BATCH_SIZE,
+    private val dispatcher: CoroutineDispatcher = Dispatchers.Default,
+    private val shard: (T) -> Int
+) {
+
+    init {
+        require(realms.isNotEmpty()) { "At least one realm must be supplied." }
+        require(batchSize > 0) { "Batch size must be positive: $batchSize" }
+    }
+
+    /**
+     * Insert all objects emitted by [objects] into the shard selected for each of them.
+     *
+     * The function suspends until all objects have been committed to their realms. If a
+     * transaction fails, the remaining writes are cancelled and the exception is rethrown. Batches
+     * committed before the failure are not rolled back.
+     *
+     * @param objects the unmanaged objects to insert.
+     * @return the number of objects inserted.
+     * @throws IllegalArgumentException if [shard] returns an index outside of [realms].
+     */
+    suspend fun ingest(objects: Flow<T>): Long = coroutineScope {
+        val mediators = realms.map { (it as RealmImpl).configuration.mediator }
+        // Routed batches are buffered without a bound, so a shard that cannot keep up never
+        // suspends routing of the objects of the other shards
+        val routed: List<Channel<List<T>>> = realms.map { Channel(Channel.UNLIMITED) }
+        val encoded: List<Channel<List<EncodedObject>>> = realms.map { Channel(IN_FLIGHT_BATCHES) }
+        val writers = realms.mapIndexed { index, realm ->
+            async {
+                var inserted = 0L
+                for (batch in encoded[index]) {
+                    realm.write {
+                        (this as MutableRealmImpl).insertEncoded(batch)
+                    }
+                    inserted += batch.size
+                }
+                inserted
+            }
+        }
+        realms.indices.forEach { index ->
+            launch(dispatcher) {
+                try {
+                    for (batch in routed[index]) {
+                        encoded[index].send(batch.mapNotNull { encodeObject(mediators[index], it) })
+                    }
+                } finally {
+                    encoded[index].close()
+                }
+            }
+        }
+        try {
+            withContext(dispatcher) {
+                val pending: List<MutableList<T>> = realms.map { ArrayList(batchSize) }
+                objects.collect { obj ->
+                    val index = shard(obj)
+                    if (index !in realms.indices) {
+                        throw IllegalArgumentException("Invalid shard index $index for ${realms.size} realms")
+                    }
+                    val batch = pending[index]
+                    batch.add(obj)
+                    if (batch.size == batchSize) {
+                        routed[index].send(batch.toList())
+                        batch.clear()
+                    }
+                }
+                pending.forEachIndexed { index, batch ->
+                    if (batch.isNotEmpty()) {
+                        routed[index].send(batch.toList())
+                    }
+                }
+            }
+        } finally {
+            routed.forEach { it.close() }
+        }
+        writers.awaitAll().sum()
+    }
+
+    companion object {
+        /**
+         * Default number of objects inserted in each transaction.
+         */
+        const val DEFAULT_BATCH_SIZE = 1000
+
+        // Number of encoded batches that can be queued for each realm before its encoder is
+        // suspended
+        private const val IN_FLIGHT_BATCHES = 2
+    }
+}
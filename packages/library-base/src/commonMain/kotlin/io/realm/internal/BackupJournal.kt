@@ -0,0 +1,396 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.internal.interop.ClassKey
+import io.realm.internal.interop.ColumnKey
+import io.realm.internal.interop.NativePointer
+import io.realm.internal.interop.RealmCoreException
+import io.realm.internal.interop.RealmInterop
+import io.realm.internal.interop.RealmObjectInterop
+import io.realm.internal.platform.appendFile
+import io.realm.internal.platform.copyFile
+import io.realm.internal.platform.fileExists
+import io.realm.internal.platform.readFile
+import io.realm.internal.platform.runBlocking
+import io.realm.internal.platform.writeFile
+
+/*
+ * A backup journal is an append-only file of the write transactions committed to a realm since its
+ * last backup snapshot. It starts with a header of the 4 byte magic "RLMJ" and an int format
+ * version, followed by a record per write transaction as encoded by [ChangeRecorder.encode],
+ * prefixed with the length of the record as an int. Ints and longs are little-endian.
+ *
+ * Inserted objects are recorded with the values of all properties and modified objects with the
+ * values of the modified properties, so replaying a record only depends on the objects being
+ * identified by their primary key.
+ *
+ * Records are appended after their transaction is committed, so a journal that was being appended
+ * to when the process died can end with a truncated record, which is ignored when restoring.
+ */
+
+private val JOURNAL_MAGIC = byteArrayOf('R'.code.toByte(), 'L'.code.toByte(), 'M'.code.toByte(), 'J'.code.toByte())
+private const val JOURNAL_FORMAT_VERSION = 1
+
+internal const val RECORD_FILE_HEADER_SIZE = 8
+
+internal const val TAG_NULL: Byte = 0
+internal const val TAG_INT: Byte = 1
+internal const val TAG_BOOLEAN: Byte = 2
+internal const val TAG_FLOAT: Byte = 3
+internal const val TAG_DOUBLE: Byte = 4
+internal const val TAG_STRING: Byte = 5
+internal const val TAG_OBJECT: Byte = 6
+internal const val TAG_LIST: Byte = 7
+
+/**
+ * Starts a new, empty backup journal at [path], replacing any existing journal.
+ */
+internal fun resetBackupJournal(path: String) {
+    resetRecordFile(path, JOURNAL_MAGIC, JOURNAL_FORMAT_VERSION)
+}
+
+/**
+ * Appends a record encoded with [ChangeRecorder.encode] to the backup journal at [path], starting
+ * a new journal if none exists. The journal is synced to disk before returning.
+ */
+internal fun appendBackupJournal(path: String, record: ByteArray) {
+    appendRecord(path, JOURNAL_MAGIC, JOURNAL_FORMAT_VERSION, record, sync = true)
+}
+
+/**
+ * Starts a new, empty file of length-prefixed records at [path], replacing any existing file.
+ */
+internal fun resetRecordFile(path: String, magic: ByteArray, formatVersion: Int) {
+    val encoder = JournalEncoder()
+    encoder.writeBytes(magic)
+    encoder.writeInt(formatVersion)
+    writeFile(path, encoder.toByteArray())
+}
+
+/**
+ * Appends a length-prefixed record to the file at [path], starting a new file if none exists.
+ */
+internal fun appendRecord(path: String, magic: ByteArray, formatVersion: Int, record: ByteArray, sync: Boolean) {
+    if (!fileExists(path)) {
+        resetRecordFile(path, magic, formatVersion)
+    }
+    val encoder = JournalEncoder()
+    encoder.writeInt(record.size)
+    encoder.writeBytes(record)
+    appendFile(path, encoder.toByteArray(), sync)
+}
+
+/**
+ * Verifies that [header] is the header of a record file with the given magic and format version.
+ */
+internal fun checkRecordFileHeader(header: ByteArray, magic: ByteArray, formatVersion: Int, description: String, path: String) {
+    if (header.size < RECORD_FILE_HEADER_SIZE || !header.copyOf(magic.size).contentEquals(magic)) {
+        throw IllegalArgumentException("Not a $description: $path")
+    }
+    val version = JournalDecoder(header, magic.size).readInt()
+    if (version != formatVersion) {
+        throw IllegalArgumentException("Unsupported $description format version $version: $path")
+    }
+}
+
+/**
+ * Restores a realm by copying the backup snapshot to the path of [configuration] and replaying the
+ * records of the backup journal on top of it.
+ *
+ * All records are replayed in a single write transaction, so either the full journal is replayed
+ * or the restored realm only contains the snapshot.
+ *
+ * @return the number of replayed records.
+ */
+internal fun restoreBackup(
+    configuration: InternalRealmConfiguration,
+    snapshotPath: String,
+    journalPath: String
+): Long {
+    if (fileExists(configuration.path)) {
+        throw IllegalArgumentException("Cannot restore a backup to an existing realm: ${configuration.path}")
+    }
+    val journal = readFile(journalPath)
+    checkRecordFileHeader(journal, JOURNAL_MAGIC, JOURNAL_FORMAT_VERSION, "backup journal", journalPath)
+    copyFile(snapshotPath, configuration.path)
+    // The realm is opened without a change recorder, so the replayed records are not journaled
+    return runBlocking(configuration.writeDispatcher) {
+        val realm = MutableRealmImpl(configuration, configuration.writeDispatcher)
+        try {
+            realm.beginTransaction()
+            val replayed = JournalReplayer(realm.realmReference.dbPointer).replay(journal)
+            realm.commitTransaction()
+            realm.log.info("Restored ${configuration.path} from $snapshotPath and $replayed records of $journalPath")
+            replayed
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Could not replay the backup journal: $journalPath", exception)
+        } finally {
+            if (realm.isInTransaction()) {
+                realm.cancelWrite()
+            }
+            realm.close()
+        }
+    }
+}
+
+/**
+ * Applies the records of a backup journal to a realm in a write transaction.
+ *
+ * Objects are resolved by their primary key through the C-API, so this does not depend on the
+ * generated accessors and column keys are only resolved once per property.
+ */
+private class JournalReplayer(private val realm: NativePointer) {
+
+    private val classKeys: MutableMap<String, ClassKey> = mutableMapOf()
+    private val columnKeys: MutableMap<Pair<String, String>, ColumnKey> = mutableMapOf()
+
+    fun replay(journal: ByteArray): Long {
+        val decoder = JournalDecoder(journal, RECORD_FILE_HEADER_SIZE)
+        var replayed = 0L
+        while (decoder.remaining() >= Int.SIZE_BYTES) {
+            val length = decoder.readInt()
+            if (length > decoder.remaining()) {
+                // Record of a transaction that was being appended when the process died
+                break
+            }
+            applyRecord(decoder)
+            replayed++
+        }
+        return replayed
+    }
+
+    private fun applyRecord(decoder: JournalDecoder) {
+        // The version and object keys are only informational, as the snapshot has its own version
+        // history and object keys are not preserved when replaying
+        decoder.readLong()
+        repeat(decoder.readInt()) {
+            val className = decoder.readString()
+            decoder.readLong()
+            val primaryKey = decoder.readValue()
+            RealmInterop.realm_object_find_with_primary_key(realm, classKey(className), primaryKey)
+                ?.let { RealmInterop.realm_object_delete(it) }
+        }
+        // Inserted and modified objects only differ in the properties they are recorded with
+        repeat(2) {
+            repeat(decoder.readInt()) {
+                applyObject(decoder)
+            }
+        }
+    }
+
+    private fun applyObject(decoder: JournalDecoder) {
+        val className = decoder.readString()
+        decoder.readLong()
+        val obj = findOrCreate(className, decoder.readValue())
+        repeat(decoder.readInt()) {
+            val key = columnKey(className, decoder.readString())
+            val value = decoder.readValue(::resolveReference)
+            if (value is List<*>) {
+                val list = RealmInterop.realm_get_list(obj, key)
+                RealmInterop.realm_list_clear(list)
+                value.forEachIndexed { index, element ->
+                    RealmInterop.realm_list_add(list, index.toLong(), element)
+                }
+            } else {
+                RealmInterop.realm_set_value(obj, key, value, false)
+            }
+        }
+    }
+
+    // Referenced objects that are not part of the realm yet are inserted later in the same record
+    @Suppress("UNUSED_PARAMETER")
+    private fun resolveReference(className: String, objectKey: Long, primaryKey: Any?): Any =
+        ObjectReference(findOrCreate(className, primaryKey))
+
+    private fun findOrCreate(className: String, primaryKey: Any?): NativePointer {
+        val key = classKey(className)
+        return RealmInterop.realm_object_find_with_primary_key(realm, key, primaryKey)
+            ?: RealmInterop.realm_object_create_with_primary_key(realm, key, primaryKey)
+    }
+
+    private fun classKey(className: String): ClassKey =
+        classKeys.getOrPut(className) { RealmInterop.realm_find_class(realm, className) }
+
+    private fun columnKey(className: String, property: String): ColumnKey =
+        columnKeys.getOrPut(className to property) { RealmInterop.realm_get_col_key(realm, className, property) }
+
+    private class ObjectReference(override var `$realm$ObjectPointer`: NativePointer?) : RealmObjectInterop
+}
+
+/**
+ * Growable little-endian buffer for encoding the records of backup journals and change logs.
+ *
+ * Strings are encoded as an int length followed by the UTF-8 bytes. Values are encoded as a tag
+ * byte followed by the value: nothing for null, a long for integral values and chars, a byte for
+ * booleans, the raw bits of floats and doubles, a string, an object reference of class name,
+ * object key and primary key value, or an int size followed by the elements for lists.
+ */
+internal class JournalEncoder {
+
+    private var buffer = ByteArray(INITIAL_CAPACITY)
+    private var size = 0
+
+    fun writeBytes(bytes: ByteArray) {
+        ensureCapacity(bytes.size)
+        bytes.copyInto(buffer, size)
+        size += bytes.size
+    }
+
+    fun writeByte(value: Byte) {
+        ensureCapacity(1)
+        buffer[size++] = value
+    }
+
+    fun writeInt(value: Int) {
+        ensureCapacity(Int.SIZE_BYTES)
+        for (i in 0 until Int.SIZE_BYTES) {
+            buffer[size++] = (value shr (i * 8)).toByte()
+        }
+    }
+
+    fun writeLong(value: Long) {
+        ensureCapacity(Long.SIZE_BYTES)
+        for (i in 0 until Long.SIZE_BYTES) {
+            buffer[size++] = (value shr (i * 8)).toByte()
+        }
+    }
+
+    fun writeString(value: String) {
+        val bytes = value.encodeToByteArray()
+        writeInt(bytes.size)
+        writeBytes(bytes)
+    }
+
+    /**
+     * Writes a primitive value or string. Integral values and chars are all written as longs, as
+     * this is how they are stored in the realm.
+     */
+    fun writeValue(value: Any?) {
+        when (value) {
+            null -> writeByte(TAG_NULL)
+            is Byte -> writeIntValue(value.toLong())
+            is Char -> writeIntValue(value.code.toLong())
+            is Short -> writeIntValue(value.toLong())
+            is Int -> writeIntValue(value.toLong())
+            is Long -> writeIntValue(value)
+            is Boolean -> {
+                writeByte(TAG_BOOLEAN)
+                writeByte(if (value) 1 else 0)
+            }
+            is Float -> {
+                writeByte(TAG_FLOAT)
+                writeInt(value.toRawBits())
+            }
+            is Double -> {
+                writeByte(TAG_DOUBLE)
+                writeLong(value.toRawBits())
+            }
+            is String -> {
+                writeByte(TAG_STRING)
+                writeString(value)
+            }
+            else -> throw IllegalArgumentException("Unsupported type for backup journals: ${value::class.simpleName}")
+        }
+    }
+
+    fun writeObjectReference(className: String, objectKey: Long, primaryKey: Any?) {
+        writeByte(TAG_OBJECT)
+        writeString(className)
+        writeLong(objectKey)
+        writeValue(primaryKey)
+    }
+
+    /**
+     * Writes a list of [size] elements, which must be written by [elements].
+     */
+    inline fun writeList(size: Int, elements: () -> Unit) {
+        writeByte(TAG_LIST)
+        writeInt(size)
+        elements()
+    }
+
+    fun toByteArray(): ByteArray = buffer.copyOf(size)
+
+    private fun writeIntValue(value: Long) {
+        writeByte(TAG_INT)
+        writeLong(value)
+    }
+
+    private fun ensureCapacity(additional: Int) {
+        if (size + additional > buffer.size) {
+            buffer = buffer.copyOf(maxOf(buffer.size * 2, size + additional))
+        }
+    }
+
+    private companion object {
+        const val INITIAL_CAPACITY = 256
+    }
+}
+
+/**
+ * Reader for the values written by [JournalEncoder].
+ */
+internal class JournalDecoder(private val buffer: ByteArray, private var position: Int = 0) {
+
+    fun remaining(): Int = buffer.size - position
+
+    fun readByte(): Byte = buffer[position++]
+
+    fun readInt(): Int {
+        var value = 0
+        for (i in 0 until Int.SIZE_BYTES) {
+            value = value or ((buffer[position++].toInt() and 0xff) shl (i * 8))
+        }
+        return value
+    }
+
+    fun readLong(): Long {
+        var value = 0L
+        for (i in 0 until Long.SIZE_BYTES) {
+            value = value or ((buffer[position++].toLong() and 0xff) shl (i * 8))
+        }
+        return value
+    }
+
+    fun readString(): String {
+        val length = readInt()
+        return buffer.decodeToString(position, position + length).also { position += length }
+    }
+
+    /**
+     * Reads a value. Lists are returned as [List]s and object references are resolved with
+     * [resolveReference].
+     */
+    fun readValue(
+        resolveReference: (className: String, objectKey: Long, primaryKey: Any?) -> Any? = { _, _, _ ->
+            throw IllegalArgumentException("Unexpected object reference in backup journal")
+        }
+    ): Any? {
+        return when (val tag = readByte()) {
+            TAG_NULL -> null
+            TAG_INT -> readLong()
+            TAG_BOOLEAN -> readByte() != 0.toByte()
+            TAG_FLOAT -> Float.fromBits(readInt())
+            TAG_DOUBLE -> Double.fromBits(readLong())
+            TAG_STRING -> readString()
+            TAG_OBJECT -> resolveReference(readString(), readLong(), readValue())
+            TAG_LIST -> List(readInt()) { readValue(resolveReference) }
+            else -> throw IllegalArgumentException("Corrupt backup journal: unknown value tag $tag")
+        }
+    }
+}
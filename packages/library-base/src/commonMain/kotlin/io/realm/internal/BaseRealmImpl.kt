@@ -20,10 +20,18 @@ import io.realm.Callback
 import io.realm.Cancellable
 import io.realm.RealmObject
 import io.realm.RealmResults
+import io.realm.internal.interop.ColumnKey
 import io.realm.internal.interop.NativePointer
+import io.realm.internal.interop.RealmCoreException
 import io.realm.internal.interop.RealmInterop
+import io.realm.internal.interop.WriteCopySink
+import io.realm.internal.platform.monotonicTimeNanos
+import kotlinx.atomicfu.AtomicRef
+import kotlinx.atomicfu.atomic
+import kotlinx.atomicfu.update
 import kotlinx.coroutines.flow.Flow
 import kotlin.reflect.KClass
+import kotlin.time.Duration.Companion.nanoseconds
 
 @Suppress("UnnecessaryAbstractClass")
 abstract class BaseRealmImpl internal constructor(
@@ -58,6 +66,15 @@ abstract class BaseRealmImpl internal constructor(
 
     internal val log: RealmLog = RealmLog(configuration = configuration.log)
 
+    // Column keys do not change while the realm is open, so cache them per table and column to
+    // avoid resolving them through the C-API on every property access.
+    // https://github.com/realm/realm-kotlin/issues/105
+    private val columnKeys: AtomicRef<Map<String, Map<String, ColumnKey>>> = atomic(emptyMap())
+
+    // Tracks whether the realm has been closed without calling into native, so cached values of
+    // frozen objects can be returned without querying the state of the underlying realm.
+    private val closed = atomic(false)
+
     init {
         log.info("Realm opened: ${configuration.path}")
     }
@@ -66,16 +83,38 @@ abstract class BaseRealmImpl internal constructor(
         // Use same reference through out all operations to avoid locking
         val realmReference = this.realmReference
         realmReference.checkClosed()
-        return RealmResultsImpl.fromQuery(
-            realmReference,
-            RealmInterop.realm_query_parse(
-                realmReference.dbPointer,
-                clazz.simpleName!!,
-                "TRUEPREDICATE"
-            ),
-            clazz,
-            configuration.mediator
-        )
+        val className = clazz.simpleName!!
+        return instrumentQuery(className, "TRUEPREDICATE") {
+            RealmResultsImpl.fromQuery(
+                realmReference,
+                RealmInterop.realm_query_parse(
+                    realmReference.dbPointer,
+                    className,
+                    "TRUEPREDICATE"
+                ),
+                clazz,
+                configuration.mediator
+            )
+        }
+    }
+
+    // Reports queries exceeding the configured slow query threshold. Results are otherwise only
+    // evaluated when accessed, so they are evaluated up front to include the evaluation in the
+    // measurement and to report the number of matches.
+    internal inline fun <T : RealmObject> instrumentQuery(
+        className: String,
+        query: String,
+        block: () -> RealmResultsImpl<T>
+    ): RealmResultsImpl<T> {
+        val threshold = configuration.slowQueryThreshold ?: return block()
+        val start = monotonicTimeNanos()
+        val results = block()
+        val count = results.size
+        val elapsed = (monotonicTimeNanos() - start).nanoseconds
+        if (elapsed > threshold) {
+            log.warn("Slow query on '$className' took ${elapsed.inWholeMilliseconds} ms and matched $count objects: `$query`")
+        }
+        return results
     }
 
     internal open fun <T> registerObserver(t: Observable<T>): Flow<T> {
@@ -103,16 +142,82 @@ abstract class BaseRealmImpl internal constructor(
         throw NotImplementedError(OBSERVABLE_NOT_SUPPORTED_MESSAGE)
     }
 
+    internal fun isClosedCached(): Boolean = closed.value
+
+    /**
+     * Returns the column key of the property [column] of the class [table], resolving it through
+     * [reference] if it has not been resolved before.
+     */
+    internal fun columnKey(reference: RealmReference, table: String, column: String): ColumnKey {
+        columnKeys.value[table]?.get(column)?.let { return it }
+        val key = RealmInterop.realm_get_col_key(reference.dbPointer, table, column)
+        columnKeys.update { keys ->
+            keys + (table to ((keys[table] ?: emptyMap()) + (column to key)))
+        }
+        return key
+    }
+
     override fun getNumberOfActiveVersions(): Long {
         val reference = realmReference
         reference.checkClosed()
         return RealmInterop.realm_get_num_versions(reference.dbPointer)
     }
 
+    // Copying packed object graphs is only available through JNI, so the graph is written by the
+    // JVM only extensions through the passed functions
+    internal fun <T : RealmObject> copyFromRealm(
+        obj: T,
+        depth: Int,
+        copyPacked: (obj: NativePointer, maxDepth: Long, sink: WriteCopySink) -> Unit
+    ): T {
+        require(depth >= 0) { "Depth must not be negative: $depth" }
+        val internalObject = obj as RealmObjectInternal
+        require(internalObject.`$realm$IsManaged`) { "Only managed objects can be copied from Realm" }
+        val reference = internalObject.`$realm$Owner`!!
+        reference.checkClosed()
+        internalObject.checkValid()
+        @Suppress("UNCHECKED_CAST")
+        return copyPackedGraph(reference) { sink ->
+            copyPacked(internalObject.`$realm$ObjectPointer`!!, depth.toLong(), sink)
+        }.single() as T
+    }
+
+    internal fun <T : RealmObject> copyFromRealm(
+        results: RealmResults<T>,
+        depth: Int,
+        copyPacked: (results: NativePointer, maxDepth: Long, sink: WriteCopySink) -> Unit
+    ): List<T> {
+        require(depth >= 0) { "Depth must not be negative: $depth" }
+        val resultsImpl = results as RealmResultsImpl<T>
+        val reference = resultsImpl.realm
+        reference.checkClosed()
+        @Suppress("UNCHECKED_CAST")
+        return copyPackedGraph(reference) { sink ->
+            copyPacked(resultsImpl.result, depth.toLong(), sink)
+        } as List<T>
+    }
+
+    private inline fun copyPackedGraph(
+        reference: RealmReference,
+        write: (WriteCopySink) -> Unit
+    ): List<RealmObjectInternal> {
+        val start = monotonicTimeNanos()
+        val graph = try {
+            readPacked(write)
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Could not copy objects from Realm", exception)
+        }
+        val copies = PackedGraphDecoder(configuration.mediator, reference, configuration.schema).decode(graph)
+        val elapsed = (monotonicTimeNanos() - start).nanoseconds
+        log.debug("Copied ${copies.size} objects (${graph.size} bytes) from version ${reference.version()} of ${configuration.path} in ${elapsed.inWholeMilliseconds} ms")
+        return copies
+    }
+
     // Not all sub classes of `BaseRealm` can be closed by users.
     internal open fun close() {
         val reference = realmReference
         reference.checkClosed()
+        closed.value = true
         RealmInterop.realm_close(reference.dbPointer)
         log.info("Realm closed: ${configuration.path}")
     }
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.ChangeLogEntry
+import io.realm.ObjectChange
+import io.realm.ObjectReference
+import io.realm.internal.platform.fileExists
+import io.realm.internal.platform.readFile
+
+/*
+ * A change log has the same layout as a backup journal, but starts with the magic "RLMC". Records
+ * are appended without syncing the file to disk, as consumers tailing the log read the appended
+ * records from the page cache and a commit already syncs the realm file.
+ *
+ * Each record starts with its kind and the first version it covers. Change records continue with
+ * a record encoded with [ChangeRecorder.encode], gap records with the last version they cover.
+ */
+
+private val CHANGE_LOG_MAGIC = byteArrayOf('R'.code.toByte(), 'L'.code.toByte(), 'M'.code.toByte(), 'C'.code.toByte())
+private const val CHANGE_LOG_FORMAT_VERSION = 2
+
+private const val CHANGES_RECORD = 0
+private const val GAP_RECORD = 1
+
+/**
+ * Appends a record encoded with [ChangeRecorder.encode] to the change log at [path], starting a new
+ * change log if none exists. The record covers the versions from [firstVersion] up to the version
+ * of the record, as versions committed by empty transactions do not get a record of their own.
+ */
+internal fun appendChangeLog(path: String, firstVersion: Long, record: ByteArray) {
+    val encoder = JournalEncoder()
+    encoder.writeInt(CHANGES_RECORD)
+    encoder.writeLong(firstVersion)
+    encoder.writeBytes(record)
+    appendRecord(path, CHANGE_LOG_MAGIC, CHANGE_LOG_FORMAT_VERSION, encoder.toByteArray(), sync = false)
+}
+
+/**
+ * Appends a record to the change log at [path] marking that the changes of the versions from
+ * [firstVersion] to [lastVersion] are missing from the log.
+ */
+internal fun appendChangeLogGap(path: String, firstVersion: Long, lastVersion: Long) {
+    val encoder = JournalEncoder()
+    encoder.writeInt(GAP_RECORD)
+    encoder.writeLong(firstVersion)
+    encoder.writeLong(lastVersion)
+    appendRecord(path, CHANGE_LOG_MAGIC, CHANGE_LOG_FORMAT_VERSION, encoder.toByteArray(), sync = false)
+}
+
+internal fun readChangeLog(path: String, offset: Long, maxBytes: Int): List<ChangeLogEntry> {
+    if (!fileExists(path)) {
+        return emptyList()
+    }
+    checkRecordFileHeader(
+        readFile(path, 0, RECORD_FILE_HEADER_SIZE),
+        CHANGE_LOG_MAGIC,
+        CHANGE_LOG_FORMAT_VERSION,
+        "change log",
+        path
+    )
+    var chunk = readFile(path, offset, maxBytes)
+    // Read the first record in full if it is larger than maxBytes
+    if (chunk.size == maxBytes && chunk.size >= Int.SIZE_BYTES) {
+        val recordSize = Int.SIZE_BYTES + JournalDecoder(chunk).readInt()
+        if (recordSize > chunk.size) {
+            chunk = readFile(path, offset, recordSize)
+        }
+    }
+    val entries = mutableListOf<ChangeLogEntry>()
+    val decoder = JournalDecoder(chunk)
+    var position = offset
+    while (decoder.remaining() >= Int.SIZE_BYTES) {
+        val length = decoder.readInt()
+        if (length > decoder.remaining()) {
+            break
+        }
+        val nextPosition = position + Int.SIZE_BYTES + length
+        entries.add(decodeEntry(decoder, position, nextPosition))
+        position = nextPosition
+    }
+    return entries
+}
+
+private fun decodeEntry(decoder: JournalDecoder, offset: Long, nextOffset: Long): ChangeLogEntry {
+    val kind = decoder.readInt()
+    val firstVersion = decoder.readLong()
+    if (kind == GAP_RECORD) {
+        return ChangeLogEntry(ChangeLogEntry.Type.GAP, firstVersion, decoder.readLong(), emptyList(), offset, nextOffset)
+    }
+    val version = decoder.readLong()
+    val changes = mutableListOf<ObjectChange>()
+    repeat(decoder.readInt()) {
+        changes.add(
+            ObjectChange(
+                ObjectChange.Type.DELETED,
+                decoder.readString(),
+                decoder.readLong(),
+                decoder.readValue(),
+                emptyMap()
+            )
+        )
+    }
+    for (type in listOf(ObjectChange.Type.INSERTED, ObjectChange.Type.MODIFIED)) {
+        repeat(decoder.readInt()) {
+            val className = decoder.readString()
+            val objectKey = decoder.readLong()
+            val primaryKey = decoder.readValue()
+            val values = LinkedHashMap<String, Any?>()
+            repeat(decoder.readInt()) {
+                values[decoder.readString()] = decoder.readValue(::ObjectReference)
+            }
+            changes.add(ObjectChange(type, className, objectKey, primaryKey, values))
+        }
+    }
+    return ChangeLogEntry(ChangeLogEntry.Type.CHANGES, firstVersion, version, changes, offset, nextOffset)
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.RealmList
+import io.realm.RealmObject
+import io.realm.internal.interop.Link
+import io.realm.internal.interop.RealmInterop
+import kotlin.reflect.KClass
+import kotlin.reflect.KMutableProperty1
+
+/**
+ * Identifies an object of a version of a realm by its class and object key.
+ */
+internal data class ObjectIdentity(val className: String, val tableKey: Long, val objectKey: Long)
+
+/**
+ * Records the objects inserted, modified and deleted by a write transaction, so the transaction can
+ * be appended to the backup journal and the change log once it is committed.
+ *
+ * Only the identities of the objects and the names of the modified properties are recorded while
+ * the transaction runs. The values are read when the record is encoded, so a property that is
+ * modified multiple times is only recorded once, with its final value.
+ *
+ * Records are encoded as:
+ *
+ *     version of the realm committed by the transaction: long
+ *     number of deleted objects: int
+ *     per deleted object: class name: string, object key: long, primary key: value
+ *     number of inserted objects: int
+ *     per inserted object: object, with all properties
+ *     number of modified objects: int
+ *     per modified object: object, with the modified properties
+ *
+ * where objects are encoded as class name: string, object key: long, primary key: value, number of
+ * properties: int, per property: property name: string, value: value. The primary key is never
+ * part of the properties and is a null value for classes without a primary key. See
+ * [JournalEncoder] for the encoding of values.
+ *
+ * Must only be accessed from the writer thread.
+ */
+internal class ChangeRecorder(private val mediator: Mediator, schema: Set<KClass<out RealmObject>>) {
+
+    private val classes: Map<String, KClass<out RealmObject>> = schema.associateBy { it.simpleName!! }
+    private val inserted: MutableSet<ObjectIdentity> = LinkedHashSet()
+    private val modified: MutableMap<ObjectIdentity, MutableSet<String>> = LinkedHashMap()
+    // Primary keys of deleted objects, which cannot be read after the objects are deleted
+    private val deleted: MutableMap<ObjectIdentity, Any?> = LinkedHashMap()
+
+    fun isEmpty(): Boolean = inserted.isEmpty() && modified.isEmpty() && deleted.isEmpty()
+
+    fun clear() {
+        inserted.clear()
+        modified.clear()
+        deleted.clear()
+    }
+
+    fun inserted(obj: RealmObjectInternal) {
+        inserted.add(identityOf(obj))
+    }
+
+    fun modified(obj: RealmObjectInternal, property: String) {
+        val identity = identityOf(obj)
+        // All properties of inserted objects are recorded anyway
+        if (identity !in inserted) {
+            modified.getOrPut(identity) { mutableSetOf() }.add(property)
+        }
+    }
+
+    fun deleted(obj: RealmObjectInternal) {
+        val identity = identityOf(obj)
+        modified.remove(identity)
+        // Objects inserted and deleted in the same transaction leave no trace
+        if (!inserted.remove(identity)) {
+            deleted[identity] = primaryKeyOf(obj)
+        }
+    }
+
+    /**
+     * Encodes the recorded changes as a record. Must be called with the realm at the version
+     * committed by the recorded transaction.
+     */
+    fun encode(realm: RealmReference, version: Long): ByteArray {
+        val encoder = JournalEncoder()
+        encoder.writeLong(version)
+        encoder.writeInt(deleted.size)
+        for ((identity, primaryKey) in deleted) {
+            encoder.writeString(identity.className)
+            encoder.writeLong(identity.objectKey)
+            encoder.writeValue(primaryKey)
+        }
+        encoder.writeInt(inserted.size)
+        for (identity in inserted) {
+            encodeObject(encoder, identity, resolve(realm, identity), null)
+        }
+        encoder.writeInt(modified.size)
+        for ((identity, properties) in modified) {
+            encodeObject(encoder, identity, resolve(realm, identity), properties)
+        }
+        return encoder.toByteArray()
+    }
+
+    private fun encodeObject(
+        encoder: JournalEncoder,
+        identity: ObjectIdentity,
+        obj: RealmObjectInternal,
+        properties: Set<String>?
+    ) {
+        val companion = mediator.companionOf(obj::class)
+        val primaryKeyName = companion.`$realm$primaryKey`?.name
+        @Suppress("UNCHECKED_CAST")
+        val fields = (companion.`$realm$fields` as List<KMutableProperty1<RealmObjectInternal, Any?>>? ?: emptyList())
+            .filter { it.name != primaryKeyName && (properties == null || it.name in properties) }
+        encoder.writeString(identity.className)
+        encoder.writeLong(identity.objectKey)
+        encoder.writeValue(primaryKeyOf(obj))
+        encoder.writeInt(fields.size)
+        for (field in fields) {
+            encoder.writeString(field.name)
+            when (val value = field.get(obj)) {
+                is RealmList<*> -> encoder.writeList(value.size) { value.forEach { encodeValue(encoder, it) } }
+                else -> encodeValue(encoder, value)
+            }
+        }
+    }
+
+    private fun encodeValue(encoder: JournalEncoder, value: Any?) {
+        if (value is RealmObjectInternal) {
+            val identity = identityOf(value)
+            encoder.writeObjectReference(identity.className, identity.objectKey, primaryKeyOf(value))
+        } else {
+            encoder.writeValue(value)
+        }
+    }
+
+    // Objects inserted or modified and then deleted in the same transaction are no longer
+    // recorded as such, so all recorded objects can be resolved
+    private fun resolve(realm: RealmReference, identity: ObjectIdentity): RealmObjectInternal {
+        val clazz = classes[identity.className] ?: error("Class '${identity.className}' is not part of the schema")
+        val pointer = RealmInterop.realm_get_object(realm.dbPointer, Link(identity.tableKey, identity.objectKey))
+        return mediator.createInstanceOf(clazz).manage(realm, mediator, clazz, pointer)
+    }
+
+    private fun identityOf(obj: RealmObjectInternal): ObjectIdentity {
+        val link = RealmInterop.realm_object_as_link(obj.`$realm$ObjectPointer`!!)
+        return ObjectIdentity(obj.`$realm$TableName`!!, link.tableKey, link.objKey)
+    }
+
+    private fun primaryKeyOf(obj: RealmObjectInternal): Any? {
+        @Suppress("UNCHECKED_CAST")
+        val primaryKey = mediator.companionOf(obj::class).`$realm$primaryKey` as KMutableProperty1<RealmObjectInternal, Any?>?
+        return primaryKey?.get(obj)
+    }
+}
+
+/**
+ * Records a change to an object of this realm if it belongs to a write transaction that is
+ * recorded in a backup journal or change log.
+ */
+internal inline fun RealmReference.recordChange(block: ChangeRecorder.() -> Unit) {
+    (owner as? MutableRealmImpl)?.changeRecorder?.block()
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.CommitStatistics
+import io.realm.internal.interop.RealmInterop
+import kotlinx.atomicfu.AtomicLongArray
+import kotlinx.atomicfu.atomic
+import kotlinx.atomicfu.update
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.milliseconds
+import kotlin.time.Duration.Companion.nanoseconds
+
+/**
+ * Collects the commit statistics of the write transactions of the realm at [path].
+ *
+ * Statistics are only recorded by the writer, but can be read from any thread, so all counters are
+ * atomic. Snapshots are not guaranteed to be consistent across counters while a transaction is
+ * being recorded. The size of the realm file is only read when a snapshot is taken, so commits
+ * don't pay for it.
+ */
+internal class CommitStatisticsCollector(private val path: String) {
+
+    private val commits = atomic(0L)
+    private val commitNanos = atomic(0L)
+    private val maxCommitNanos = atomic(0L)
+    private val transactionNanos = atomic(0L)
+    // One bucket per upper bound and one for commits exceeding all of them
+    private val commitHistogram = AtomicLongArray(HISTOGRAM_UPPER_BOUNDS_NANOS.size + 1)
+
+    fun recordCommit(elapsedNanos: Long) {
+        commits.incrementAndGet()
+        commitNanos.addAndGet(elapsedNanos)
+        maxCommitNanos.update { maxOf(it, elapsedNanos) }
+        val bucket = HISTOGRAM_UPPER_BOUNDS_NANOS.indexOfFirst { elapsedNanos <= it }
+            .let { if (it == -1) HISTOGRAM_UPPER_BOUNDS_NANOS.size else it }
+        commitHistogram[bucket].incrementAndGet()
+    }
+
+    fun recordTransaction(elapsedNanos: Long) {
+        transactionNanos.addAndGet(elapsedNanos)
+    }
+
+    fun snapshot(): CommitStatistics {
+        val histogram = LinkedHashMap<Duration, Long>()
+        HISTOGRAM_UPPER_BOUNDS_NANOS.forEachIndexed { i, bound ->
+            histogram[bound.nanoseconds] = commitHistogram[i].value
+        }
+        histogram[Duration.INFINITE] = commitHistogram[HISTOGRAM_UPPER_BOUNDS_NANOS.size].value
+        return CommitStatistics(
+            commits = commits.value,
+            commitTime = commitNanos.value.nanoseconds,
+            maxCommitTime = maxCommitNanos.value.nanoseconds,
+            commitTimeHistogram = histogram,
+            transactionTime = transactionNanos.value.nanoseconds,
+            fileSize = RealmInterop.realm_get_file_size(path)
+        )
+    }
+
+    private companion object {
+        // Exponential buckets from 1 ms to ~1 s, covering commits without a sync to disk up to
+        // commits stalled on slow storage
+        val HISTOGRAM_UPPER_BOUNDS_NANOS: List<Long> =
+            (0..10).map { (1L shl it).milliseconds.inWholeNanoseconds }
+    }
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.RealmList
+import io.realm.RealmObject
+import io.realm.internal.interop.ColumnKey
+import io.realm.internal.interop.NativePointer
+import io.realm.internal.interop.RealmCoreException
+import io.realm.internal.interop.RealmInterop
+import io.realm.isManaged
+import io.realm.isValid
+import kotlin.reflect.KClass
+import kotlin.reflect.KProperty1
+
+/**
+ * Snapshot of the property values of an unmanaged object that can be inserted into a realm without
+ * accessing the original object.
+ *
+ * Encoding an object reads all its properties and resolves the object graph reachable from it, so
+ * this can be done on any thread, while [applyEncodedObjects] only has to create the objects and
+ * write the values on the writer thread.
+ *
+ * [values] are ordered as the `$realm$fields` of the class' companion and each value is either:
+ * - `null` for properties that should keep their default value,
+ * - a primitive value or [String],
+ * - another [EncodedObject] for unmanaged objects referenced from this object,
+ * - a managed [RealmObjectInternal] for managed objects referenced from this object,
+ * - an [EncodedList] for non-empty lists.
+ */
+internal class EncodedObject(
+    val clazz: KClass<out RealmObject>,
+    val primaryKey: Any?,
+    val values: Array<Any?>
+)
+
+/**
+ * Snapshot of the elements of a list property. Elements follow the same conventions as
+ * [EncodedObject.values].
+ */
+internal class EncodedList(val elements: Array<Any?>)
+
+/**
+ * Encode an object and the graph of unmanaged objects reachable from it.
+ *
+ * The graph is traversed iteratively and unmanaged objects referenced multiple times, including
+ * cyclic references, are only encoded once.
+ *
+ * @return the encoded object or `null` if [element] is already managed and thus does not have to
+ * be copied.
+ * @throws IllegalStateException if [element] is an invalid managed object.
+ */
+internal fun encodeObject(mediator: Mediator, element: RealmObject): EncodedObject? {
+    if (!element.isValid()) {
+        throw IllegalStateException("Cannot copy an invalid managed object to Realm.")
+    }
+    if (element.isManaged()) {
+        return null
+    }
+    val cache: MutableMap<RealmObjectInternal, EncodedObject> = mutableMapOf()
+    val pending: MutableList<Pair<RealmObjectInternal, EncodedObject>> = mutableListOf()
+
+    fun encodedReference(obj: RealmObjectInternal): EncodedObject =
+        cache.getOrPut(obj) {
+            val companion = mediator.companionOf(obj::class)
+            @Suppress("UNCHECKED_CAST")
+            val primaryKey = (companion.`$realm$primaryKey` as KProperty1<RealmObjectInternal, Any?>?)?.get(obj)
+            val size = companion.`$realm$fields`?.size ?: 0
+            EncodedObject(obj::class, primaryKey, arrayOfNulls(size)).also {
+                pending.add(obj to it)
+            }
+        }
+
+    fun encodedValue(value: Any?): Any? =
+        if (value is RealmObjectInternal && !value.`$realm$IsManaged`) {
+            encodedReference(value)
+        } else {
+            value
+        }
+
+    val root = encodedReference(element as RealmObjectInternal)
+    while (pending.isNotEmpty()) {
+        val (obj, encoded) = pending.removeAt(pending.lastIndex)
+        // Properties are read through the getters called by the compiler generated copy method
+        val values = mediator.companionOf(obj::class).`$realm$copyToRealm`(obj)
+        values.forEachIndexed { index, value ->
+            encoded.values[index] = when (value) {
+                is RealmList<*> ->
+                    if (value.isEmpty()) null else EncodedList(Array(value.size) { encodedValue(value[it]) })
+                else -> encodedValue(value)
+            }
+        }
+    }
+    return root
+}
+
+/**
+ * Insert encoded objects into the realm of the given mutable realm reference.
+ *
+ * Must be called inside a write transaction.
+ */
+internal fun applyEncodedObjects(
+    mediator: Mediator,
+    realm: RealmReference,
+    objects: List<EncodedObject>
+) {
+    val writer = EncodedObjectWriter(mediator, realm)
+    for (encoded in objects) {
+        writer.insert(encoded)
+    }
+}
+
+/**
+ * Writer inserting [EncodedObject]s into the realm of a mutable realm reference.
+ *
+ * An object is created when it is first referenced, i.e. the root before anything is written and
+ * any other object while the values of the first object referencing it are written. Its own values
+ * are written after that, so links to objects, including cyclic references, always resolve to
+ * objects that already exist. Column keys are resolved once per class for the lifetime of the
+ * writer.
+ */
+internal class EncodedObjectWriter(private val mediator: Mediator, private val realm: RealmReference) {
+
+    private val columnKeys: MutableMap<KClass<*>, Array<ColumnKey>> = mutableMapOf()
+
+    /**
+     * Insert an encoded object and the graph of encoded objects reachable from it.
+     *
+     * @return the managed counterpart of [root].
+     */
+    fun insert(root: EncodedObject): RealmObjectInternal {
+        val created: MutableMap<EncodedObject, RealmObjectInternal> = mutableMapOf()
+        val pending: MutableList<EncodedObject> = mutableListOf()
+
+        fun managedReference(encoded: EncodedObject): RealmObjectInternal =
+            created.getOrPut(encoded) {
+                val companion = mediator.companionOf(encoded.clazz)
+                val managed = if (companion.`$realm$primaryKey` != null) {
+                    create(mediator, realm, encoded.clazz, encoded.primaryKey)
+                } else {
+                    create(mediator, realm, encoded.clazz)
+                }
+                pending.add(encoded)
+                managed as RealmObjectInternal
+            }
+
+        fun managedValue(value: Any?): Any? =
+            if (value is EncodedObject) managedReference(value) else value
+
+        val managedRoot = managedReference(root)
+        while (pending.isNotEmpty()) {
+            val encoded = pending.removeAt(pending.lastIndex)
+            write(created[encoded]!!.`$realm$ObjectPointer`!!, encoded, ::managedValue)
+        }
+        return managedRoot
+    }
+
+    private fun write(target: NativePointer, encoded: EncodedObject, managedValue: (Any?) -> Any?) {
+        val companion = mediator.companionOf(encoded.clazz)
+        val keys = columnKeys.getOrPut(encoded.clazz) { resolveColumnKeys(encoded.clazz) }
+        val primaryKeyName = companion.`$realm$primaryKey`?.name
+        val fields = companion.`$realm$fields`!!
+        // TODO OPTIMIZE We could set all properties at once with one C-API call
+        try {
+            encoded.values.forEachIndexed { index, value ->
+                when {
+                    value == null -> Unit
+                    // Primary key is already set when creating the object
+                    fields[index].name == primaryKeyName -> Unit
+                    value is EncodedList -> {
+                        val list = RealmInterop.realm_get_list(target, keys[index])
+                        value.elements.forEachIndexed { position, element ->
+                            RealmInterop.realm_list_add(list, position.toLong(), managedValue(element))
+                        }
+                    }
+                    // TODO OPTIMIZE Should we do a separate setter that allows the isDefault flag for sync
+                    //  optimizations
+                    else -> RealmInterop.realm_set_value(target, keys[index], managedValue(value), false)
+                }
+            }
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler(
+                "Cannot copy object of type '${encoded.clazz.simpleName}' to Realm",
+                exception
+            )
+        }
+    }
+
+    private fun resolveColumnKeys(clazz: KClass<out RealmObject>): Array<ColumnKey> {
+        val className = clazz.simpleName ?: error("Cannot get class name")
+        val fields = mediator.companionOf(clazz).`$realm$fields` ?: emptyList()
+        return Array(fields.size) { realm.owner.columnKey(realm, className, fields[it].name) }
+    }
+}
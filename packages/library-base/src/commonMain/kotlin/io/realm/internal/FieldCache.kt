@@ -0,0 +1,58 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.internal.platform.freeze
+import kotlinx.atomicfu.AtomicRef
+import kotlinx.atomicfu.atomic
+import kotlinx.atomicfu.update
+
+/**
+ * Cache of the property values of a frozen object.
+ *
+ * Frozen objects never change, so values read from the underlying object can be stored on first
+ * access and returned directly on subsequent reads. The cache is referenced from the
+ * `$realm$FieldCache` property added to all model classes by the compiler plugin, but is only
+ * attached to objects of frozen realms.
+ *
+ * Frozen objects can be shared across threads, so values are kept in an immutable map that is
+ * replaced atomically when new values are added.
+ */
+class FieldCache internal constructor() {
+
+    private val values: AtomicRef<Map<String, Any?>> = atomic(emptyMap())
+
+    /**
+     * Returns the cached value of the property [col] or [NOT_CACHED] if it has not been read yet.
+     */
+    internal fun get(col: String): Any? {
+        val cached = values.value
+        return if (cached.containsKey(col)) cached[col] else NOT_CACHED
+    }
+
+    internal fun put(col: String, value: Any?) {
+        values.update { (it + (col to value)).freeze() }
+    }
+
+    internal companion object {
+        /**
+         * Marker returned from [get] for properties that have not been cached. Needed to
+         * distinguish properties that are not cached from properties with a `null` value.
+         */
+        internal val NOT_CACHED = Any()
+    }
+}
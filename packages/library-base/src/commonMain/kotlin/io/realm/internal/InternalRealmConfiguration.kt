@@ -33,4 +33,5 @@ interface InternalRealmConfiguration : RealmConfiguration {
     val nativeConfig: NativePointer
     val notificationDispatcher: CoroutineDispatcher
     val writeDispatcher: CoroutineDispatcher
+    val migrationCallback: SchemaMigrationCallback?
 }
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.internal.interop.ClassKey
+import io.realm.internal.interop.NativePointer
+
+/**
+ * Source of newline delimited JSON objects that are imported natively into a realm by
+ * [SuspendableWriter.importJson].
+ *
+ * JSON is parsed and inserted through core objects that are not exposed by the C-API, so importers
+ * are only implemented on JVM.
+ */
+internal interface JsonImporter {
+
+    /**
+     * Number of bytes of JSON consumed so far.
+     */
+    val bytesRead: Long
+
+    /**
+     * Imports at most [maxObjects] objects of the class identified by [classKey] into [realm], which
+     * must be in a write transaction.
+     *
+     * @return the number of imported objects, which is 0 when all objects have been imported.
+     */
+    fun importBatch(realm: NativePointer, classKey: ClassKey, maxObjects: Long): Long
+}
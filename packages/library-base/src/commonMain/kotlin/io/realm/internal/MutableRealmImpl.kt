@@ -19,6 +19,9 @@ import io.realm.Callback
 import io.realm.Cancellable
 import io.realm.MutableRealm
 import io.realm.RealmObject
+import io.realm.internal.interop.ClassKey
+import io.realm.internal.interop.ColumnKey
+import io.realm.internal.interop.NativePointer
 import io.realm.internal.interop.RealmCoreException
 import io.realm.internal.interop.RealmInterop
 import io.realm.isFrozen
@@ -26,6 +29,7 @@ import io.realm.isManaged
 import io.realm.isValid
 import kotlinx.coroutines.CoroutineDispatcher
 import kotlinx.coroutines.flow.Flow
+import kotlin.reflect.KClass
 
 internal class MutableRealmImpl : BaseRealmImpl, MutableRealm {
 
@@ -35,6 +39,7 @@ internal class MutableRealmImpl : BaseRealmImpl, MutableRealm {
         internal fun <T : RealmObject> delete(obj: T) {
             val internalObject = obj as RealmObjectInternal
             checkObjectValid(internalObject)
+            internalObject.`$realm$Owner`?.recordChange { deleted(internalObject) }
             internalObject.`$realm$ObjectPointer`?.let { RealmInterop.realm_object_delete(it) }
         }
 
@@ -60,7 +65,13 @@ internal class MutableRealmImpl : BaseRealmImpl, MutableRealm {
         dispatcher: CoroutineDispatcher? = null
     ) : super(configuration, RealmInterop.realm_open(configuration.nativeConfig, dispatcher))
 
+    /**
+     * Records the changes of the current write transaction if it is appended to a backup journal.
+     */
+    internal var changeRecorder: ChangeRecorder? = null
+
     internal fun beginTransaction() {
+        changeRecorder?.clear()
         try {
             RealmInterop.realm_begin_write(realmReference.dbPointer)
         } catch (exception: RealmCoreException) {
@@ -107,13 +118,42 @@ internal class MutableRealmImpl : BaseRealmImpl, MutableRealm {
         return copyToRealm(configuration.mediator, realmReference, instance)
     }
 
+    /**
+     * Insert objects that have already been encoded with [encodeObject].
+     */
+    internal fun insertEncoded(objects: List<EncodedObject>) {
+        applyEncodedObjects(configuration.mediator, realmReference, objects)
+    }
+
     override fun <T : RealmObject> delete(obj: T) {
         // TODO It is easy to call this with a wrong object. Should we use `findLatest` behind the scenes?
         val internalObject = obj as RealmObjectInternal
         checkObjectValid(internalObject)
+        changeRecorder?.deleted(internalObject)
         internalObject.`$realm$ObjectPointer`?.let { RealmInterop.realm_object_delete(it) }
     }
 
+    // Runs a storage maintenance operation of the platform, like the JVM only extensions of
+    // MutableRealm, on a column
+    internal fun updateColumn(
+        clazz: KClass<*>,
+        property: String,
+        errorMessage: String,
+        update: (NativePointer, ClassKey, ColumnKey) -> Unit
+    ) {
+        val className = clazz.simpleName ?: error("Cannot get class name")
+        val dbPointer = realmReference.dbPointer
+        try {
+            update(
+                dbPointer,
+                RealmInterop.realm_find_class(dbPointer, className),
+                RealmInterop.realm_get_col_key(dbPointer, className, property)
+            )
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("$errorMessage '$className.$property'", exception)
+        }
+    }
+
     // FIXME Consider adding a delete-all along with query support
     //  https://github.com/realm/realm-kotlin/issues/64
     // fun <T : RealmModel> delete(clazz: KClass<T>)
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.RealmObject
+import io.realm.internal.interop.Link
+import io.realm.internal.interop.RealmInterop
+import io.realm.internal.interop.WriteCopySink
+import kotlin.reflect.KClass
+import kotlin.reflect.KMutableProperty1
+
+/*
+ * A packed graph is the serialized form of a graph of managed objects written natively in a single
+ * pass, so unmanaged copies can be created without reading each property through the C-API. It
+ * starts with the number of root objects and their object indices, followed by a record per class
+ * and object:
+ * - A class record is the byte [KIND_CLASS], the table key, the class name and the number of
+ *   columns followed by the column names.
+ * - An object record is the byte [KIND_OBJECT], the index of its class record, the object key and a
+ *   value per column of its class.
+ *
+ * Objects are indexed in the order of their records and values use the tags of backup journals,
+ * except that links are the class index and object index of the target as ints. Ints and longs are
+ * little-endian.
+ */
+
+private const val KIND_CLASS: Byte = 1
+private const val KIND_OBJECT: Byte = 2
+
+private const val INITIAL_PACKED_CAPACITY = 64 * 1024
+
+/**
+ * Collects the chunks of packed data, like packed graphs, written to the sink passed to [write].
+ */
+internal inline fun readPacked(write: (WriteCopySink) -> Unit): ByteArray {
+    var data = ByteArray(INITIAL_PACKED_CAPACITY)
+    var size = 0
+    write(object : WriteCopySink {
+        override fun write(buffer: ByteArray, length: Int) {
+            if (size + length > data.size) {
+                data = data.copyOf(maxOf(data.size * 2, size + length))
+            }
+            buffer.copyInto(data, size, 0, length)
+            size += length
+        }
+    })
+    return data.copyOf(size)
+}
+
+/**
+ * Decoder of packed graphs into unmanaged objects created through the generated companions of the
+ * classes, preserving the identity of objects reachable through multiple paths.
+ *
+ * Integral values are stored as longs, so the Kotlin type of integral properties and list elements
+ * is resolved once per property by reading the first object with a value through its managed
+ * accessor in [realm].
+ */
+internal class PackedGraphDecoder(
+    private val mediator: Mediator,
+    private val realm: RealmReference,
+    schema: Set<KClass<out RealmObject>>
+) {
+
+    private class ClassLayout(
+        val clazz: KClass<out RealmObject>,
+        val tableKey: Long,
+        val fields: Array<KMutableProperty1<RealmObjectInternal, Any?>?>
+    ) {
+        val integerTypes: Array<KClass<*>?> = arrayOfNulls(fields.size)
+    }
+
+    private val classes: Map<String, KClass<out RealmObject>> = schema.associateBy { it.simpleName!! }
+    private val layouts: MutableList<ClassLayout> = mutableListOf()
+    private val objects: MutableList<RealmObjectInternal?> = mutableListOf()
+
+    /**
+     * Decodes [graph] and returns the unmanaged copies of its root objects.
+     */
+    fun decode(graph: ByteArray): List<RealmObjectInternal> {
+        val decoder = JournalDecoder(graph)
+        val roots = IntArray(decoder.readInt()) { decoder.readInt() }
+        var index = 0
+        while (decoder.remaining() > 0) {
+            when (val kind = decoder.readByte()) {
+                KIND_CLASS -> layouts.add(readClass(decoder))
+                KIND_OBJECT -> readObject(decoder, index++)
+                else -> throw IllegalStateException("Corrupt object graph: unknown record $kind")
+            }
+        }
+        return roots.map { objects[it]!! }
+    }
+
+    private fun readClass(decoder: JournalDecoder): ClassLayout {
+        val tableKey = decoder.readLong()
+        val className = decoder.readString()
+        val clazz = classes[className] ?: throw IllegalStateException("Class '$className' is not part of the schema")
+        @Suppress("UNCHECKED_CAST")
+        val members = (mediator.companionOf(clazz).`$realm$fields` as List<KMutableProperty1<RealmObjectInternal, Any?>>?)
+            ?.associateBy { it.name } ?: emptyMap()
+        val fields = Array(decoder.readInt()) { members[decoder.readString()] }
+        return ClassLayout(clazz, tableKey, fields)
+    }
+
+    private fun readObject(decoder: JournalDecoder, index: Int) {
+        val layout = layouts[decoder.readInt()]
+        val objectKey = decoder.readLong()
+        val obj = instance(layout, index)
+        layout.fields.forEachIndexed { field, member ->
+            if (member != null) {
+                member.set(obj, readValue(decoder) { integerType(layout, field, objectKey) })
+            } else {
+                // Values of columns without a property in the model are skipped
+                readValue(decoder) { Long::class }
+            }
+        }
+    }
+
+    private fun readValue(decoder: JournalDecoder, integerType: () -> KClass<*>): Any? {
+        return when (val tag = decoder.readByte()) {
+            TAG_NULL -> null
+            TAG_INT -> convertInteger(decoder.readLong(), integerType())
+            TAG_BOOLEAN -> decoder.readByte() != 0.toByte()
+            TAG_FLOAT -> Float.fromBits(decoder.readInt())
+            TAG_DOUBLE -> Double.fromBits(decoder.readLong())
+            TAG_STRING -> decoder.readString()
+            TAG_OBJECT -> {
+                val layout = layouts[decoder.readInt()]
+                instance(layout, decoder.readInt())
+            }
+            TAG_LIST -> UnmanagedRealmList<Any?>().apply {
+                repeat(decoder.readInt()) { add(readValue(decoder, integerType)) }
+            }
+            else -> throw IllegalStateException("Corrupt object graph: unknown value tag $tag")
+        }
+    }
+
+    // Objects can be linked to before their record is read, so instances are created on first use
+    private fun instance(layout: ClassLayout, index: Int): RealmObjectInternal {
+        while (objects.size <= index) {
+            objects.add(null)
+        }
+        return objects[index] ?: mediator.createInstanceOf(layout.clazz).also { objects[index] = it }
+    }
+
+    private fun integerType(layout: ClassLayout, field: Int, objectKey: Long): KClass<*> =
+        layout.integerTypes[field] ?: run {
+            val managed = mediator.createInstanceOf(layout.clazz).manage(
+                realm,
+                mediator,
+                layout.clazz,
+                RealmInterop.realm_get_object(realm.dbPointer, Link(layout.tableKey, objectKey))
+            ) as RealmObjectInternal
+            when (val value = layout.fields[field]!!.get(managed)) {
+                is ManagedRealmList<*> -> value.metadata.clazz
+                else -> value!!::class
+            }
+        }.also { layout.integerTypes[field] = it }
+
+    private fun convertInteger(value: Long, type: KClass<*>): Any =
+        when (type) {
+            Byte::class -> value.toByte()
+            Char::class -> value.toChar()
+            Short::class -> value.toShort()
+            Int::class -> value.toInt()
+            else -> value
+        }
+}
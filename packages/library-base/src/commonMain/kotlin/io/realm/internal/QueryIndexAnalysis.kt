@@ -0,0 +1,95 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+// Matches `property == value` and `property = value`, optionally case insensitive, while rejecting
+// other operators like `!=`, `<=` and `>=` and key paths traversing links.
+private val PROPERTY_EQUALS = Regex("""^(?!(?:true|false|null)\b)([A-Za-z_][A-Za-z0-9_]*)\s*==?(\[c])?\s*[^=\s]""", RegexOption.IGNORE_CASE)
+// Matches `value == property` where value is an argument or a literal
+private val EQUALS_PROPERTY = Regex("""^(\$\d+|'[^']*'|"[^"]*"|[-\d.]+|true|false)\s*==?(\[c])?\s*([A-Za-z_][A-Za-z0-9_]*)$""", RegexOption.IGNORE_CASE)
+private val DESCRIPTORS = Regex("""\s+(SORT|DISTINCT|LIMIT)\s*\(.*$""", RegexOption.IGNORE_CASE)
+
+/**
+ * Returns the properties that [query] requires to be equal to a value in its top level
+ * conjunction, in order of appearance.
+ *
+ * This is the heuristic behind [io.realm.EstimatedIndexUsage]: conditions of this shape are the
+ * ones the query engine can most likely evaluate with a search index. If the top level of the
+ * query is a disjunction none of the conditions qualify. The query is expected to be valid, as it
+ * is only inspected after being parsed by core.
+ */
+internal fun equalityProperties(query: String): List<String> {
+    val conjuncts = splitTopLevel(query.replace(DESCRIPTORS, "")) ?: return emptyList()
+    return conjuncts.mapNotNull { conjunct ->
+        PROPERTY_EQUALS.find(conjunct)?.groupValues?.get(1)
+            ?: EQUALS_PROPERTY.find(conjunct)?.groupValues?.get(3)
+    }
+}
+
+/**
+ * Splits [query] at the `AND` operators outside of parentheses and string literals. Returns `null`
+ * if the query contains an `OR` at the top level.
+ */
+private fun splitTopLevel(query: String): List<String>? {
+    val conjuncts = mutableListOf<String>()
+    var depth = 0
+    var quote: Char? = null
+    var start = 0
+    var i = 0
+    while (i < query.length) {
+        val c = query[i]
+        when {
+            quote != null -> if (c == quote) quote = null
+            c == '\'' || c == '"' -> quote = c
+            c == '(' -> depth++
+            c == ')' -> depth--
+            depth == 0 -> {
+                val operator = operatorAt(query, i)
+                if (operator != null) {
+                    if (operator.isOr) {
+                        return null
+                    }
+                    conjuncts.add(query.substring(start, i).trim())
+                    i += operator.length
+                    start = i
+                    continue
+                }
+            }
+        }
+        i++
+    }
+    conjuncts.add(query.substring(start).trim())
+    return conjuncts
+}
+
+private class LogicalOperator(val length: Int, val isOr: Boolean)
+
+private fun operatorAt(query: String, index: Int): LogicalOperator? {
+    if (query.startsWith("&&", index)) return LogicalOperator(2, false)
+    if (query.startsWith("||", index)) return LogicalOperator(2, true)
+    // Word operators must be surrounded by whitespace or parentheses
+    if (index > 0 && !query[index - 1].isWhitespace() && query[index - 1] != ')') return null
+    for ((word, isOr) in listOf("AND" to false, "OR" to true)) {
+        if (query.startsWith(word, index, ignoreCase = true)) {
+            val end = index + word.length
+            if (end < query.length && (query[end].isWhitespace() || query[end] == '(')) {
+                return LogicalOperator(word.length, isOr)
+            }
+        }
+    }
+    return null
+}
@@ -18,12 +18,15 @@ package io.realm.internal
 
 import io.realm.LogConfiguration
 import io.realm.RealmObject
+import io.realm.SchemaMigration
 import io.realm.internal.interop.NativePointer
+import io.realm.internal.interop.RealmCoreException
 import io.realm.internal.interop.RealmInterop
 import io.realm.internal.interop.SchemaMode
 import io.realm.internal.platform.appFilesDirectory
 import kotlinx.coroutines.CoroutineDispatcher
 import kotlin.reflect.KClass
+import kotlin.time.Duration
 
 @Suppress("LongParameterList")
 open class RealmConfigurationImpl constructor(
@@ -38,6 +41,14 @@ open class RealmConfigurationImpl constructor(
     schemaVersion: Long,
     deleteRealmIfMigrationNeeded: Boolean,
     encryptionKey: ByteArray?,
+    inMemory: Boolean,
+    prefetchFile: Boolean,
+    collectCommitStatistics: Boolean,
+    slowQueryThreshold: Duration?,
+    longTransactionThreshold: Duration?,
+    backupJournalPath: String?,
+    changeLogPath: String?,
+    migration: SchemaMigrationSetup?,
 ) : InternalRealmConfiguration {
 
     override val path: String
@@ -56,6 +67,22 @@ open class RealmConfigurationImpl constructor(
 
     override val encryptionKey get(): ByteArray? = RealmInterop.realm_config_get_encryption_key(nativeConfig)
 
+    override val inMemory: Boolean
+
+    override val prefetchFile: Boolean
+
+    override val collectCommitStatistics: Boolean
+
+    override val slowQueryThreshold: Duration?
+
+    override val longTransactionThreshold: Duration?
+
+    override val backupJournalPath: String?
+
+    override val changeLogPath: String?
+
+    override val migration: SchemaMigration?
+
     override val mapOfKClassWithCompanion: Map<KClass<out RealmObject>, RealmObjectCompanion>
 
     override val mediator: Mediator
@@ -66,6 +93,8 @@ open class RealmConfigurationImpl constructor(
 
     override val writeDispatcher: CoroutineDispatcher
 
+    override val migrationCallback: SchemaMigrationCallback?
+
     init {
         this.path = if (path == null || path.isEmpty()) {
             val directory = appFilesDirectory()
@@ -82,6 +111,37 @@ open class RealmConfigurationImpl constructor(
         this.writeDispatcher = writeDispatcher
         this.schemaVersion = schemaVersion
         this.deleteRealmIfMigrationNeeded = deleteRealmIfMigrationNeeded
+        this.inMemory = inMemory
+        this.prefetchFile = prefetchFile
+        this.collectCommitStatistics = collectCommitStatistics
+        this.slowQueryThreshold = slowQueryThreshold
+        this.longTransactionThreshold = longTransactionThreshold
+        this.backupJournalPath = backupJournalPath
+        this.changeLogPath = changeLogPath
+        this.migration = migration?.migration
+
+        if (migration != null) {
+            if (deleteRealmIfMigrationNeeded) {
+                throw IllegalArgumentException("Migrations cannot be combined with deleteRealmIfMigrationNeeded")
+            }
+            // Migrations rewrite objects natively when the realm is opened, so the migrated values
+            // would be missing from the recorded changes
+            if (backupJournalPath != null || changeLogPath != null) {
+                throw IllegalArgumentException("Migrations cannot be combined with a backup journal or a change log")
+            }
+        }
+
+        if (backupJournalPath != null) {
+            if (inMemory) {
+                throw IllegalArgumentException("Backup journals are not supported for in-memory realms")
+            }
+            val classesWithoutPrimaryKey = mapOfKClassWithCompanion
+                .filter { (_, companion) -> companion.`$realm$primaryKey` == null }
+                .map { (clazz, _) -> clazz.simpleName }
+            if (classesWithoutPrimaryKey.isNotEmpty()) {
+                throw IllegalArgumentException("Backup journals require all classes to have a primary key: $classesWithoutPrimaryKey")
+            }
+        }
 
         RealmInterop.realm_config_set_path(nativeConfig, this.path)
 
@@ -103,6 +163,18 @@ open class RealmConfigurationImpl constructor(
             RealmInterop.realm_config_set_encryption_key(nativeConfig, it)
         }
 
+        RealmInterop.realm_config_set_in_memory(nativeConfig, inMemory)
+
+        migrationCallback = migration?.let {
+            SchemaMigrationCallback(it.onProgress).also { callback ->
+                try {
+                    it.install(nativeConfig, it.migration.encode(), callback)
+                } catch (exception: RealmCoreException) {
+                    throw genericRealmCoreExceptionHandler("Invalid migration", exception)
+                }
+            }
+        }
+
         mediator = object : Mediator {
             override fun createInstanceOf(clazz: KClass<*>): RealmObjectInternal = (
                 mapOfKClassWithCompanion[clazz]?.`$realm$newInstance`()
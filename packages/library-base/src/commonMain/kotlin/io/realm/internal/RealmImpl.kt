@@ -2,19 +2,25 @@ package io.realm.internal
 
 import io.realm.Callback
 import io.realm.Cancellable
+import io.realm.CommitStatistics
 import io.realm.MutableRealm
 import io.realm.Realm
 import io.realm.RealmObject
 import io.realm.internal.interop.NativePointer
 import io.realm.internal.interop.RealmCoreException
 import io.realm.internal.interop.RealmInterop
+import io.realm.internal.interop.WriteCopySink
 import io.realm.internal.platform.WeakReference
+import io.realm.internal.platform.monotonicTimeNanos
 import io.realm.internal.platform.runBlocking
 import kotlinx.atomicfu.AtomicRef
 import kotlinx.atomicfu.atomic
 import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.SupervisorJob
 import kotlinx.coroutines.cancel
+import kotlinx.coroutines.channels.Channel
+import kotlinx.coroutines.coroutineScope
 import kotlinx.coroutines.flow.Flow
 import kotlinx.coroutines.flow.MutableSharedFlow
 import kotlinx.coroutines.flow.asSharedFlow
@@ -22,6 +28,8 @@ import kotlinx.coroutines.flow.collect
 import kotlinx.coroutines.launch
 import kotlinx.coroutines.sync.Mutex
 import kotlinx.coroutines.sync.withLock
+import kotlin.reflect.KClass
+import kotlin.time.Duration.Companion.nanoseconds
 
 // TODO API-PUBLIC Document platform specific internals (RealmInitializer, etc.)
 internal class RealmImpl private constructor(
@@ -37,6 +45,11 @@ internal class RealmImpl private constructor(
         MutableSharedFlow<RealmImpl>(replay = 1) // Realm notifications emit their initial state when subscribed to
     private val notifier =
         SuspendableNotifier(this, configuration.notificationDispatcher)
+    // Only allocated when enabled, so the writer only pays for a null check otherwise
+    internal val commitStatisticsCollector: CommitStatisticsCollector? =
+        if (configuration.collectCommitStatistics) {
+            CommitStatisticsCollector(configuration.path)
+        } else null
     private val writer =
         SuspendableWriter(this, configuration.writeDispatcher)
 
@@ -80,8 +93,13 @@ internal class RealmImpl private constructor(
         this(
             configuration,
             try {
+                if (configuration.prefetchFile && !configuration.inMemory) {
+                    RealmInterop.realm_prefetch_file(configuration.path)
+                }
                 RealmInterop.realm_open(configuration.nativeConfig)
             } catch (exception: RealmCoreException) {
+                // Rethrow the exception of the migration progress callback that aborted opening
+                configuration.migrationCallback?.takeFailure()?.let { throw it }
                 throw genericRealmCoreExceptionHandler(
                     "Could not open Realm with the given configuration",
                     exception
@@ -113,10 +131,165 @@ internal class RealmImpl private constructor(
         }
     }
 
+    override suspend fun <T : RealmObject> bulkInsert(objects: Flow<T>, chunkSize: Int): Long {
+        require(chunkSize > 0) { "Chunk size must be positive: $chunkSize" }
+        val mediator = configuration.mediator
+        return coroutineScope {
+            val chunks = Channel<List<EncodedObject>>(BULK_INSERT_IN_FLIGHT_CHUNKS)
+            launch(Dispatchers.Default) {
+                try {
+                    var chunk = ArrayList<EncodedObject>(chunkSize)
+                    objects.collect { obj ->
+                        encodeObject(mediator, obj)?.let { chunk.add(it) }
+                        if (chunk.size == chunkSize) {
+                            chunks.send(chunk)
+                            chunk = ArrayList(chunkSize)
+                        }
+                    }
+                    if (chunk.isNotEmpty()) {
+                        chunks.send(chunk)
+                    }
+                    chunks.close()
+                } catch (e: Throwable) {
+                    chunks.close(e)
+                    throw e
+                }
+            }
+            try {
+                val (reference, inserted) = writer.writeEncoded(chunks)
+                updateRealmPointer(reference)
+                inserted
+            } catch (exception: RealmCoreException) {
+                throw genericRealmCoreExceptionHandler(
+                    "Could not execute the bulk insert transaction",
+                    exception
+                )
+            }
+        }
+    }
+
+    private fun checkJsonImport(clazz: KClass<out RealmObject>, batchSize: Int) {
+        require(batchSize > 0) { "Batch size must be positive: $batchSize" }
+        require(clazz in configuration.schema) { "Class is not part of the schema: ${clazz.simpleName}" }
+        // Objects are imported natively, so they would be missing from the recorded changes
+        if (configuration.backupJournalPath != null || configuration.changeLogPath != null) {
+            throw IllegalStateException("JSON cannot be imported into realms with a backup journal or a change log: ${configuration.path}")
+        }
+    }
+
+    // Importing JSON is only available through JNI, so the importer is opened by the JVM only
+    // extensions
+    internal suspend fun importJson(
+        clazz: KClass<out RealmObject>,
+        source: String,
+        batchSize: Int,
+        onProgress: (importedObjects: Long, bytesRead: Long) -> Unit,
+        openImporter: () -> JsonImporter
+    ): Long {
+        checkJsonImport(clazz, batchSize)
+        val importer = openImporter()
+        val className = clazz.simpleName!!
+        val start = monotonicTimeNanos()
+        val imported = try {
+            val (reference, imported) = writer.importJson(importer, className, batchSize, onProgress)
+            updateRealmPointer(reference)
+            imported
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Could not import JSON from $source into '$className'", exception)
+        }
+        val elapsed = (monotonicTimeNanos() - start).nanoseconds
+        val bytes = importer.bytesRead
+        val rate = if (elapsed.inWholeMilliseconds > 0) imported * 1000 / elapsed.inWholeMilliseconds else imported
+        log.info("Imported $imported '$className' objects ($bytes bytes) from $source in ${elapsed.inWholeMilliseconds} ms ($rate objects/s)")
+        return imported
+    }
+
     override fun observe(): Flow<RealmImpl> {
         return realmFlow.asSharedFlow()
     }
 
+    // Writing copies of a realm is only available through JNI, so the copy is written by the JVM
+    // only extensions through the passed functions
+    internal fun writeCopyTo(
+        path: String,
+        encryptionKey: ByteArray?,
+        writeCopy: (dbPointer: NativePointer, path: String, encryptionKey: ByteArray?) -> Unit
+    ) {
+        if (encryptionKey != null && encryptionKey.size != Realm.ENCRYPTION_KEY_LENGTH) {
+            throw IllegalArgumentException("The provided key must be ${Realm.ENCRYPTION_KEY_LENGTH} bytes. The provided key was ${encryptionKey.size} bytes.")
+        }
+        // Use the same frozen reference throughout, so writers are not blocked by the copy
+        val reference = realmReference
+        reference.checkClosed()
+        val start = monotonicTimeNanos()
+        try {
+            writeCopy(reference.dbPointer, path, encryptionKey)
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Could not write a copy of the realm to: $path", exception)
+        }
+        logCopy(reference, path, RealmInterop.realm_get_file_size(path), monotonicTimeNanos() - start)
+    }
+
+    internal fun writeCopyTo(
+        sink: (buffer: ByteArray, length: Int) -> Unit,
+        writeCopy: (dbPointer: NativePointer, sink: WriteCopySink) -> Unit
+    ) {
+        val reference = realmReference
+        reference.checkClosed()
+        var written = 0L
+        val start = monotonicTimeNanos()
+        try {
+            writeCopy(
+                reference.dbPointer,
+                object : WriteCopySink {
+                    override fun write(buffer: ByteArray, length: Int) {
+                        sink(buffer, length)
+                        written += length
+                    }
+                }
+            )
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Could not write a copy of the realm", exception)
+        }
+        logCopy(reference, "sink", written, monotonicTimeNanos() - start)
+    }
+
+    internal fun writeBackupSnapshot(
+        path: String,
+        writeCopy: (dbPointer: NativePointer, path: String, encryptionKey: ByteArray?) -> Unit
+    ) {
+        writer.checkInTransaction("Cannot write a backup snapshot from inside a write transaction")
+        realmReference.checkClosed()
+        val start = monotonicTimeNanos()
+        runBlocking {
+            try {
+                writer.writeBackupSnapshot(path, writeCopy)
+            } catch (exception: RealmCoreException) {
+                throw genericRealmCoreExceptionHandler("Could not write a backup snapshot of the realm to: $path", exception)
+            }
+        }
+        val elapsed = (monotonicTimeNanos() - start).nanoseconds
+        log.info("Wrote backup snapshot of ${configuration.path} to $path in ${elapsed.inWholeMilliseconds} ms and started a new backup journal: ${configuration.backupJournalPath}")
+    }
+
+    private fun logCopy(reference: RealmReference, target: String, bytes: Long, elapsedNanos: Long) {
+        val elapsed = elapsedNanos.nanoseconds
+        log.debug("Wrote a $bytes byte copy of version ${reference.version()} of ${configuration.path} to $target in ${elapsed.inWholeMilliseconds} ms")
+    }
+
+    override fun commitStatistics(): CommitStatistics {
+        val collector = commitStatisticsCollector
+            ?: throw IllegalStateException("Commit statistics are not collected for this realm: ${configuration.path}")
+        return collector.snapshot()
+    }
+
+    override fun isChangeLogInterrupted(): Boolean {
+        if (configuration.changeLogPath == null) {
+            throw IllegalStateException("No change log is configured for this realm: ${configuration.path}")
+        }
+        return writer.isChangeLogInterrupted
+    }
+
     /**
      * FIXME Hidden until we can add proper support
      */
@@ -198,6 +371,14 @@ internal class RealmImpl private constructor(
                 }
             }
         }
+        commitStatisticsCollector?.let {
+            log.debug("Commit statistics for ${configuration.path}: ${it.snapshot()}")
+        }
         // TODO There is currently nothing that tears down the dispatcher
     }
+
+    private companion object {
+        // Number of encoded chunks that can be queued for the writer before encoding is suspended
+        const val BULK_INSERT_IN_FLIGHT_CHUNKS = 2
+    }
 }
@@ -23,6 +23,7 @@ import io.realm.internal.interop.Link
 import io.realm.internal.interop.NativePointer
 import io.realm.internal.interop.RealmCoreException
 import io.realm.internal.interop.RealmInterop
+import kotlinx.atomicfu.atomic
 import kotlinx.coroutines.channels.ChannelResult
 import kotlinx.coroutines.channels.SendChannel
 import kotlinx.coroutines.flow.Flow
@@ -46,14 +47,24 @@ internal class ManagedRealmList<E>(
 
     private val operator = ListOperator<E>(metadata)
 
+    // Frozen lists never change, so their size is only resolved once
+    private val frozenSize = atomic(UNRESOLVED_SIZE)
+
     override val size: Int
         get() {
-            metadata.realm.checkClosed()
-            return RealmInterop.realm_list_size(nativePointer).toInt()
+            metadata.realm.checkClosedFast()
+            if (!metadata.realm.frozen) {
+                return RealmInterop.realm_list_size(nativePointer).toInt()
+            }
+            val cachedSize = frozenSize.value
+            if (cachedSize != UNRESOLVED_SIZE) {
+                return cachedSize
+            }
+            return RealmInterop.realm_list_size(nativePointer).toInt().also { frozenSize.value = it }
         }
 
     override fun get(index: Int): E {
-        metadata.realm.checkClosed()
+        metadata.realm.checkClosedFast()
         try {
             return operator.convert(RealmInterop.realm_list_get(nativePointer, index.toLong()))
         } catch (exception: RealmCoreException) {
@@ -69,6 +80,7 @@ internal class ManagedRealmList<E>(
                 index.toLong(),
                 copyToRealm(metadata.mediator, metadata.realm, element)
             )
+            recordModification()
         } catch (exception: RealmCoreException) {
             throw genericRealmCoreExceptionHandler("Could not add element at list index $index", exception)
         }
@@ -86,12 +98,14 @@ internal class ManagedRealmList<E>(
     override fun clear() {
         metadata.realm.checkClosed()
         RealmInterop.realm_list_clear(nativePointer)
+        recordModification()
     }
 
     override fun removeAt(index: Int): E = get(index).also {
         metadata.realm.checkClosed()
         try {
             RealmInterop.realm_list_erase(nativePointer, index.toLong())
+            recordModification()
         } catch (exception: RealmCoreException) {
             throw genericRealmCoreExceptionHandler("Could not remove element at list index $index", exception)
         }
@@ -106,7 +120,7 @@ internal class ManagedRealmList<E>(
                     index.toLong(),
                     copyToRealm(metadata.mediator, metadata.realm, element)
                 )
-            )
+            ).also { recordModification() }
         } catch (exception: RealmCoreException) {
             throw genericRealmCoreExceptionHandler("Could not set list element at list index $index", exception)
         }
@@ -152,11 +166,20 @@ internal class ManagedRealmList<E>(
         return RealmInterop.realm_list_is_valid(nativePointer)
     }
 
+    private fun recordModification() {
+        val parent = metadata.parent ?: return
+        metadata.realm.recordChange { modified(parent, metadata.parentProperty!!) }
+    }
+
     private fun rangeCheckForAdd(index: Int) {
         if (index < 0 || index > size) {
             throw IndexOutOfBoundsException("Index: '$index', Size: '$size'")
         }
     }
+
+    private companion object {
+        const val UNRESOLVED_SIZE = -1
+    }
 }
 
 /**
@@ -165,7 +188,10 @@ internal class ManagedRealmList<E>(
 internal data class ListOperatorMetadata(
     val clazz: KClass<*>,
     val mediator: Mediator,
-    val realm: RealmReference
+    val realm: RealmReference,
+    // The object and property owning the list, if known, for recording modifications of the list
+    val parent: RealmObjectInternal? = null,
+    val parentProperty: String? = null
 )
 
 /**
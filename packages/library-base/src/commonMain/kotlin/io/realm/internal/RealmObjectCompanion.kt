@@ -26,4 +26,6 @@ interface RealmObjectCompanion {
     val `$realm$primaryKey`: KMutableProperty1<*, *>?
     fun `$realm$schema`(): Table
     fun `$realm$newInstance`(): Any
+    // Values of the persisted properties of an instance of the class in the order of `$realm$fields`
+    fun `$realm$copyToRealm`(obj: Any): List<Any?>
 }
@@ -34,14 +34,54 @@ object RealmObjectHelper {
     //   property names directly from T/property triggers runtime crash for primitive properties on
     //   Kotlin native. Seems to be an issue with boxing/unboxing
 
+    /**
+     * Runs an accessor operation without checking the validity of [obj] up front. The C-API
+     * already verifies that the object is valid as part of the operation, so validity is only
+     * checked if the operation fails to report invalid/deleted objects consistently.
+     */
+    internal inline fun <T> checkedAccess(obj: RealmObjectInternal, block: () -> T): T {
+        try {
+            return block()
+        } catch (exception: RealmCoreException) {
+            obj.checkValid()
+            throw exception
+        }
+    }
+
+    /**
+     * Returns the value of [col] from the field cache of objects of frozen realms. If the property
+     * has not been read before, or the object is not frozen, the value is read with [read] and
+     * cached if possible.
+     */
+    internal inline fun cachedAccess(
+        obj: RealmObjectInternal,
+        realm: RealmReference,
+        col: String,
+        read: () -> Any?
+    ): Any? {
+        val cache = obj.`$realm$FieldCache`
+        // Always read if the realm is closed to fail consistently with non-cached access
+        if (cache == null || realm.owner.isClosedCached()) {
+            return read()
+        }
+        val cached = cache.get(col)
+        if (cached !== FieldCache.NOT_CACHED) {
+            return cached
+        }
+        return read().also { cache.put(col, it) }
+    }
+
     // Consider inlining
     @Suppress("unused") // Called from generated code
     internal fun <R> getValue(obj: RealmObjectInternal, col: String): Any? {
-        obj.checkValid()
         val realm = obj.`$realm$Owner` ?: throw IllegalStateException("Invalid/deleted object")
         val o = obj.`$realm$ObjectPointer` ?: throw IllegalStateException("Invalid/deleted object")
-        val key = RealmInterop.realm_get_col_key(realm.dbPointer, obj.`$realm$TableName`!!, col)
-        return RealmInterop.realm_get_value(o, key)
+        return cachedAccess(obj, realm, col) {
+            checkedAccess(obj) {
+                val key = realm.owner.columnKey(realm, obj.`$realm$TableName`!!, col)
+                RealmInterop.realm_get_value(o, key)
+            }
+        }
     }
 
     // Return type should be R? but causes compilation errors for native
@@ -50,22 +90,26 @@ object RealmObjectHelper {
         obj: RealmObjectInternal,
         col: String,
     ): Any? {
-        obj.checkValid()
         val realm = obj.`$realm$Owner` ?: throw IllegalStateException("Invalid/deleted object")
         val o = obj.`$realm$ObjectPointer` ?: throw IllegalStateException("Invalid/deleted object")
-        val key = RealmInterop.realm_get_col_key(realm.dbPointer, obj.`$realm$TableName`!!, col)
-        val link = RealmInterop.realm_get_value<Link>(o, key)
-        if (link != null) {
-            val value =
-                (obj.`$realm$Mediator`!!).createInstanceOf(R::class)
-            return value.link(
-                obj.`$realm$Owner`!!,
-                obj.`$realm$Mediator`!!,
-                R::class,
-                link
-            )
+        return cachedAccess(obj, realm, col) {
+            val link = checkedAccess(obj) {
+                val key = realm.owner.columnKey(realm, obj.`$realm$TableName`!!, col)
+                RealmInterop.realm_get_value<Link>(o, key)
+            }
+            if (link != null) {
+                val value =
+                    (obj.`$realm$Mediator`!!).createInstanceOf(R::class)
+                value.link(
+                    obj.`$realm$Owner`!!,
+                    obj.`$realm$Mediator`!!,
+                    R::class,
+                    link
+                )
+            } else {
+                null
+            }
         }
-        return null
     }
 
     // Return type should be RealmList<R?> but causes compilation errors for native
@@ -76,14 +120,18 @@ object RealmObjectHelper {
         val realm: RealmReference =
             obj.`$realm$Owner` ?: throw IllegalStateException("Invalid/deleted object")
         val o = obj.`$realm$ObjectPointer` ?: throw IllegalStateException("Invalid/deleted object")
-        val key: ColumnKey =
-            RealmInterop.realm_get_col_key(realm.dbPointer, obj.`$realm$TableName`!!, col)
-        val listPtr: NativePointer = RealmInterop.realm_get_list(o, key)
-        val clazz: KClass<*> = R::class
-        val mediator: Mediator = obj.`$realm$Mediator`!!
+        @Suppress("UNCHECKED_CAST")
+        return cachedAccess(obj, realm, col) {
+            val listPtr: NativePointer = checkedAccess(obj) {
+                val key: ColumnKey = realm.owner.columnKey(realm, obj.`$realm$TableName`!!, col)
+                RealmInterop.realm_get_list(o, key)
+            }
+            val clazz: KClass<*> = R::class
+            val mediator: Mediator = obj.`$realm$Mediator`!!
 
-        // Cannot call managedRealmList directly from an inline function
-        return getManagedRealmList(listPtr, clazz, mediator, realm)
+            // Cannot call managedRealmList directly from an inline function
+            getManagedRealmList(listPtr, clazz, mediator, realm, obj, col)
+        } as RealmList<Any?>
     }
 
     /**
@@ -95,14 +143,18 @@ object RealmObjectHelper {
         listPtr: NativePointer,
         clazz: KClass<*>,
         mediator: Mediator,
-        realm: RealmReference
+        realm: RealmReference,
+        parent: RealmObjectInternal,
+        property: String
     ): RealmList<Any?> {
         return managedRealmList(
             listPtr,
             ListOperatorMetadata(
                 clazz = clazz,
                 mediator = mediator,
-                realm = realm
+                realm = realm,
+                parent = parent,
+                parentProperty = property
             )
         )
     }
@@ -110,10 +162,9 @@ object RealmObjectHelper {
     // Consider inlining
     @Suppress("unused") // Called from generated code
     internal fun <R> setValue(obj: RealmObjectInternal, col: String, value: R) {
-        obj.checkValid()
         val realm = obj.`$realm$Owner` ?: throw IllegalStateException("Invalid/deleted object")
         val o = obj.`$realm$ObjectPointer` ?: throw IllegalStateException("Invalid/deleted object")
-        val key = RealmInterop.realm_get_col_key(realm.dbPointer, obj.`$realm$TableName`!!, col)
+        val key = checkedAccess(obj) { realm.owner.columnKey(realm, obj.`$realm$TableName`!!, col) }
         // TODO Consider making a RealmValue cinterop type and move the various to_realm_value
         //  implementations in the various platform RealmInterops here to eliminate
         //  RealmObjectInterop and make cinterop operate on primitive values and native pointers
@@ -121,11 +172,13 @@ object RealmObjectHelper {
         //  instead of generating a typed path for each type.
         try {
             RealmInterop.realm_set_value(o, key, value, false)
+            realm.recordChange { modified(obj, col) }
         }
         // The catch block should catch specific Core exceptions and rethrow them as Kotlin exceptions.
         // Core exceptions meaning might differ depending on the context, by rethrowing we can add some context related
         // info that might help users to understand the exception.
         catch (exception: RealmCoreException) {
+            obj.checkValid()
             throw IllegalStateException(
                 "Cannot set `${obj.`$realm$TableName`}.$col` to `$value`: changing Realm data can only be done on a live object from inside a write transaction. Frozen objects can be turned into live using the 'MutableRealm.findLatest(obj)' API.",
                 exception
@@ -139,8 +192,9 @@ object RealmObjectHelper {
         col: String,
         value: R?
     ) {
-        obj.checkValid()
         val newValue = if (value?.`$realm$IsManaged` == false) {
+            // Don't copy the value into the realm if it cannot be assigned anyway
+            obj.checkValid()
             copyToRealm(obj.`$realm$Mediator`!!, obj.`$realm$Owner`!!, value)
         } else value
         setValue(obj, col, newValue)
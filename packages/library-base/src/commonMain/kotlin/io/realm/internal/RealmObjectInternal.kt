@@ -42,6 +42,8 @@ interface RealmObjectInternal : RealmObject, RealmStateHolder, io.realm.internal
     var `$realm$TableName`: String?
     var `$realm$IsManaged`: Boolean
     var `$realm$Mediator`: Mediator?
+    // Cache of property values, only available for objects of frozen realms.
+    var `$realm$FieldCache`: FieldCache?
 
     // Any methods added to this interface, needs to be fake overridden on the user classes by
     // the compiler plugin, see "RealmObjectInternal overrides" in RealmModelLowering.lower
@@ -37,6 +37,7 @@ internal fun <T : RealmObject> RealmObjectInternal.manage(
     // FIXME API-LIFECYCLE Initialize actual link; requires handling of link in compiler plugin
     // this.link = RealmInterop.realm_object_as_link()
     this.`$realm$Mediator` = mediator
+    this.`$realm$FieldCache` = if (realm.frozen) FieldCache() else null
     @Suppress("UNCHECKED_CAST")
     return this as T
 }
@@ -54,6 +55,7 @@ internal fun <T : RealmObject> RealmObjectInternal.link(
     // FIXME API-LIFECYCLE Could be lazy loaded from link; requires handling of link in compiler plugin
     this.`$realm$ObjectPointer` = RealmInterop.realm_get_object(realm.dbPointer, link)
     this.`$realm$Mediator` = mediator
+    this.`$realm$FieldCache` = if (realm.frozen) FieldCache() else null
     @Suppress("UNCHECKED_CAST")
     return this as T
 }
@@ -28,6 +28,10 @@ data class RealmReference(
     // FIXME Should we keep a debug flag to assert that we have the right liveness state
 ) : RealmState {
 
+    // The liveness of the underlying SharedRealm never changes, so only resolve it once to allow
+    // checking it without calling into native.
+    internal val frozen: Boolean by lazy { RealmInterop.realm_is_frozen(dbPointer) }
+
     override fun version(): VersionId {
         checkClosed()
         return VersionId(RealmInterop.realm_get_version_id(dbPointer))
@@ -47,4 +51,19 @@ data class RealmReference(
             throw IllegalStateException("Realm has been closed and is no longer accessible: ${owner.configuration.path}")
         }
     }
+
+    /**
+     * Same as [checkClosed] but only calls into native for live references. Frozen references
+     * are kept open until their owner is closed as long as they are referenced, so for these it is
+     * sufficient to check the state tracked by the owner.
+     */
+    internal fun checkClosedFast() {
+        if (frozen) {
+            if (owner.isClosedCached()) {
+                throw IllegalStateException("Realm has been closed and is no longer accessible: ${owner.configuration.path}")
+            }
+        } else {
+            checkClosed()
+        }
+    }
 }
@@ -16,16 +16,22 @@
 
 package io.realm.internal
 
+import io.realm.EstimatedIndexUsage
 import io.realm.RealmObject
 import io.realm.RealmResults
+import io.realm.internal.interop.ColumnKey
 import io.realm.internal.interop.Link
 import io.realm.internal.interop.NativePointer
 import io.realm.internal.interop.RealmCoreException
 import io.realm.internal.interop.RealmInterop
+import io.realm.internal.interop.WriteCopySink
+import io.realm.internal.platform.monotonicTimeNanos
+import kotlinx.atomicfu.atomic
 import kotlinx.coroutines.channels.ChannelResult
 import kotlinx.coroutines.channels.SendChannel
 import kotlinx.coroutines.flow.Flow
 import kotlin.reflect.KClass
+import kotlin.time.Duration.Companion.nanoseconds
 
 // FIXME API-QUERY Final query design is tracked in https://github.com/realm/realm-kotlin/issues/84
 //  - Lazy API makes it harded to debug
@@ -35,10 +41,12 @@ import kotlin.reflect.KClass
 internal class RealmResultsImpl<T : RealmObject> : AbstractList<T>, RealmResults<T>, RealmStateHolder, Observable<RealmResultsImpl<T>> {
 
     private val mode: Mode
-    private val realm: RealmReference
+    internal val realm: RealmReference
     private val clazz: KClass<T>
     private val schema: Mediator
     internal val result: NativePointer
+    // Properties compared for equality at the top level of the queries behind these results
+    private val equalityProperties: List<String>
 
     private enum class Mode {
         // FIXME Needed to make working with @LinkingObjects easier.
@@ -46,31 +54,65 @@ internal class RealmResultsImpl<T : RealmObject> : AbstractList<T>, RealmResults
         RESULTS // RealmResults wrapping a Realm Core Results.
     }
     // Wrap existing native Results class
-    private constructor(realm: RealmReference, results: NativePointer, clazz: KClass<T>, schema: Mediator) {
+    private constructor(
+        realm: RealmReference,
+        results: NativePointer,
+        clazz: KClass<T>,
+        schema: Mediator,
+        equalityProperties: List<String>
+    ) {
         this.mode = Mode.RESULTS
         this.realm = realm
         this.result = results
         this.clazz = clazz
         this.schema = schema
+        this.equalityProperties = equalityProperties
     }
 
     internal companion object {
-        internal fun <T : RealmObject> fromQuery(realm: RealmReference, query: NativePointer, clazz: KClass<T>, schema: Mediator): RealmResultsImpl<T> {
+        internal fun <T : RealmObject> fromQuery(
+            realm: RealmReference,
+            query: NativePointer,
+            clazz: KClass<T>,
+            schema: Mediator,
+            equalityProperties: List<String> = emptyList()
+        ): RealmResultsImpl<T> {
             // realm_query_find_all doesn't fully evaluate until you interact with it.
-            return RealmResultsImpl(realm, RealmInterop.realm_query_find_all(query), clazz, schema)
+            return RealmResultsImpl(realm, RealmInterop.realm_query_find_all(query), clazz, schema, equalityProperties)
         }
 
-        internal fun <T : RealmObject> fromResults(realm: RealmReference, results: NativePointer, clazz: KClass<T>, schema: Mediator): RealmResultsImpl<T> {
-            return RealmResultsImpl(realm, results, clazz, schema)
+        internal fun <T : RealmObject> fromResults(
+            realm: RealmReference,
+            results: NativePointer,
+            clazz: KClass<T>,
+            schema: Mediator,
+            equalityProperties: List<String> = emptyList()
+        ): RealmResultsImpl<T> {
+            return RealmResultsImpl(realm, results, clazz, schema, equalityProperties)
         }
+
+        private const val UNRESOLVED_SIZE = -1
     }
 
     override fun realmState(): RealmState {
         return realm
     }
 
+    // Results of frozen realms never change, so their size is only resolved once
+    private val frozenSize = atomic(UNRESOLVED_SIZE)
+
     override val size: Int
-        get() = RealmInterop.realm_results_count(result).toInt()
+        get() {
+            realm.checkClosedFast()
+            if (!realm.frozen) {
+                return RealmInterop.realm_results_count(result).toInt()
+            }
+            val cachedSize = frozenSize.value
+            if (cachedSize != UNRESOLVED_SIZE) {
+                return cachedSize
+            }
+            return RealmInterop.realm_results_count(result).toInt().also { frozenSize.value = it }
+        }
 
     override fun get(index: Int): T {
         val link: Link = RealmInterop.realm_results_get<T>(result, index.toLong())
@@ -82,18 +124,100 @@ internal class RealmResultsImpl<T : RealmObject> : AbstractList<T>, RealmResults
 
     @Suppress("SpreadOperator")
     override fun query(query: String, vararg args: Any?): RealmResultsImpl<T> {
+        val className = clazz.simpleName!!
         try {
-            return fromQuery(
-                realm,
-                RealmInterop.realm_query_parse(result, clazz.simpleName!!, query, *args),
-                clazz,
-                schema,
-            )
+            return realm.owner.instrumentQuery(className, query) {
+                fromQuery(
+                    realm,
+                    RealmInterop.realm_query_parse(result, className, query, *args),
+                    clazz,
+                    schema,
+                    // Queries on results are combined with the query of the results
+                    equalityProperties + equalityProperties(query),
+                )
+            }
         } catch (exception: RealmCoreException) {
             throw genericRealmCoreExceptionHandler("Invalid syntax for query `$query`", exception)
         }
     }
 
+    override fun estimatedIndexUsage(): EstimatedIndexUsage {
+        realm.checkClosed()
+        val className = clazz.simpleName!!
+        val dbPointer = realm.dbPointer
+        val classKey = RealmInterop.realm_find_class(dbPointer, className)
+        val candidateProperties = equalityProperties.distinct().filter { property ->
+            RealmInterop.realm_has_search_index(
+                dbPointer,
+                classKey,
+                realm.owner.columnKey(realm, className, property)
+            )
+        }
+        return EstimatedIndexUsage(candidateProperties)
+    }
+
+    // Exporting to Arrow is only available through JNI, so the stream is written by the JVM only
+    // extensions through the passed functions
+    internal fun exportArrow(
+        path: String,
+        properties: List<String>,
+        batchSize: Int,
+        export: (results: NativePointer, columns: List<ColumnKey>, batchSize: Long, path: String) -> Unit
+    ) {
+        val columns = arrowColumns(properties, batchSize)
+        val start = monotonicTimeNanos()
+        try {
+            export(result, columns, batchSize.toLong(), path)
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Could not export the results to: $path", exception)
+        }
+        logExport(path, RealmInterop.realm_get_file_size(path), monotonicTimeNanos() - start)
+    }
+
+    internal fun exportArrow(
+        properties: List<String>,
+        batchSize: Int,
+        sink: (buffer: ByteArray, length: Int) -> Unit,
+        export: (results: NativePointer, columns: List<ColumnKey>, batchSize: Long, sink: WriteCopySink) -> Unit
+    ) {
+        val columns = arrowColumns(properties, batchSize)
+        var written = 0L
+        val start = monotonicTimeNanos()
+        try {
+            export(
+                result,
+                columns,
+                batchSize.toLong(),
+                object : WriteCopySink {
+                    override fun write(buffer: ByteArray, length: Int) {
+                        sink(buffer, length)
+                        written += length
+                    }
+                }
+            )
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Could not export the results", exception)
+        }
+        logExport("sink", written, monotonicTimeNanos() - start)
+    }
+
+    private fun arrowColumns(properties: List<String>, batchSize: Int): List<ColumnKey> {
+        if (properties.isEmpty()) {
+            throw IllegalArgumentException("At least one property must be exported")
+        }
+        if (batchSize <= 0) {
+            throw IllegalArgumentException("The batch size must be positive: $batchSize")
+        }
+        realm.checkClosed()
+        val className = clazz.simpleName!!
+        return properties.map { property -> realm.owner.columnKey(realm, className, property) }
+    }
+
+    private fun logExport(target: String, bytes: Long, elapsedNanos: Long) {
+        val elapsed = elapsedNanos.nanoseconds
+        realm.owner.log.debug("Exported $size '${clazz.simpleName}' objects as $bytes bytes of Arrow to $target in ${elapsed.inWholeMilliseconds} ms")
+    }
+
     override fun observe(): Flow<RealmResultsImpl<T>> {
         realm.checkClosed()
         return realm.owner.registerObserver(this)
@@ -103,6 +227,11 @@ internal class RealmResultsImpl<T : RealmObject> : AbstractList<T>, RealmResults
         // TODO OPTIMIZE Are there more efficient ways to do this? realm_query_delete_all is not
         //  available in C-API yet, but should probably await final query design
         //  https://github.com/realm/realm-kotlin/issues/84
+        realm.recordChange {
+            for (obj in this@RealmResultsImpl) {
+                deleted(obj as RealmObjectInternal)
+            }
+        }
         RealmInterop.realm_results_delete_all(result)
     }
 
@@ -113,7 +242,7 @@ internal class RealmResultsImpl<T : RealmObject> : AbstractList<T>, RealmResults
     override fun freeze(realm: RealmReference): RealmResultsImpl<T> {
         val frozenDbPointer = realm.dbPointer
         val frozenResults = RealmInterop.realm_results_resolve_in(result, frozenDbPointer)
-        return fromResults(realm, frozenResults, clazz, schema)
+        return fromResults(realm, frozenResults, clazz, schema, equalityProperties)
     }
 
     /**
@@ -122,7 +251,7 @@ internal class RealmResultsImpl<T : RealmObject> : AbstractList<T>, RealmResults
     override fun thaw(realm: RealmReference): RealmResultsImpl<T> {
         val liveDbPointer = realm.dbPointer
         val liveResultPtr = RealmInterop.realm_results_resolve_in(result, liveDbPointer)
-        return fromResults(realm, liveResultPtr, clazz, schema)
+        return fromResults(realm, liveResultPtr, clazz, schema, equalityProperties)
     }
 
     override fun registerForNotification(callback: io.realm.internal.interop.Callback): NativePointer {
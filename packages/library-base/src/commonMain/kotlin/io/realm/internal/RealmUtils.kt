@@ -17,7 +17,6 @@
 
 package io.realm.internal
 
-import io.realm.RealmList
 import io.realm.RealmObject
 import io.realm.internal.interop.RealmCoreAddressSpaceExhaustedException
 import io.realm.internal.interop.RealmCoreCallbackException
@@ -59,11 +58,7 @@ import io.realm.internal.interop.RealmCoreUnsupportedFileFormatVersionException
 import io.realm.internal.interop.RealmCoreWrongPrimaryKeyTypeException
 import io.realm.internal.interop.RealmCoreWrongThreadException
 import io.realm.internal.interop.RealmInterop
-import io.realm.isManaged
-import io.realm.isValid
 import kotlin.reflect.KClass
-import kotlin.reflect.KMutableProperty1
-import kotlin.reflect.KProperty1
 
 /**
  * Add a check and error message for code that never be reached because it should have been
@@ -96,7 +91,7 @@ internal fun <T : RealmObject> create(mediator: Mediator, realm: RealmReference,
             mediator,
             type,
             RealmInterop.realm_object_create(realm.dbPointer, key)
-        )
+        ).also { realm.recordChange { inserted(it as RealmObjectInternal) } }
     } catch (e: RealmCoreException) {
         throw genericRealmCoreExceptionHandler("Failed to create object of type '$objectType'", e)
     }
@@ -130,108 +125,35 @@ internal fun <T : RealmObject> create(
             mediator,
             type,
             RealmInterop.realm_object_create_with_primary_key(realm.dbPointer, key, primaryKey)
-        )
+        ).also { realm.recordChange { inserted(it as RealmObjectInternal) } }
     } catch (e: RealmCoreException) {
         throw genericRealmCoreExceptionHandler("Failed to create object of type '$objectType'", e)
     }
 }
 
-@Suppress("NestedBlockDepth")
+/**
+ * Copy an object and the graph of unmanaged objects reachable from it into the realm.
+ *
+ * All properties are read before the objects are created and their values are written directly
+ * through the C-API with column keys resolved once per class, instead of going through the
+ * generated accessors of the managed objects.
+ */
 internal fun <T> copyToRealm(
     mediator: Mediator,
     realmPointer: RealmReference,
-    element: T,
-    cache: MutableMap<RealmObjectInternal, RealmObjectInternal> = mutableMapOf()
+    element: T
 ): T {
     return if (element is RealmObjectInternal) {
-        var elementToCopy = element
-
-        // Throw if object is not valid
-        if (!elementToCopy.isValid()) {
-            throw IllegalStateException("Cannot copy an invalid managed object to Realm.")
-        }
-
-        // Copy object if it is not managed
-        if (!elementToCopy.isManaged()) {
-            val instance: RealmObjectInternal = element
-            val companion = mediator.companionOf(instance::class)
-            val members =
-                companion.`$realm$fields` as List<KMutableProperty1<RealmObjectInternal, Any?>>
-
-            val target = companion.`$realm$primaryKey`?.let { primaryKey ->
-                create(
-                    mediator,
-                    realmPointer,
-                    instance::class,
-                    (primaryKey as KProperty1<RealmObjectInternal, Any?>).get(instance)
-                )
-            } ?: create(mediator, realmPointer, instance::class)
-
-            cache[instance] = target
-
-            // TODO OPTIMIZE We could set all properties at once with on C-API call
-            for (member: KMutableProperty1<RealmObjectInternal, Any?> in members) {
-                val targetValue = member.get(instance).let { sourceObject ->
-                    // Check whether the source is a RealmObject, a primitive or a list
-                    // In case of list ensure the values from the source are passed to the native list
-                    if (sourceObject is RealmObjectInternal && !sourceObject.`$realm$IsManaged`) {
-                        cache.getOrPut(sourceObject) {
-                            copyToRealm(mediator, realmPointer, sourceObject, cache)
-                        }
-                    } else if (sourceObject is RealmList<*>) {
-                        processListMember(
-                            mediator,
-                            realmPointer,
-                            cache,
-                            member,
-                            target,
-                            sourceObject
-                        )
-                    } else {
-                        sourceObject
-                    }
-                }
-                targetValue?.let {
-                    // TODO OPTIMIZE Should we do a separate setter that allows the isDefault flag for sync
-                    //  optimizations
-                    member.set(target, it)
-                }
-            }
-            elementToCopy = target as T
-        }
-
-        elementToCopy
+        // Throws if object is not valid and returns null if it is already managed
+        val encoded = encodeObject(mediator, element) ?: return element
+        @Suppress("UNCHECKED_CAST")
+        EncodedObjectWriter(mediator, realmPointer).insert(encoded) as T
     } else {
         // Ignore copy if the element is of a primitive type
         element
     }
 }
 
-@Suppress("LongParameterList")
-private fun <T : RealmObject> processListMember(
-    mediator: Mediator,
-    realmPointer: RealmReference,
-    cache: MutableMap<RealmObjectInternal, RealmObjectInternal>,
-    member: KMutableProperty1<T, Any?>,
-    target: T,
-    sourceObject: RealmList<*>
-): RealmList<Any?> {
-    @Suppress("UNCHECKED_CAST")
-    val list = member.get(target) as RealmList<Any?>
-    for (item in sourceObject) {
-        // Same as in copyToRealm, check whether we are working with a primitive or a RealmObject
-        if (item is RealmObjectInternal && !item.`$realm$IsManaged`) {
-            val value = cache.getOrPut(item) {
-                copyToRealm(mediator, realmPointer, item, cache)
-            }
-            list.add(value)
-        } else {
-            list.add(item)
-        }
-    }
-    return list
-}
-
 fun genericRealmCoreExceptionHandler(message: String, cause: RealmCoreException): Throwable {
     return when (cause) {
         is RealmCoreOutOfMemoryException,
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.SchemaMigration
+import io.realm.internal.interop.MigrationProgressCallback
+import io.realm.internal.interop.NativePointer
+
+/**
+ * Forwards the progress of native schema migrations to the listener of a configuration.
+ *
+ * Exceptions cannot cross the native migration, so an exception thrown by the listener aborts the
+ * migration and is kept until [takeFailure] is called by the code opening the realm.
+ */
+class SchemaMigrationCallback(
+    private val onProgress: ((operation: Int, processedObjects: Long, totalObjects: Long) -> Unit)?
+) : MigrationProgressCallback {
+
+    // Migrations run on the thread opening the realm, which also takes the failure
+    private var failure: Throwable? = null
+
+    override fun onProgress(operation: Int, processedObjects: Long, totalObjects: Long): Boolean {
+        return try {
+            onProgress?.invoke(operation, processedObjects, totalObjects)
+            true
+        } catch (e: Throwable) {
+            failure = e
+            false
+        }
+    }
+
+    /**
+     * Returns and clears the exception that aborted the last migration, if any.
+     */
+    fun takeFailure(): Throwable? = failure.also { failure = null }
+}
+
+/**
+ * A schema migration set on a configuration builder along with the function that installs its plan
+ * on the native configuration. Migrations run through core objects that are not exposed by the
+ * C-API, so they are only set up by the JVM only `migration` builder extension.
+ */
+class SchemaMigrationSetup(
+    val migration: SchemaMigration,
+    val onProgress: ((operation: Int, processedObjects: Long, totalObjects: Long) -> Unit)?,
+    val install: (config: NativePointer, plan: ByteArray, callback: MigrationProgressCallback) -> Unit
+)
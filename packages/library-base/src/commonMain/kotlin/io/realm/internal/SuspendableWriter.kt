@@ -18,14 +18,21 @@ package io.realm.internal
 
 import io.realm.MutableRealm
 import io.realm.RealmObject
+import io.realm.internal.interop.NativePointer
 import io.realm.internal.interop.RealmInterop
+import io.realm.internal.platform.monotonicTimeNanos
 import io.realm.internal.platform.runBlocking
 import io.realm.internal.platform.threadId
 import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.CoroutineName
+import kotlinx.coroutines.channels.ReceiveChannel
 import kotlinx.coroutines.ensureActive
 import kotlinx.coroutines.sync.Mutex
 import kotlinx.coroutines.sync.withLock
 import kotlinx.coroutines.withContext
+import kotlin.coroutines.coroutineContext
+import kotlin.time.Duration
+import kotlin.time.Duration.Companion.nanoseconds
 import io.realm.internal.freeze as freezeTyped
 
 /**
@@ -42,12 +49,29 @@ import io.realm.internal.freeze as freezeTyped
 internal class SuspendableWriter(private val owner: RealmImpl, val dispatcher: CoroutineDispatcher) {
     private val tid: ULong
     private val realmInitializer = lazy {
-        MutableRealmImpl(owner.configuration, dispatcher)
+        MutableRealmImpl(owner.configuration, dispatcher).also {
+            if (owner.configuration.backupJournalPath != null || owner.configuration.changeLogPath != null) {
+                it.changeRecorder = ChangeRecorder(owner.configuration.mediator, owner.configuration.schema)
+            }
+        }
     }
     // Must only be accessed from the dispatchers thread
     private val realm: MutableRealmImpl by realmInitializer
     private val shouldClose = kotlinx.atomicfu.atomic<Boolean>(false)
     private val transactionMutex = Mutex(false)
+    // Set if appending to the backup journal failed. The journal is not appended to until a new
+    // backup snapshot is written, so it stays a consistent prefix of the committed transactions.
+    private var backupJournalInterrupted = false
+    // Set if appending to the change log failed. The next commit appends a gap record covering the
+    // versions that could not be logged before logging resumes.
+    private val changeLogInterrupted = kotlinx.atomicfu.atomic<Boolean>(false)
+    // The last version committed by the writer and the first version not covered by a change log
+    // record, or null before the first commit
+    private var lastCommittedVersion: Long? = null
+    private var firstUnloggedVersion: Long? = null
+
+    val isChangeLogInterrupted: Boolean
+        get() = changeLogInterrupted.value
 
     init {
         tid = runBlocking(dispatcher) { threadId() }
@@ -55,18 +79,18 @@ internal class SuspendableWriter(private val owner: RealmImpl, val dispatcher: C
 
     suspend fun <R> write(block: MutableRealm.() -> R): Pair<RealmReference, R> {
         // TODO Would we be able to offer a per write error handler by adding a CoroutineExceptionHandler
+        val caller = transactionCaller()
         return withContext(dispatcher) {
-            var result: R
-
-            transactionMutex.withLock {
+            var result: R = withTransactionLock(caller) {
                 try {
                     realm.beginTransaction()
                     ensureActive()
-                    result = block(realm)
+                    val blockResult = block(realm)
                     ensureActive()
                     if (!shouldClose.value && realm.isInTransaction()) {
-                        realm.commitTransaction()
+                        commit()
                     }
+                    blockResult
                 } catch (e: IllegalStateException) {
                     if (realm.isInTransaction()) {
                         realm.cancelWrite()
@@ -91,6 +115,254 @@ internal class SuspendableWriter(private val owner: RealmImpl, val dispatcher: C
         }
     }
 
+    /**
+     * Insert chunks of encoded objects in a single write transaction.
+     *
+     * Chunks are applied as soon as they are received, so the producer can encode the next chunks
+     * while the previous ones are being inserted. If the channel is closed with an exception or
+     * inserting an object fails, the transaction is rolled back and nothing is committed.
+     *
+     * @return the frozen reference to the version of the realm with the inserted objects along
+     * with the number of inserted objects.
+     */
+    suspend fun writeEncoded(chunks: ReceiveChannel<List<EncodedObject>>): Pair<RealmReference, Long> {
+        val caller = transactionCaller()
+        return withContext(dispatcher) {
+            var inserted = 0L
+
+            withTransactionLock(caller) {
+                try {
+                    realm.beginTransaction()
+                    for (chunk in chunks) {
+                        ensureActive()
+                        realm.insertEncoded(chunk)
+                        inserted += chunk.size
+                    }
+                    ensureActive()
+                    if (!shouldClose.value && realm.isInTransaction()) {
+                        commit()
+                    }
+                } catch (e: Throwable) {
+                    // Don't commit partially inserted data regardless of the cause of the failure
+                    if (realm.isInTransaction()) {
+                        realm.cancelWrite()
+                    }
+                    throw e
+                }
+            }
+
+            val newDbPointer = RealmInterop.realm_freeze(realm.realmReference.dbPointer)
+            Pair(RealmReference(owner, newDbPointer), inserted)
+        }
+    }
+
+    /**
+     * Imports the JSON objects of an [importer] into a class in batches of at most
+     * [batchSize] objects, each committed in its own write transaction.
+     *
+     * The write lock is released between batches, so other writes are not blocked for the whole
+     * import. If a batch fails it is rolled back, while previous batches stay committed.
+     *
+     * @return the frozen reference to the version of the realm with the imported objects along
+     * with the number of imported objects.
+     */
+    suspend fun importJson(
+        importer: JsonImporter,
+        className: String,
+        batchSize: Int,
+        onProgress: (importedObjects: Long, bytesRead: Long) -> Unit
+    ): Pair<RealmReference, Long> {
+        val caller = transactionCaller()
+        return withContext(dispatcher) {
+            val classKey = RealmInterop.realm_find_class(realm.realmReference.dbPointer, className)
+            var imported = 0L
+            while (!shouldClose.value) {
+                val batch = withTransactionLock(caller) {
+                    try {
+                        realm.beginTransaction()
+                        ensureActive()
+                        val count = importer.importBatch(realm.realmReference.dbPointer, classKey, batchSize.toLong())
+                        if (count == 0L) {
+                            realm.cancelWrite()
+                        } else if (!shouldClose.value && realm.isInTransaction()) {
+                            commit()
+                        }
+                        count
+                    } catch (e: Throwable) {
+                        if (realm.isInTransaction()) {
+                            realm.cancelWrite()
+                        }
+                        throw e
+                    }
+                }
+                if (batch == 0L) {
+                    break
+                }
+                imported += batch
+                onProgress(imported, importer.bytesRead)
+            }
+
+            val newDbPointer = RealmInterop.realm_freeze(realm.realmReference.dbPointer)
+            Pair(RealmReference(owner, newDbPointer), imported)
+        }
+    }
+
+    // Captures the caller of a write transaction so it can be identified if it holds the write lock
+    // for longer than the configured threshold. Must be called before switching to the dispatcher
+    // to capture the stack of the caller.
+    private suspend fun transactionCaller(): TransactionCaller? {
+        if (owner.configuration.longTransactionThreshold == null) {
+            return null
+        }
+        return TransactionCaller(
+            coroutineContext[CoroutineName]?.name,
+            Throwable("Write transaction started from")
+        )
+    }
+
+    private suspend inline fun <R> withTransactionLock(caller: TransactionCaller?, block: () -> R): R {
+        return transactionMutex.withLock {
+            val statistics = owner.commitStatisticsCollector
+            if (caller == null && statistics == null) {
+                return@withLock block()
+            }
+            val start = monotonicTimeNanos()
+            try {
+                block()
+            } finally {
+                val elapsed = monotonicTimeNanos() - start
+                statistics?.recordTransaction(elapsed)
+                if (caller != null) {
+                    reportLongTransaction(caller, elapsed.nanoseconds)
+                }
+            }
+        }
+    }
+
+    private fun commit() {
+        val statistics = owner.commitStatisticsCollector
+        if (statistics == null) {
+            realm.commitTransaction()
+        } else {
+            val start = monotonicTimeNanos()
+            realm.commitTransaction()
+            val elapsed = monotonicTimeNanos() - start
+            statistics.recordCommit(elapsed)
+        }
+        recordCommit()
+    }
+
+    // Appends the committed transaction to the backup journal and the change log. Must be called
+    // right after committing, while the writer's realm is still at the committed version. The
+    // transaction is already committed, so failures are reported instead of thrown.
+    private fun recordCommit() {
+        val recorder = realm.changeRecorder ?: return
+        val journalPath = owner.configuration.backupJournalPath?.takeUnless { backupJournalInterrupted }
+        val changeLogPath = owner.configuration.changeLogPath
+        try {
+            if (changeLogPath == null && (journalPath == null || recorder.isEmpty())) {
+                return
+            }
+            val reference = realm.realmReference
+            val version = reference.version().version
+            val logChanges = changeLogPath != null && logMissingVersions(changeLogPath, version)
+            if (recorder.isEmpty()) {
+                return
+            }
+            val record = try {
+                recorder.encode(reference, version)
+            } catch (e: Throwable) {
+                journalPath?.let { interruptBackupJournal(it, e) }
+                changeLogPath?.let { interruptChangeLog(it, e) }
+                return
+            }
+            if (journalPath != null) {
+                try {
+                    appendBackupJournal(journalPath, record)
+                } catch (e: Throwable) {
+                    interruptBackupJournal(journalPath, e)
+                }
+            }
+            if (changeLogPath != null && logChanges) {
+                try {
+                    appendChangeLog(changeLogPath, firstUnloggedVersion!!, record)
+                    firstUnloggedVersion = version + 1
+                } catch (e: Throwable) {
+                    interruptChangeLog(changeLogPath, e)
+                }
+            }
+        } finally {
+            recorder.clear()
+        }
+    }
+
+    // Appends a gap record to the change log if versions before the committed [version] are
+    // missing from it, either because they were committed outside of this writer or because
+    // logging them failed. Returns whether the changes of [version] can be logged.
+    private fun logMissingVersions(changeLogPath: String, version: Long): Boolean {
+        val lastVersion = lastCommittedVersion
+        lastCommittedVersion = version
+        val firstVersion = firstUnloggedVersion ?: version.also { firstUnloggedVersion = it }
+        if (!changeLogInterrupted.value && (lastVersion == null || lastVersion == version - 1)) {
+            return true
+        }
+        try {
+            appendChangeLogGap(changeLogPath, firstVersion, version - 1)
+        } catch (e: Throwable) {
+            interruptChangeLog(changeLogPath, e)
+            return false
+        }
+        firstUnloggedVersion = version
+        changeLogInterrupted.value = false
+        return true
+    }
+
+    private fun interruptBackupJournal(journalPath: String, cause: Throwable) {
+        backupJournalInterrupted = true
+        owner.log.error(cause, "Could not append the committed write transaction to the backup journal. Write a new backup snapshot to resume journaling: $journalPath")
+    }
+
+    private fun interruptChangeLog(changeLogPath: String, cause: Throwable) {
+        changeLogInterrupted.value = true
+        owner.log.error(cause, "Could not append the committed write transaction to the change log. A gap is logged for the missing versions with the next write transaction: $changeLogPath")
+    }
+
+    /**
+     * Write a backup snapshot of the latest version of the realm and start a new backup journal.
+     *
+     * The snapshot is written while holding the transaction lock, so no transaction is committed
+     * between the snapshot and resetting the journal. The snapshot is written with [writeCopy], as
+     * writing copies of a realm is only available through JNI.
+     */
+    suspend fun writeBackupSnapshot(
+        path: String,
+        writeCopy: (dbPointer: NativePointer, path: String, encryptionKey: ByteArray?) -> Unit
+    ) {
+        val journalPath = owner.configuration.backupJournalPath
+            ?: throw IllegalStateException("No backup journal is configured for this realm: ${owner.configuration.path}")
+        withContext(dispatcher) {
+            transactionMutex.withLock {
+                // The writer's realm is at the latest version committed through this realm while
+                // it is not in a transaction
+                writeCopy(realm.realmReference.dbPointer, path, owner.configuration.encryptionKey)
+                resetBackupJournal(journalPath)
+                backupJournalInterrupted = false
+            }
+        }
+    }
+
+    private fun reportLongTransaction(caller: TransactionCaller, elapsed: Duration) {
+        val threshold = owner.configuration.longTransactionThreshold ?: return
+        if (elapsed > threshold) {
+            owner.log.warn(
+                caller.stack,
+                "Write transaction in coroutine '${caller.coroutineName ?: "unnamed"}' held the write lock for ${elapsed.inWholeMilliseconds} ms: ${owner.configuration.path}"
+            )
+        }
+    }
+
+    private class TransactionCaller(val coroutineName: String?, val stack: Throwable)
+
     private fun <R> freezeWriteReturnValue(reference: RealmReference, result: R): R {
         return when (result) {
             // is RealmResults<*> -> result.freeze(this) as R
@@ -0,0 +1,35 @@
+package io.realm.internal.platform
+
+/**
+ * Returns whether a file exists at [path].
+ */
+expect fun fileExists(path: String): Boolean
+
+/**
+ * Replaces the content of the file at [path] with [bytes], creating the file if it does not exist.
+ * The file is synced to disk before returning.
+ */
+expect fun writeFile(path: String, bytes: ByteArray)
+
+/**
+ * Appends [bytes] to the file at [path], creating the file if it does not exist. If [sync] is set
+ * the file is synced to disk before returning.
+ */
+expect fun appendFile(path: String, bytes: ByteArray, sync: Boolean)
+
+/**
+ * Returns the content of the file at [path].
+ */
+expect fun readFile(path: String): ByteArray
+
+/**
+ * Returns up to [length] bytes of the file at [path] starting at [offset]. Fewer bytes are returned
+ * if the file ends before.
+ */
+expect fun readFile(path: String, offset: Long, length: Int): ByteArray
+
+/**
+ * Copies the file at [source] to a new file at [target] without reading it into memory in full.
+ * No file may exist at [target].
+ */
+expect fun copyFile(source: String, target: String)
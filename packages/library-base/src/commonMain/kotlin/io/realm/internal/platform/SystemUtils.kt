@@ -54,3 +54,8 @@ expect fun Any.ensureNeverFrozen()
  * Return the current thread id.
  */
 expect fun threadId(): ULong
+
+/**
+ * Returns the value of a monotonic clock in nanoseconds. Only meaningful for measuring elapsed time.
+ */
+expect fun monotonicTimeNanos(): Long
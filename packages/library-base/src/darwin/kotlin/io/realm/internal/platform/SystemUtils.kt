@@ -12,6 +12,7 @@ import platform.posix.pthread_threadid_np
 import kotlin.native.concurrent.ensureNeverFrozen
 import kotlin.native.concurrent.freeze
 import kotlin.native.concurrent.isFrozen
+import kotlin.system.getTimeNanos
 
 @Suppress("MayBeConst") // Cannot make expect/actual const
 actual val RUNTIME: String = "Native"
@@ -30,6 +31,8 @@ actual fun threadId(): ULong {
     }
 }
 
+actual fun monotonicTimeNanos(): Long = getTimeNanos()
+
 actual fun <T> T.freeze(): T = this.freeze()
 
 actual val <T> T.isFrozen: Boolean
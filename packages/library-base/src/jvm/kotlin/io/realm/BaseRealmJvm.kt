@@ -0,0 +1,56 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.BaseRealmImpl
+import io.realm.internal.interop.RealmInterop
+
+/**
+ * Makes an unmanaged in-memory copy of a managed object and the objects it links to.
+ *
+ * The object graph is serialized natively in a single pass and decoded into new unmanaged
+ * instances, so properties are not read one by one through the managed accessors. Objects
+ * reachable through multiple links, including cyclic references, are only copied once and the
+ * copies keep referencing the same instance.
+ *
+ * Changes to the copies are not persisted.
+ *
+ * @param obj the managed object to copy.
+ * @param depth the number of links followed from [obj]. Links beyond this depth are `null` and
+ * lists of objects beyond this depth are empty in the copies.
+ * @return an unmanaged copy of [obj].
+ * @throws IllegalArgumentException if [obj] is unmanaged or [depth] is negative.
+ * @throws IllegalStateException if [obj] is invalid or its realm is closed.
+ */
+fun <T : RealmObject> BaseRealm.copyFromRealm(obj: T, depth: Int = Int.MAX_VALUE): T {
+    return (this as BaseRealmImpl).copyFromRealm(obj, depth, RealmInterop::realm_object_copy_packed)
+}
+
+/**
+ * Makes unmanaged in-memory copies of the objects of [results] and the objects they link to.
+ * Objects are copied as described for copying a single object, with all copies sharing the
+ * instances of objects reachable from multiple objects of [results].
+ *
+ * @param results the results to copy.
+ * @param depth the number of links followed from the objects of [results].
+ * @return unmanaged copies of the objects of [results] in the same order.
+ * @throws IllegalArgumentException if [depth] is negative.
+ * @throws IllegalStateException if the realm of [results] is closed.
+ */
+fun <T : RealmObject> BaseRealm.copyFromRealm(results: RealmResults<T>, depth: Int = Int.MAX_VALUE): List<T> {
+    return (this as BaseRealmImpl).copyFromRealm(results, depth, RealmInterop::realm_results_copy_packed)
+}
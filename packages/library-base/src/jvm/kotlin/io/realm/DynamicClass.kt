@@ -0,0 +1,117 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.interop.ClassKey
+import io.realm.internal.interop.ColumnKey
+
+/**
+ * The types of the properties of [DynamicClass]es. Integral properties of all sizes are [INT] and
+ * read as [Long]s.
+ */
+public enum class DynamicPropertyType {
+    INT,
+    BOOLEAN,
+    FLOAT,
+    DOUBLE,
+    STRING,
+    OBJECT,
+    UNSUPPORTED,
+}
+
+/**
+ * A property of a [DynamicClass].
+ */
+public class DynamicProperty internal constructor(
+    /**
+     * The name of the property.
+     */
+    public val name: String,
+    /**
+     * The type of the property or of the elements of a list.
+     */
+    public val type: DynamicPropertyType,
+    /**
+     * Whether the property is a list.
+     */
+    public val isList: Boolean,
+    /**
+     * Whether the property or the elements of a list can be null.
+     */
+    public val isNullable: Boolean,
+    /**
+     * The name of the class linked to by [DynamicPropertyType.OBJECT] properties, otherwise null.
+     */
+    public val linkTarget: String?,
+    internal val key: ColumnKey,
+) {
+    override fun toString(): String {
+        val element = (linkTarget ?: type.name) + if (isNullable) "?" else ""
+        return if (isList) "$name: List<$element>" else "$name: $element"
+    }
+}
+
+/**
+ * A class of the schema of a [DynamicRealm].
+ *
+ * Properties are addressed by their index in [properties], which can be looked up once with
+ * [propertyIndex] and passed to the index-based accessors of [DynamicRealmObject] to avoid looking
+ * up the property by name for every object.
+ */
+public class DynamicClass internal constructor(
+    /**
+     * The name of the class.
+     */
+    public val name: String,
+    /**
+     * The name of the primary key property, or null if the class has no primary key.
+     */
+    public val primaryKey: String?,
+    /**
+     * Whether objects of the class are embedded in their parent objects.
+     */
+    public val isEmbedded: Boolean,
+    /**
+     * The persisted properties of the class.
+     */
+    public val properties: List<DynamicProperty>,
+    internal val key: ClassKey,
+) {
+    private val indices: Map<String, Int> = properties.withIndex().associate { it.value.name to it.index }
+
+    // Rows only hold the values of readable properties, so slots maps the index of a property to
+    // its column in rows or -1 for unsupported properties
+    private val readable = properties.filter { it.type != DynamicPropertyType.UNSUPPORTED }
+    internal val columns: List<ColumnKey> = readable.map { it.key }
+    internal val linkColumns: BooleanArray = readable.map { it.type == DynamicPropertyType.OBJECT }.toBooleanArray()
+    internal val slots: IntArray = IntArray(properties.size).also { slots ->
+        var column = 0
+        properties.forEachIndexed { index, property ->
+            slots[index] = if (property.type == DynamicPropertyType.UNSUPPORTED) -1 else column++
+        }
+    }
+
+    /**
+     * Returns the index of [property] in [properties].
+     *
+     * @throws IllegalArgumentException if the class has no property named [property].
+     */
+    public fun propertyIndex(property: String): Int =
+        indices[property] ?: throw IllegalArgumentException("Class '$name' has no property '$property'")
+
+    override fun toString(): String = "$name $properties"
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.DynamicRealmImpl
+
+/**
+ * A dynamic realm gives read access to an arbitrary realm file without compiled model classes, e.g.
+ * for tooling and admin endpoints. Classes and properties are discovered from the schema stored in
+ * the file and objects are exposed as [DynamicRealmObject]s with generic accessors.
+ *
+ * A dynamic realm is a snapshot of the version of the realm at the time it was opened, so it does
+ * not observe later writes. Objects are read in batches of rows that are decoded in a single pass,
+ * which keeps iterating over all objects of a class close to the cost of generated accessors.
+ *
+ * Properties of types other than integers, booleans, floats, doubles, strings and links, or lists
+ * of these, are part of the schema as [DynamicPropertyType.UNSUPPORTED] but cannot be read.
+ */
+public interface DynamicRealm {
+
+    public companion object {
+        /**
+         * Number of rows decoded at a time when reading [DynamicRealmResults].
+         */
+        public const val ROW_BATCH_SIZE: Int = 1000
+
+        /**
+         * Opens the realm file at [path] read-only. Other processes and realm instances can keep
+         * writing to the file while it is open.
+         *
+         * @param path the path of the realm file.
+         * @param encryptionKey the 64 byte key the file is encrypted with, if any.
+         * @throws IllegalArgumentException if the file cannot be opened, e.g. because it does not
+         * exist or [encryptionKey] is wrong.
+         */
+        public fun open(path: String, encryptionKey: ByteArray? = null): DynamicRealm {
+            return DynamicRealmImpl(path, encryptionKey)
+        }
+    }
+
+    /**
+     * The path of the realm file.
+     */
+    public val path: String
+
+    /**
+     * The classes of the schema of the realm by name.
+     */
+    public val schema: Map<String, DynamicClass>
+
+    /**
+     * Returns all objects of the class named [className].
+     *
+     * @throws IllegalArgumentException if the class is not part of the schema.
+     */
+    public fun objects(className: String): DynamicRealmResults
+
+    /**
+     * Returns the objects of the class named [className] matching [query], a query in the Realm
+     * Query Language where `$0`, `$1`, ... refer to [args].
+     *
+     * @throws IllegalArgumentException if the class is not part of the schema or the query is
+     * invalid.
+     */
+    public fun query(className: String, query: String, vararg args: Any?): DynamicRealmResults
+
+    /**
+     * Closes the realm. Rows that have already been read stay accessible, but links that have not
+     * been resolved yet and further rows of results cannot be read anymore.
+     */
+    public fun close()
+
+    /**
+     * Returns whether the realm has been closed.
+     */
+    public fun isClosed(): Boolean
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+/**
+ * Returns a human readable description of the schema of the realm with the number of objects of
+ * each class, e.g. for inspecting realm files of unknown origin.
+ */
+public fun DynamicRealm.inspect(): String = buildString {
+    append(path).append('\n')
+    schema.values.sortedBy { it.name }.forEach { dynamicClass ->
+        append(dynamicClass.name)
+        if (dynamicClass.isEmbedded) {
+            append(" (embedded)")
+        }
+        append(": ").append(objects(dynamicClass.name).size).append(" objects\n")
+        dynamicClass.properties.forEach { property ->
+            append("  ").append(property)
+            if (property.name == dynamicClass.primaryKey) {
+                append(" (primary key)")
+            }
+            if (property.type == DynamicPropertyType.UNSUPPORTED) {
+                append(" (unsupported)")
+            }
+            append('\n')
+        }
+    }
+}
+
+/**
+ * Writes the objects of the class named [className] to [out] as newline delimited JSON, one object
+ * per line with a member per property, so it can be imported again with [importJson].
+ *
+ * Links and elements of lists of links are written as the primary key of the target object, or
+ * its object key if the target class has no primary key. Non-finite floating point values are
+ * written as strings and properties of unsupported types are omitted.
+ *
+ * @param className the class of the objects to write.
+ * @param out the destination of the JSON lines.
+ * @param limit the maximum number of objects to write.
+ * @return the number of objects written.
+ * @throws IllegalArgumentException if the class is not part of the schema.
+ */
+public fun DynamicRealm.dumpJson(className: String, out: Appendable, limit: Long = Long.MAX_VALUE): Long {
+    val objects = objects(className)
+    val dynamicClass = objects.dynamicClass
+    val count = minOf(objects.size.toLong(), limit).toInt()
+    val readable = dynamicClass.properties.indices.filter {
+        dynamicClass.properties[it].type != DynamicPropertyType.UNSUPPORTED
+    }
+    for (i in 0 until count) {
+        val obj = objects[i]
+        out.append('{')
+        readable.forEachIndexed { n, index ->
+            if (n > 0) {
+                out.append(',')
+            }
+            appendJsonString(out, dynamicClass.properties[index].name)
+            out.append(':')
+            appendJsonValue(out, obj[index])
+        }
+        out.append("}\n")
+    }
+    return count.toLong()
+}
+
+private fun appendJsonValue(out: Appendable, value: Any?) {
+    when (value) {
+        null -> out.append("null")
+        is String -> appendJsonString(out, value)
+        is Float -> if (value.isFinite()) out.append(value.toString()) else appendJsonString(out, value.toString())
+        is Double -> if (value.isFinite()) out.append(value.toString()) else appendJsonString(out, value.toString())
+        is Long, is Boolean -> out.append(value.toString())
+        is DynamicRealmObject -> {
+            val primaryKey = value.dynamicClass.primaryKey
+            appendJsonValue(out, if (primaryKey != null) value[primaryKey] else value.objectKey)
+        }
+        is List<*> -> {
+            out.append('[')
+            value.forEachIndexed { i, element ->
+                if (i > 0) {
+                    out.append(',')
+                }
+                appendJsonValue(out, element)
+            }
+            out.append(']')
+        }
+        else -> throw IllegalArgumentException("Unsupported value type: ${value::class.simpleName}")
+    }
+}
+
+private fun appendJsonString(out: Appendable, value: String) {
+    out.append('"')
+    for (c in value) {
+        when (c) {
+            '"' -> out.append("\\\"")
+            '\\' -> out.append("\\\\")
+            '\n' -> out.append("\\n")
+            '\r' -> out.append("\\r")
+            '\t' -> out.append("\\t")
+            else -> if (c < ' ') {
+                out.append("\\u").append(c.code.toString(16).padStart(4, '0'))
+            } else {
+                out.append(c)
+            }
+        }
+    }
+    out.append('"')
+}
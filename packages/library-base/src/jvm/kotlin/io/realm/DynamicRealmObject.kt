@@ -0,0 +1,184 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.DynamicRealmImpl
+
+/**
+ * An object of a [DynamicRealm] with generic accessors for the properties of its [dynamicClass].
+ *
+ * Properties are addressed by name or by their index in [DynamicClass.properties]. Values are
+ * [Long]s for integral properties, [Boolean]s, [Float]s, [Double]s, [String]s,
+ * [DynamicRealmObject]s for links and [List]s of these for lists, or null.
+ *
+ * The values of the object are decoded when its row is read, while links are resolved when they
+ * are accessed the first time. All links of a list are resolved at once.
+ */
+public class DynamicRealmObject internal constructor(
+    private val realm: DynamicRealmImpl,
+    /**
+     * The class of the object.
+     */
+    public val dynamicClass: DynamicClass,
+    /**
+     * The key of the object, which identifies it within its class.
+     */
+    public val objectKey: Long,
+    private val values: Array<Any?>,
+) {
+
+    /**
+     * The name of the class of the object.
+     */
+    public val className: String
+        get() = dynamicClass.name
+
+    /**
+     * Returns the value of the property at [index] in [DynamicClass.properties].
+     *
+     * @throws IndexOutOfBoundsException if there is no property at [index].
+     * @throws UnsupportedOperationException if the property has an unsupported type.
+     * @throws IllegalStateException if the property is an unresolved link and the realm has been
+     * closed.
+     */
+    public operator fun get(index: Int): Any? {
+        val property = dynamicClass.properties[index]
+        val slot = dynamicClass.slots[index]
+        if (slot < 0) {
+            throw UnsupportedOperationException("Property '${dynamicClass.name}.${property.name}' has an unsupported type")
+        }
+        val value = values[slot]
+        return if (value is DynamicRealmImpl.UnresolvedLinks) {
+            realm.resolve(property, value).also { values[slot] = it }
+        } else {
+            value
+        }
+    }
+
+    /**
+     * Returns the value of [property].
+     *
+     * @throws IllegalArgumentException if the class has no property named [property].
+     * @see get
+     */
+    public operator fun get(property: String): Any? = get(dynamicClass.propertyIndex(property))
+
+    /**
+     * Returns the value of the integral property at [index].
+     *
+     * @throws IllegalArgumentException if the property is not an integral property.
+     */
+    public fun getLong(index: Int): Long? = get(index, DynamicPropertyType.INT) as Long?
+
+    /**
+     * Returns the value of the integral property named [property].
+     */
+    public fun getLong(property: String): Long? = getLong(dynamicClass.propertyIndex(property))
+
+    /**
+     * Returns the value of the boolean property at [index].
+     *
+     * @throws IllegalArgumentException if the property is not a boolean property.
+     */
+    public fun getBoolean(index: Int): Boolean? = get(index, DynamicPropertyType.BOOLEAN) as Boolean?
+
+    /**
+     * Returns the value of the boolean property named [property].
+     */
+    public fun getBoolean(property: String): Boolean? = getBoolean(dynamicClass.propertyIndex(property))
+
+    /**
+     * Returns the value of the float property at [index].
+     *
+     * @throws IllegalArgumentException if the property is not a float property.
+     */
+    public fun getFloat(index: Int): Float? = get(index, DynamicPropertyType.FLOAT) as Float?
+
+    /**
+     * Returns the value of the float property named [property].
+     */
+    public fun getFloat(property: String): Float? = getFloat(dynamicClass.propertyIndex(property))
+
+    /**
+     * Returns the value of the double property at [index].
+     *
+     * @throws IllegalArgumentException if the property is not a double property.
+     */
+    public fun getDouble(index: Int): Double? = get(index, DynamicPropertyType.DOUBLE) as Double?
+
+    /**
+     * Returns the value of the double property named [property].
+     */
+    public fun getDouble(property: String): Double? = getDouble(dynamicClass.propertyIndex(property))
+
+    /**
+     * Returns the value of the string property at [index].
+     *
+     * @throws IllegalArgumentException if the property is not a string property.
+     */
+    public fun getString(index: Int): String? = get(index, DynamicPropertyType.STRING) as String?
+
+    /**
+     * Returns the value of the string property named [property].
+     */
+    public fun getString(property: String): String? = getString(dynamicClass.propertyIndex(property))
+
+    /**
+     * Returns the object linked to by the property at [index].
+     *
+     * @throws IllegalArgumentException if the property is not a link.
+     */
+    public fun getObject(index: Int): DynamicRealmObject? = get(index, DynamicPropertyType.OBJECT) as DynamicRealmObject?
+
+    /**
+     * Returns the object linked to by the property named [property].
+     */
+    public fun getObject(property: String): DynamicRealmObject? = getObject(dynamicClass.propertyIndex(property))
+
+    /**
+     * Returns the elements of the list property at [index].
+     *
+     * @throws IllegalArgumentException if the property is not a list.
+     */
+    public fun getList(index: Int): List<Any?> {
+        if (!dynamicClass.properties[index].isList) {
+            throw IllegalArgumentException("Property '${dynamicClass.name}.${dynamicClass.properties[index].name}' is not a list")
+        }
+        @Suppress("UNCHECKED_CAST")
+        return get(index) as List<Any?>
+    }
+
+    /**
+     * Returns the elements of the list property named [property].
+     */
+    public fun getList(property: String): List<Any?> = getList(dynamicClass.propertyIndex(property))
+
+    private fun get(index: Int, type: DynamicPropertyType): Any? {
+        val property = dynamicClass.properties[index]
+        if (property.type != type || property.isList) {
+            throw IllegalArgumentException("Property '${dynamicClass.name}.${property.name}' is not of type $type: $property")
+        }
+        return get(index)
+    }
+
+    override fun equals(other: Any?): Boolean =
+        other is DynamicRealmObject && other.realm === realm && other.className == className && other.objectKey == objectKey
+
+    override fun hashCode(): Int = className.hashCode() * 31 + objectKey.hashCode()
+
+    override fun toString(): String = "$className[$objectKey]"
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.DynamicRealmImpl
+import io.realm.internal.interop.NativePointer
+
+/**
+ * The objects of a class of a [DynamicRealm] returned by [DynamicRealm.objects] and
+ * [DynamicRealm.query].
+ *
+ * Rows are read in batches of [DynamicRealm.ROW_BATCH_SIZE] consecutive objects, so iterating
+ * over the results crosses into native code once per batch instead of once per value.
+ */
+public class DynamicRealmResults internal constructor(
+    private val realm: DynamicRealmImpl,
+    /**
+     * The class of the objects.
+     */
+    public val dynamicClass: DynamicClass,
+    private val results: NativePointer,
+    override val size: Int,
+) : AbstractList<DynamicRealmObject>() {
+
+    private var batchStart = 0
+    private var batch: List<DynamicRealmObject> = emptyList()
+
+    /**
+     * Returns the object at [index].
+     *
+     * @throws IllegalStateException if the row of the object has not been read yet and the realm
+     * has been closed.
+     */
+    override fun get(index: Int): DynamicRealmObject {
+        if (index < 0 || index >= size) {
+            throw IndexOutOfBoundsException("Index: $index, size: $size")
+        }
+        if (index < batchStart || index >= batchStart + batch.size) {
+            batchStart = index - index % DynamicRealm.ROW_BATCH_SIZE
+            batch = realm.readRows(dynamicClass, results, batchStart, DynamicRealm.ROW_BATCH_SIZE)
+        }
+        return batch[index - batchStart]
+    }
+}
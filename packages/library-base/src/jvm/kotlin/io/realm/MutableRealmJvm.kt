@@ -0,0 +1,89 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.MutableRealmImpl
+import io.realm.internal.interop.RealmInterop
+import kotlin.reflect.KClass
+
+/**
+ * Stores the values of a string property as an enumeration.
+ *
+ * Enumerated properties keep each distinct value once and let the individual objects refer to it
+ * by a small integer. For properties with few distinct values across many objects, like a status
+ * or a country code, this reduces the file size and speeds up equality queries. The values of the
+ * property are not affected and it can still hold any string.
+ *
+ * The enumeration is persisted in the realm file when the write transaction is committed.
+ * Enumerating an already enumerated property has no effect.
+ *
+ * @param clazz the class containing the property.
+ * @param property the name of the string property to enumerate.
+ * @throws IllegalArgumentException if the class or property is not part of the schema or if the
+ * property is not a string property.
+ */
+fun <T : RealmObject> MutableRealm.enumerateStrings(clazz: KClass<T>, property: String) {
+    (this as MutableRealmImpl).updateColumn(
+        clazz,
+        property,
+        "Cannot enumerate property",
+        RealmInterop::realm_enumerate_string_column
+    )
+}
+
+/**
+ * Adds a search index to a property.
+ *
+ * This has the same effect as annotating the property with [io.realm.annotations.Index], but does
+ * not require a schema change, which makes it possible to evaluate indexes against the actual
+ * queries of an app, see [RealmResults.estimatedIndexUsage]. The index is persisted in the realm
+ * file when the write transaction is committed. Adding an index to an already indexed property has
+ * no effect.
+ *
+ * @param clazz the class containing the property.
+ * @param property the name of the property to index.
+ * @throws IllegalArgumentException if the class or property is not part of the schema or if the
+ * type of the property does not support search indexes.
+ */
+fun <T : RealmObject> MutableRealm.addSearchIndex(clazz: KClass<T>, property: String) {
+    (this as MutableRealmImpl).updateColumn(
+        clazz,
+        property,
+        "Cannot add search index to property",
+        RealmInterop::realm_add_search_index
+    )
+}
+
+/**
+ * Removes the search index of a property.
+ *
+ * Removing the index of a property that is not indexed has no effect. If the property is annotated
+ * with [io.realm.annotations.Index] the index is not added back until the schema is updated.
+ *
+ * @param clazz the class containing the property.
+ * @param property the name of the property to remove the index from.
+ * @throws IllegalArgumentException if the class or property is not part of the schema or if the
+ * property is the primary key.
+ */
+fun <T : RealmObject> MutableRealm.removeSearchIndex(clazz: KClass<T>, property: String) {
+    (this as MutableRealmImpl).updateColumn(
+        clazz,
+        property,
+        "Cannot remove search index from property",
+        RealmInterop::realm_remove_search_index
+    )
+}
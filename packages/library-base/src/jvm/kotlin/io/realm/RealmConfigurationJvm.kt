@@ -0,0 +1,47 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.SchemaMigrationSetup
+import io.realm.internal.interop.RealmInterop
+
+/**
+ * Sets the bulk operations that migrate the data of the realm when it is opened with a higher
+ * [RealmConfiguration.SharedBuilder.schemaVersion] than the one it was written with. The
+ * operations run natively inside the write transaction that updates the schema, so they scale to
+ * millions of objects. If an operation fails, opening the realm throws and the realm is left
+ * unchanged.
+ *
+ * Properties that are added or removed without an operation are still added with their default
+ * value or removed when the schema is updated.
+ *
+ * Cannot be combined with [RealmConfiguration.SharedBuilder.deleteRealmIfMigrationNeeded],
+ * [RealmConfiguration.SharedBuilder.backupJournal] or [RealmConfiguration.SharedBuilder.changeLog],
+ * as the objects rewritten by the migration are not recorded in the journal or the change log.
+ *
+ * @param migration the operations to run.
+ * @param onProgress callback invoked on the thread opening the realm with the index of the running
+ * operation, the number of objects it has processed and the total number of objects it processes.
+ * It is called every few thousand objects and when an operation completes. Exceptions thrown by
+ * the callback abort the migration and are rethrown by [Realm.open].
+ */
+fun <S : RealmConfiguration.SharedBuilder<*, S>> S.migration(
+    migration: SchemaMigration,
+    onProgress: ((operation: Int, processedObjects: Long, totalObjects: Long) -> Unit)? = null
+): S {
+    return schemaMigration(SchemaMigrationSetup(migration, onProgress, RealmInterop::realm_config_set_schema_migration))
+}
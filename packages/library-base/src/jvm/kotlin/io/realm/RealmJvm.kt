@@ -0,0 +1,178 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.JsonImporter
+import io.realm.internal.RealmImpl
+import io.realm.internal.genericRealmCoreExceptionHandler
+import io.realm.internal.interop.ClassKey
+import io.realm.internal.interop.NativePointer
+import io.realm.internal.interop.RealmCoreException
+import io.realm.internal.interop.RealmInterop
+import java.io.OutputStream
+import kotlin.reflect.KClass
+
+/**
+ * Default number of objects imported in each write transaction by [importJson].
+ */
+const val DEFAULT_JSON_IMPORT_BATCH_SIZE: Int = 10_000
+
+/**
+ * Writes a compacted copy of the current version of the realm to a new file at [path].
+ *
+ * The copy is written from the frozen version of the realm, so it is consistent and writes to the
+ * realm can continue while it is being written. Only the data of the version is copied, which
+ * leaves out any unused space of the realm file.
+ *
+ * @param path the path of the copy. No file may exist at the path.
+ * @param encryptionKey the 64 byte key used to encrypt the copy, or `null` to write an unencrypted
+ * copy.
+ * @throws IllegalArgumentException if a file already exists at [path] or if the encryption key is
+ * not 64 bytes.
+ */
+fun Realm.writeCopyTo(path: String, encryptionKey: ByteArray? = null) {
+    (this as RealmImpl).writeCopyTo(path, encryptionKey, RealmInterop::realm_write_copy_to_path)
+}
+
+/**
+ * Streams a compacted, unencrypted copy of the current version of the realm to [sink] in chunks.
+ *
+ * The copy is consistent and written without blocking writes to the realm like [writeCopyTo]. The
+ * data is never held in memory in full. The sink receives a buffer that is reused between chunks,
+ * so only the first `length` bytes are part of the copy and the buffer must not be retained.
+ * Exceptions thrown by the sink abort the copy and are rethrown.
+ *
+ * @param sink function receiving the chunks of the copy in order.
+ */
+fun Realm.writeCopyTo(sink: (buffer: ByteArray, length: Int) -> Unit) {
+    (this as RealmImpl).writeCopyTo(sink, RealmInterop::realm_write_copy_to_sink)
+}
+
+/**
+ * Streams a compacted, unencrypted copy of the current version of the realm to [outputStream].
+ *
+ * The copy is consistent and written in chunks without blocking writes to the realm. A copy can be
+ * written to a file descriptor by wrapping it in a [java.io.FileOutputStream]. The stream is
+ * neither flushed nor closed.
+ *
+ * @param outputStream the stream to write the copy to.
+ * @throws java.io.IOException if writing to the stream fails.
+ * @see writeCopyTo
+ */
+fun Realm.writeCopyTo(outputStream: OutputStream) {
+    writeCopyTo { buffer, length -> outputStream.write(buffer, 0, length) }
+}
+
+/**
+ * Writes a backup snapshot of the latest version of the realm to a new file at [path] and starts a
+ * new, empty backup journal at [RealmConfiguration.backupJournalPath]. The snapshot and the journal
+ * together can be restored with [Realm.restoreBackup].
+ *
+ * The snapshot is a compacted copy of the realm like [writeCopyTo], encrypted with the
+ * encryption key of the realm, if any. Write transactions are blocked while the snapshot is
+ * written, so no transaction is left out of both the snapshot and the journal. The previous
+ * journal is discarded, so the previous snapshot and journal should only be deleted after the new
+ * snapshot has been backed up.
+ *
+ * @param path the path of the snapshot. No file may exist at the path.
+ * @throws IllegalStateException if no backup journal is configured with
+ * [RealmConfiguration.Builder.backupJournal] or if called from inside a write transaction.
+ * @throws IllegalArgumentException if a file already exists at [path].
+ */
+fun Realm.writeBackupSnapshot(path: String) {
+    (this as RealmImpl).writeBackupSnapshot(path, RealmInterop::realm_write_copy_to_path)
+}
+
+/**
+ * Import objects of a class from a file of newline delimited JSON, with one JSON object per line.
+ *
+ * The file is parsed natively and streamed into the realm in batches of [batchSize] objects, each
+ * committed in its own write transaction on the Realm Write Dispatcher, so no intermediate Kotlin
+ * objects are created.
+ *
+ * Members of the JSON objects are mapped to the properties of the class by name and unknown
+ * members are ignored. Objects of classes with a primary key are upserted by their primary key,
+ * which must be present on each line. Links and lists of links are given as the primary keys of
+ * the target objects, which are created if they do not exist yet. Properties missing from a line
+ * keep their current value, or the default value of their type for new objects; default values of
+ * the model class are not applied.
+ *
+ * If a line cannot be imported, the batch containing it is rolled back, while the previous batches
+ * stay committed.
+ *
+ * NOTE: Importing JSON is currently not supported for realms configured with a backup journal or a
+ * change log.
+ *
+ * @param clazz the class of the imported objects.
+ * @param path the path of the file to import.
+ * @param batchSize the number of objects imported in each write transaction.
+ * @param onProgress callback invoked on the Realm Write Dispatcher after each committed batch with
+ * the total number of imported objects and bytes read so far.
+ * @return the number of objects imported.
+ * @throws IllegalArgumentException if [batchSize] is not positive, if the class is not part of the
+ * schema, if the file cannot be read, or if a line is not a JSON object matching the class.
+ * @throws IllegalStateException if the realm is configured with a backup journal or a change log.
+ */
+suspend fun <T : RealmObject> Realm.importJson(
+    clazz: KClass<T>,
+    path: String,
+    batchSize: Int = DEFAULT_JSON_IMPORT_BATCH_SIZE,
+    onProgress: (importedObjects: Long, bytesRead: Long) -> Unit = { _, _ -> }
+): Long {
+    return (this as RealmImpl).importJson(clazz, path, batchSize, onProgress) {
+        val importer = try {
+            RealmInterop.realm_ndjson_importer_from_file(path)
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Could not open JSON file: $path", exception)
+        }
+        NdjsonImporter(importer)
+    }
+}
+
+/**
+ * Import objects of a class from a buffer of UTF-8 encoded newline delimited JSON, with one JSON
+ * object per line. The objects are imported as described for importing from a file.
+ *
+ * @param clazz the class of the imported objects.
+ * @param json the newline delimited JSON to import.
+ * @param batchSize the number of objects imported in each write transaction.
+ * @param onProgress callback invoked on the Realm Write Dispatcher after each committed batch with
+ * the total number of imported objects and bytes read so far.
+ * @return the number of objects imported.
+ * @throws IllegalArgumentException if [batchSize] is not positive, if the class is not part of the
+ * schema, or if a line is not a JSON object matching the class.
+ * @throws IllegalStateException if the realm is configured with a backup journal or a change log.
+ */
+suspend fun <T : RealmObject> Realm.importJson(
+    clazz: KClass<T>,
+    json: ByteArray,
+    batchSize: Int = DEFAULT_JSON_IMPORT_BATCH_SIZE,
+    onProgress: (importedObjects: Long, bytesRead: Long) -> Unit = { _, _ -> }
+): Long {
+    return (this as RealmImpl).importJson(clazz, "buffer", batchSize, onProgress) {
+        NdjsonImporter(RealmInterop.realm_ndjson_importer_from_buffer(json))
+    }
+}
+
+private class NdjsonImporter(private val importer: NativePointer) : JsonImporter {
+
+    override val bytesRead: Long
+        get() = RealmInterop.realm_ndjson_importer_bytes_read(importer)
+
+    override fun importBatch(realm: NativePointer, classKey: ClassKey, maxObjects: Long): Long =
+        RealmInterop.realm_ndjson_importer_import(importer, realm, classKey, maxObjects)
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm
+
+import io.realm.internal.RealmResultsImpl
+import io.realm.internal.interop.RealmInterop
+import java.nio.ByteBuffer
+
+/**
+ * The default number of objects per record batch of [exportArrow].
+ */
+const val DEFAULT_ARROW_BATCH_SIZE: Int = 64 * 1024
+
+/**
+ * Exports the [properties] of the objects of these results to a new file at [path] in the
+ * [Apache Arrow IPC streaming format](https://arrow.apache.org/docs/format/Columnar.html#ipc-streaming-format).
+ *
+ * The columnar data is written natively in record batches of at most [batchSize] objects, without
+ * reading the objects into Kotlin. Int, boolean, float, double and string properties can be
+ * exported, which are written as the Arrow Int64, Bool, Float32, Float64 and Utf8 types. Nullable
+ * properties are written as nullable fields.
+ *
+ * @param path the path of the export. No file may exist at the path.
+ * @param properties the names of the properties to export, in the order of the Arrow fields.
+ * @param batchSize the maximum number of objects per record batch.
+ * @throws IllegalArgumentException if a file already exists at [path], if [properties] is empty
+ * or contains a property that does not exist or cannot be exported, or if [batchSize] is not
+ * positive.
+ */
+fun RealmResults<*>.exportArrow(path: String, properties: List<String>, batchSize: Int = DEFAULT_ARROW_BATCH_SIZE) {
+    (this as RealmResultsImpl<*>).exportArrow(path, properties, batchSize, RealmInterop::realm_results_export_arrow_to_path)
+}
+
+/**
+ * Streams the [properties] of the objects of these results to [sink] in the Apache Arrow IPC
+ * streaming format.
+ *
+ * The stream is written like [exportArrow] and handed to the sink in chunks. The sink receives a
+ * buffer that is reused between chunks, so only the first `length` bytes are part of the stream
+ * and the buffer must not be retained. Exceptions thrown by the sink abort the export and are
+ * rethrown.
+ *
+ * @param properties the names of the properties to export, in the order of the Arrow fields.
+ * @param batchSize the maximum number of objects per record batch.
+ * @param sink function receiving the chunks of the stream in order.
+ * @throws IllegalArgumentException if [properties] is empty or contains a property that does not
+ * exist or cannot be exported, or if [batchSize] is not positive.
+ */
+fun RealmResults<*>.exportArrow(
+    properties: List<String>,
+    batchSize: Int = DEFAULT_ARROW_BATCH_SIZE,
+    sink: (buffer: ByteArray, length: Int) -> Unit
+) {
+    (this as RealmResultsImpl<*>).exportArrow(properties, batchSize, sink, RealmInterop::realm_results_export_arrow_to_sink)
+}
+
+/**
+ * Writes the [properties] of the objects of these results to [buffer] in the Apache Arrow IPC
+ * streaming format, starting at its position.
+ *
+ * The stream is written in chunks like [exportArrow], so a direct buffer can be handed
+ * on to native Arrow readers without the objects being read into Kotlin. The position of the buffer
+ * is advanced past the stream.
+ *
+ * @param buffer the buffer to write the stream to.
+ * @param properties the names of the properties to export, in the order of the Arrow fields.
+ * @param batchSize the maximum number of objects per record batch.
+ * @throws java.nio.BufferOverflowException if the stream does not fit in the remaining space of
+ * the buffer.
+ * @see exportArrow
+ */
+fun RealmResults<*>.exportArrow(
+    buffer: ByteBuffer,
+    properties: List<String>,
+    batchSize: Int = DEFAULT_ARROW_BATCH_SIZE
+) {
+    exportArrow(properties, batchSize) { chunk, length -> buffer.put(chunk, 0, length) }
+}
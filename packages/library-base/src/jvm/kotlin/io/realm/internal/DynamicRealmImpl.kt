@@ -0,0 +1,193 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.internal
+
+import io.realm.DynamicClass
+import io.realm.DynamicProperty
+import io.realm.DynamicPropertyType
+import io.realm.DynamicRealm
+import io.realm.DynamicRealmObject
+import io.realm.DynamicRealmResults
+import io.realm.internal.interop.ClassKey
+import io.realm.internal.interop.ColumnKey
+import io.realm.internal.interop.NativePointer
+import io.realm.internal.interop.RealmCoreException
+import io.realm.internal.interop.RealmInterop
+import io.realm.internal.interop.SchemaMode
+import io.realm.internal.platform.fileExists
+
+/*
+ * The schema and rows of a dynamic realm are written natively in the format of backup journals.
+ *
+ * The schema is the number of classes followed by the name, class key, primary key ("" if none),
+ * embedded flag and number of properties of each class and, per property, its name, column key,
+ * type byte, list flag, nullable flag and link target ("" if none). Type bytes are the value tags
+ * of the property type or 0 for unsupported types.
+ *
+ * Rows are the object key followed by a tagged value per requested column, where links are
+ * [TAG_OBJECT] followed by the object key of the target.
+ */
+internal class DynamicRealmImpl(
+    override val path: String,
+    encryptionKey: ByteArray?,
+) : DynamicRealm {
+
+    /**
+     * Links of a row that are resolved to [DynamicRealmObject]s when they are first accessed.
+     */
+    internal class UnresolvedLinks(val objectKeys: LongArray, val isList: Boolean)
+
+    private var dbPointer: NativePointer? = open(path, encryptionKey)
+
+    override val schema: Map<String, DynamicClass> = readSchema()
+
+    override fun objects(className: String): DynamicRealmResults =
+        query(className, "TRUEPREDICATE")
+
+    override fun query(className: String, query: String, vararg args: Any?): DynamicRealmResults {
+        val dynamicClass = dynamicClass(className)
+        val results = try {
+            val queryPointer = RealmInterop.realm_query_parse(checkClosed(), className, query, *args)
+            RealmInterop.realm_query_find_all(queryPointer)
+        } catch (exception: RealmCoreException) {
+            throw genericRealmCoreExceptionHandler("Invalid query '$query' on class '$className'", exception)
+        }
+        val size = RealmInterop.realm_results_count(results)
+        return DynamicRealmResults(this, dynamicClass, results, size.toInt())
+    }
+
+    override fun close() {
+        dbPointer?.let { RealmInterop.realm_close(it) }
+        dbPointer = null
+    }
+
+    override fun isClosed(): Boolean = dbPointer == null
+
+    internal fun readRows(
+        dynamicClass: DynamicClass,
+        results: NativePointer,
+        offset: Int,
+        count: Int
+    ): List<DynamicRealmObject> {
+        checkClosed()
+        val data = readPacked {
+            RealmInterop.realm_results_read_rows(results, dynamicClass.columns, offset.toLong(), count.toLong(), it)
+        }
+        return decodeRows(dynamicClass, data)
+    }
+
+    internal fun resolve(property: DynamicProperty, links: UnresolvedLinks): Any? {
+        if (links.objectKeys.isEmpty()) {
+            return if (links.isList) emptyList<DynamicRealmObject>() else null
+        }
+        val target = dynamicClass(property.linkTarget!!)
+        val data = readPacked {
+            RealmInterop.realm_read_rows(checkClosed(), target.key, links.objectKeys, target.columns, it)
+        }
+        val objects = decodeRows(target, data)
+        return if (links.isList) objects else objects.firstOrNull()
+    }
+
+    private fun decodeRows(dynamicClass: DynamicClass, data: ByteArray): List<DynamicRealmObject> {
+        val decoder = JournalDecoder(data)
+        val links = dynamicClass.linkColumns
+        val objects = mutableListOf<DynamicRealmObject>()
+        while (decoder.remaining() > 0) {
+            val objectKey = decoder.readLong()
+            val values = Array(links.size) { column ->
+                if (links[column]) decodeLinks(decoder) else decoder.readValue()
+            }
+            objects.add(DynamicRealmObject(this, dynamicClass, objectKey, values))
+        }
+        return objects
+    }
+
+    private fun decodeLinks(decoder: JournalDecoder): UnresolvedLinks? {
+        return when (decoder.readByte()) {
+            TAG_OBJECT -> UnresolvedLinks(longArrayOf(decoder.readLong()), false)
+            TAG_LIST -> {
+                // Unresolved links of lists are written as null and skipped like in core
+                val objectKeys = mutableListOf<Long>()
+                repeat(decoder.readInt()) {
+                    if (decoder.readByte() == TAG_OBJECT) {
+                        objectKeys.add(decoder.readLong())
+                    }
+                }
+                UnresolvedLinks(objectKeys.toLongArray(), true)
+            }
+            else -> null
+        }
+    }
+
+    private fun readSchema(): Map<String, DynamicClass> {
+        val decoder = JournalDecoder(readPacked { RealmInterop.realm_get_schema_packed(checkClosed(), it) })
+        return List(decoder.readInt()) {
+            val name = decoder.readString()
+            val classKey = ClassKey(decoder.readLong())
+            val primaryKey = decoder.readString().ifEmpty { null }
+            val isEmbedded = decoder.readByte() != 0.toByte()
+            val properties = List(decoder.readInt()) {
+                DynamicProperty(
+                    name = decoder.readString(),
+                    key = ColumnKey(decoder.readLong()),
+                    type = propertyType(decoder.readByte()),
+                    isList = decoder.readByte() != 0.toByte(),
+                    isNullable = decoder.readByte() != 0.toByte(),
+                    linkTarget = decoder.readString().ifEmpty { null },
+                )
+            }
+            DynamicClass(name, primaryKey, isEmbedded, properties, classKey)
+        }.associateBy { it.name }
+    }
+
+    private fun dynamicClass(className: String): DynamicClass =
+        schema[className] ?: throw IllegalArgumentException("Class '$className' is not part of the schema of $path")
+
+    private fun checkClosed(): NativePointer =
+        dbPointer ?: throw IllegalStateException("Dynamic realm at $path has been closed")
+
+    private companion object {
+        fun propertyType(type: Byte): DynamicPropertyType = when (type) {
+            TAG_INT -> DynamicPropertyType.INT
+            TAG_BOOLEAN -> DynamicPropertyType.BOOLEAN
+            TAG_FLOAT -> DynamicPropertyType.FLOAT
+            TAG_DOUBLE -> DynamicPropertyType.DOUBLE
+            TAG_STRING -> DynamicPropertyType.STRING
+            TAG_OBJECT -> DynamicPropertyType.OBJECT
+            else -> DynamicPropertyType.UNSUPPORTED
+        }
+
+        fun open(path: String, encryptionKey: ByteArray?): NativePointer {
+            if (!fileExists(path)) {
+                throw IllegalArgumentException("Realm file does not exist: $path")
+            }
+            val config = RealmInterop.realm_config_new()
+            RealmInterop.realm_config_set_path(config, path)
+            RealmInterop.realm_config_set_schema_mode(config, SchemaMode.RLM_SCHEMA_MODE_READ_ONLY_ALTERNATIVE)
+            encryptionKey?.let { RealmInterop.realm_config_set_encryption_key(config, it) }
+            val liveDbPointer = try {
+                RealmInterop.realm_open(config)
+            } catch (exception: RealmCoreException) {
+                throw IllegalArgumentException("Could not open realm file: $path", exception)
+            }
+            // Work on a frozen version like RealmImpl, so results and rows are stable
+            val frozenDbPointer = RealmInterop.realm_freeze(liveDbPointer)
+            RealmInterop.realm_close(liveDbPointer)
+            return frozenDbPointer
+        }
+    }
+}
@@ -0,0 +1,35 @@
+package io.realm.internal.platform
+
+import java.io.File
+import java.io.FileOutputStream
+import java.io.RandomAccessFile
+
+actual fun fileExists(path: String): Boolean = File(path).exists()
+
+actual fun writeFile(path: String, bytes: ByteArray) = writeFile(path, bytes, append = false, sync = true)
+
+actual fun appendFile(path: String, bytes: ByteArray, sync: Boolean) = writeFile(path, bytes, append = true, sync = sync)
+
+private fun writeFile(path: String, bytes: ByteArray, append: Boolean, sync: Boolean) {
+    FileOutputStream(path, append).use {
+        it.write(bytes)
+        if (sync) {
+            it.fd.sync()
+        }
+    }
+}
+
+actual fun readFile(path: String): ByteArray = File(path).readBytes()
+
+actual fun readFile(path: String, offset: Long, length: Int): ByteArray {
+    RandomAccessFile(path, "r").use { file ->
+        val bytes = ByteArray(minOf(length.toLong(), maxOf(file.length() - offset, 0)).toInt())
+        file.seek(offset)
+        file.readFully(bytes)
+        return bytes
+    }
+}
+
+actual fun copyFile(source: String, target: String) {
+    File(source).copyTo(File(target))
+}
@@ -7,6 +7,8 @@ actual fun threadId(): ULong {
     return Thread.currentThread().id.toULong()
 }
 
+actual fun monotonicTimeNanos(): Long = System.nanoTime()
+
 actual fun <T> T.freeze(): T = this
 
 actual val <T> T.isFrozen: Boolean
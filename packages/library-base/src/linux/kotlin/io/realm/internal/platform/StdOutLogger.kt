@@ -0,0 +1,55 @@
+package io.realm.internal.platform
+
+import io.realm.log.LogLevel
+import io.realm.log.RealmLogger
+
+/**
+ * Logger implementation outputting to stdout.
+ */
+internal class StdOutLogger(
+    override val tag: String = "REALM",
+    override val level: LogLevel
+) : RealmLogger {
+
+    override fun log(level: LogLevel, throwable: Throwable?, message: String?, vararg args: Any?) {
+        val logMessage: String = prepareLogMessage(throwable, message, *args)
+        println("${level.name}: [$tag] $logMessage")
+    }
+
+    private fun prepareLogMessage(
+        throwable: Throwable?,
+        message: String?,
+        vararg args: Any?
+    ): String {
+        var messageToLog = message
+        if (messageToLog.isNullOrEmpty()) {
+            if (throwable == null) {
+                return ""
+            }
+            messageToLog = dumpStackTrace(throwable)
+        } else {
+            if (args.isNotEmpty()) {
+                messageToLog = formatMessage(messageToLog, args)
+            }
+            if (throwable != null) {
+                messageToLog += "\n" + dumpStackTrace(throwable)
+            }
+        }
+        return messageToLog
+    }
+
+    private fun formatMessage(message: String, args: Array<out Any?>): String {
+        // Formatting a string with varargs is not supported in Kotlin Multiplatform right now,
+        // so just substitute the placeholders in order with the string representation of the
+        // arguments.
+        // See https://youtrack.jetbrains.com/issue/KT-25506
+        var index = 0
+        return "%[\\d|.]*[sdf]".toRegex().replace(message) {
+            if (index < args.size) args[index++].toString() else it.value
+        }
+    }
+
+    // TODO `throwable.stackTraceToString()` have a memory leak. See https://youtrack.jetbrains.com/issue/KT-46291.
+    //  So use a slimmed down version until it has been fixed.
+    private inline fun dumpStackTrace(throwable: Throwable): String = throwable.toString()
+}
@@ -0,0 +1,49 @@
+package io.realm.internal.platform
+
+import io.realm.log.LogLevel
+import io.realm.log.RealmLogger
+import kotlinx.cinterop.alloc
+import kotlinx.cinterop.memScoped
+import kotlinx.cinterop.ptr
+import kotlinx.cinterop.toKString
+import platform.posix.pthread_self
+import platform.posix.uname
+import platform.posix.utsname
+import kotlin.native.concurrent.ensureNeverFrozen
+import kotlin.native.concurrent.freeze
+import kotlin.native.concurrent.isFrozen
+import kotlin.system.getTimeNanos
+
+@Suppress("MayBeConst") // Cannot make expect/actual const
+actual val RUNTIME: String = "Native"
+actual val OS_NAME: String by lazy { systemName { sysname.toKString() } }
+actual val OS_VERSION: String by lazy { systemName { release.toKString() } }
+
+private fun systemName(block: utsname.() -> String): String {
+    memScoped {
+        val name = alloc<utsname>()
+        uname(name.ptr)
+        return block(name)
+    }
+}
+
+@Suppress("FunctionOnlyReturningConstant")
+actual fun appFilesDirectory(): String {
+    return "."
+}
+
+actual fun createDefaultSystemLogger(tag: String, logLevel: LogLevel): RealmLogger =
+    StdOutLogger(tag, logLevel)
+
+actual fun threadId(): ULong {
+    return pthread_self()
+}
+
+actual fun monotonicTimeNanos(): Long = getTimeNanos()
+
+actual fun <T> T.freeze(): T = this.freeze()
+
+actual val <T> T.isFrozen: Boolean
+    get() = this.isFrozen
+
+actual fun Any.ensureNeverFrozen() = this.ensureNeverFrozen()
@@ -14,7 +14,7 @@ public actual fun <T> runBlocking(
 }
 
 /**
- * The default dispatcher for Darwin platforms spawns a new thread with a run loop.
+ * The default dispatcher for native platforms spawns a new thread with a run loop.
  */
 actual fun singleThreadDispatcher(id: String): CoroutineDispatcher {
     return newSingleThreadContext(id)
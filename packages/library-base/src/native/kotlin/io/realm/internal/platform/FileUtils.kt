@@ -0,0 +1,143 @@
+package io.realm.internal.platform
+
+import kotlinx.cinterop.addressOf
+import kotlinx.cinterop.alloc
+import kotlinx.cinterop.convert
+import kotlinx.cinterop.memScoped
+import kotlinx.cinterop.ptr
+import kotlinx.cinterop.toKString
+import kotlinx.cinterop.usePinned
+import platform.posix.F_OK
+import platform.posix.O_APPEND
+import platform.posix.O_CLOEXEC
+import platform.posix.O_CREAT
+import platform.posix.O_EXCL
+import platform.posix.O_RDONLY
+import platform.posix.O_TRUNC
+import platform.posix.O_WRONLY
+import platform.posix.access
+import platform.posix.close
+import platform.posix.errno
+import platform.posix.fstat
+import platform.posix.fsync
+import platform.posix.open
+import platform.posix.pread
+import platform.posix.read
+import platform.posix.stat
+import platform.posix.strerror
+import platform.posix.write
+
+// rw-r--r--
+private const val FILE_MODE = 0x1a4
+private const val COPY_BUFFER_SIZE = 64 * 1024
+
+actual fun fileExists(path: String): Boolean = access(path, F_OK) == 0
+
+actual fun writeFile(path: String, bytes: ByteArray) = writeFile(path, bytes, O_TRUNC, sync = true)
+
+actual fun appendFile(path: String, bytes: ByteArray, sync: Boolean) = writeFile(path, bytes, O_APPEND, sync)
+
+private fun writeFile(path: String, bytes: ByteArray, mode: Int, sync: Boolean) {
+    val fd = openFile(path, O_WRONLY or O_CREAT or mode)
+    try {
+        writeFully(fd, path, bytes, bytes.size)
+        if (sync && fsync(fd) != 0) {
+            throw fileError("Cannot sync", path)
+        }
+    } finally {
+        close(fd)
+    }
+}
+
+actual fun readFile(path: String): ByteArray {
+    val fd = openFile(path, O_RDONLY)
+    try {
+        val size = memScoped {
+            val fileStat = alloc<stat>()
+            if (fstat(fd, fileStat.ptr) != 0) {
+                throw fileError("Cannot stat", path)
+            }
+            fileStat.st_size.toInt()
+        }
+        val bytes = ByteArray(size)
+        var offset = 0
+        while (offset < size) {
+            val count = bytes.usePinned { read(fd, it.addressOf(offset), (size - offset).convert()) }
+            when {
+                count < 0 -> throw fileError("Cannot read", path)
+                // The file was truncated while reading it
+                count == 0L -> return bytes.copyOf(offset)
+            }
+            offset += count.toInt()
+        }
+        return bytes
+    } finally {
+        close(fd)
+    }
+}
+
+actual fun readFile(path: String, offset: Long, length: Int): ByteArray {
+    val fd = openFile(path, O_RDONLY)
+    try {
+        val bytes = ByteArray(length)
+        var read = 0
+        while (read < length) {
+            val count = bytes.usePinned { pread(fd, it.addressOf(read), (length - read).convert(), offset + read) }
+            when {
+                count < 0 -> throw fileError("Cannot read", path)
+                count == 0L -> break
+            }
+            read += count.toInt()
+        }
+        return if (read == length) bytes else bytes.copyOf(read)
+    } finally {
+        close(fd)
+    }
+}
+
+actual fun copyFile(source: String, target: String) {
+    val sourceFd = openFile(source, O_RDONLY)
+    try {
+        val targetFd = openFile(target, O_WRONLY or O_CREAT or O_EXCL)
+        try {
+            val buffer = ByteArray(COPY_BUFFER_SIZE)
+            while (true) {
+                val count = buffer.usePinned { read(sourceFd, it.addressOf(0), buffer.size.convert()) }
+                when {
+                    count < 0 -> throw fileError("Cannot read", source)
+                    count == 0L -> break
+                }
+                writeFully(targetFd, target, buffer, count.toInt())
+            }
+            if (fsync(targetFd) != 0) {
+                throw fileError("Cannot sync", target)
+            }
+        } finally {
+            close(targetFd)
+        }
+    } finally {
+        close(sourceFd)
+    }
+}
+
+private fun openFile(path: String, flags: Int): Int {
+    val fd = open(path, flags or O_CLOEXEC, FILE_MODE)
+    if (fd < 0) {
+        throw fileError("Cannot open", path)
+    }
+    return fd
+}
+
+private fun writeFully(fd: Int, path: String, bytes: ByteArray, length: Int) {
+    var offset = 0
+    while (offset < length) {
+        val count = bytes.usePinned { write(fd, it.addressOf(offset), (length - offset).convert()) }
+        if (count < 0) {
+            throw fileError("Cannot write", path)
+        }
+        offset += count.toInt()
+    }
+}
+
+private fun fileError(operation: String, path: String): IllegalStateException =
+    IllegalStateException("$operation '$path': ${strerror(errno)?.toKString()}")
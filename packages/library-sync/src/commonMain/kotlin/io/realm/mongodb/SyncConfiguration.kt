@@ -152,7 +152,15 @@ interface SyncConfiguration : RealmConfiguration {
                 writeDispatcher ?: singleThreadDispatcher(name),
                 schemaVersion,
                 deleteRealmIfMigrationNeeded,
-                encryptionKey
+                encryptionKey,
+                inMemory,
+                prefetchFile,
+                collectCommitStatistics,
+                slowQueryThreshold,
+                longTransactionThreshold,
+                backupJournalPath,
+                changeLogPath,
+                migration
             )
 
             return SyncConfigurationImpl(
@@ -26,6 +26,8 @@ internal object Names {
     val REALM_OBJECT_COMPANION_PRIMARY_KEY_MEMBER: Name = Name.identifier("${REALM_SYNTHETIC_PROPERTY_PREFIX}primaryKey")
     val REALM_OBJECT_COMPANION_SCHEMA_METHOD: Name = Name.identifier("${REALM_SYNTHETIC_PROPERTY_PREFIX}schema")
     val REALM_OBJECT_COMPANION_NEW_INSTANCE_METHOD = Name.identifier("${REALM_SYNTHETIC_PROPERTY_PREFIX}newInstance")
+    val REALM_OBJECT_COMPANION_COPY_TO_REALM_METHOD = Name.identifier("${REALM_SYNTHETIC_PROPERTY_PREFIX}copyToRealm")
+    val REALM_OBJECT_COMPANION_COPY_TO_REALM_PARAMETER = Name.identifier("obj")
 
     val SET = Name.special("<set-?>")
     // names must match `RealmObjectInterop` properties
@@ -35,6 +37,7 @@ internal object Names {
     val OBJECT_TABLE_NAME = Name.identifier("${REALM_SYNTHETIC_PROPERTY_PREFIX}TableName")
     val OBJECT_IS_MANAGED = Name.identifier("${REALM_SYNTHETIC_PROPERTY_PREFIX}IsManaged")
     val MEDIATOR = Name.identifier("${REALM_SYNTHETIC_PROPERTY_PREFIX}Mediator")
+    val FIELD_CACHE = Name.identifier("${REALM_SYNTHETIC_PROPERTY_PREFIX}FieldCache")
 
     // C-interop methods
     val REALM_OBJECT_HELPER_GET_VALUE = Name.identifier("getValue")
@@ -72,6 +75,7 @@ internal object FqNames {
     val REALM_OBJECT_HELPER = FqName("io.realm.internal.RealmObjectHelper")
     val REALM_REFERENCE = FqName("io.realm.internal.RealmReference")
     val REALM_MEDIATOR_INTERFACE = FqName("io.realm.internal.Mediator")
+    val REALM_FIELD_CACHE = FqName("io.realm.internal.FieldCache")
     val REALM_CONFIGURATION = FqName("io.realm.RealmConfiguration")
     val REALM_SYNC_CONFIGURATION = FqName("io.realm.mongodb.SyncConfiguration")
     val REALM_CONFIGURATION_BUILDER = FqName("io.realm.RealmConfiguration.Builder")
@@ -75,6 +75,7 @@ private class RealmModelLowering(private val pluginContext: IrPluginContext) : C
             generator.addCompanionFields(companion, SchemaCollector.properties[irClass])
             generator.addSchemaMethodBody(irClass)
             generator.addNewInstanceMethodBody(irClass)
+            generator.addCopyToRealmMethodBody(irClass)
         } else {
             if (irClass.isCompanion && irClass.parentAsClass.hasRealmModelInterface) {
                 val realmModelCompanion: IrClassSymbol = pluginContext.lookupClassOrThrow(REALM_MODEL_COMPANION).symbol
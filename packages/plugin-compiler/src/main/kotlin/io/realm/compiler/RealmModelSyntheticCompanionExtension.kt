@@ -16,6 +16,8 @@
 
 package io.realm.compiler
 
+import io.realm.compiler.Names.REALM_OBJECT_COMPANION_COPY_TO_REALM_METHOD
+import io.realm.compiler.Names.REALM_OBJECT_COMPANION_COPY_TO_REALM_PARAMETER
 import io.realm.compiler.Names.REALM_OBJECT_COMPANION_NEW_INSTANCE_METHOD
 import io.realm.compiler.Names.REALM_OBJECT_COMPANION_SCHEMA_METHOD
 import org.jetbrains.kotlin.descriptors.CallableMemberDescriptor
@@ -23,13 +25,17 @@ import org.jetbrains.kotlin.descriptors.ClassDescriptor
 import org.jetbrains.kotlin.descriptors.DescriptorVisibilities
 import org.jetbrains.kotlin.descriptors.Modality
 import org.jetbrains.kotlin.descriptors.SimpleFunctionDescriptor
+import org.jetbrains.kotlin.descriptors.SourceElement
 import org.jetbrains.kotlin.descriptors.annotations.Annotations
 import org.jetbrains.kotlin.descriptors.impl.SimpleFunctionDescriptorImpl
+import org.jetbrains.kotlin.descriptors.impl.ValueParameterDescriptorImpl
 import org.jetbrains.kotlin.name.Name
 import org.jetbrains.kotlin.name.SpecialNames.DEFAULT_NAME_FOR_COMPANION_OBJECT
 import org.jetbrains.kotlin.resolve.BindingContext
 import org.jetbrains.kotlin.resolve.descriptorUtil.builtIns
 import org.jetbrains.kotlin.resolve.extensions.SyntheticResolveExtension
+import org.jetbrains.kotlin.types.replace
+import org.jetbrains.kotlin.types.typeUtil.asTypeProjection
 
 /**
  * Triggers generation of companion objects and ensures that the companion object implement the
@@ -54,7 +60,8 @@ class RealmModelSyntheticCompanionExtension : SyntheticResolveExtension {
             thisDescriptor.isRealmObjectCompanion -> {
                 listOf(
                     REALM_OBJECT_COMPANION_SCHEMA_METHOD,
-                    REALM_OBJECT_COMPANION_NEW_INSTANCE_METHOD
+                    REALM_OBJECT_COMPANION_NEW_INSTANCE_METHOD,
+                    REALM_OBJECT_COMPANION_COPY_TO_REALM_METHOD
                 )
             }
             else -> {
@@ -71,6 +78,7 @@ class RealmModelSyntheticCompanionExtension : SyntheticResolveExtension {
                 when (name) {
                     REALM_OBJECT_COMPANION_SCHEMA_METHOD -> result.add(createRealmObjectCompanionSchemaGetterFunctionDescriptor(thisDescriptor, classDescriptor))
                     REALM_OBJECT_COMPANION_NEW_INSTANCE_METHOD -> result.add(createRealmObjectCompanionNewInstanceFunctionDescriptor(thisDescriptor, classDescriptor))
+                    REALM_OBJECT_COMPANION_COPY_TO_REALM_METHOD -> result.add(createRealmObjectCompanionCopyToRealmFunctionDescriptor(thisDescriptor, classDescriptor))
                 }
             }
         }
@@ -126,4 +134,42 @@ class RealmModelSyntheticCompanionExtension : SyntheticResolveExtension {
             )
         }
     }
+
+    private fun createRealmObjectCompanionCopyToRealmFunctionDescriptor(
+        companionClass: ClassDescriptor,
+        realmObjectClass: ClassDescriptor
+    ): SimpleFunctionDescriptor {
+        val builtIns = realmObjectClass.builtIns
+        return SimpleFunctionDescriptorImpl.create(
+            companionClass,
+            Annotations.EMPTY,
+            REALM_OBJECT_COMPANION_COPY_TO_REALM_METHOD,
+            CallableMemberDescriptor.Kind.SYNTHESIZED,
+            companionClass.source
+        ).apply {
+            initialize(
+                null,
+                companionClass.thisAsReceiverParameter,
+                emptyList(),
+                listOf(
+                    ValueParameterDescriptorImpl(
+                        containingDeclaration = this,
+                        original = null,
+                        index = 0,
+                        annotations = Annotations.EMPTY,
+                        name = REALM_OBJECT_COMPANION_COPY_TO_REALM_PARAMETER,
+                        outType = builtIns.anyType,
+                        declaresDefaultValue = false,
+                        isCrossinline = false,
+                        isNoinline = false,
+                        varargElementType = null,
+                        source = SourceElement.NO_SOURCE
+                    )
+                ),
+                builtIns.list.defaultType.replace(listOf(builtIns.nullableAnyType.asTypeProjection())),
+                Modality.OPEN,
+                DescriptorVisibilities.PUBLIC
+            )
+        }
+    }
 }
@@ -23,6 +23,7 @@ import io.realm.compiler.FqNames.PRIMARY_KEY_ANNOTATION
 import io.realm.compiler.FqNames.PROPERTY
 import io.realm.compiler.FqNames.PROPERTY_FLAG
 import io.realm.compiler.FqNames.PROPERTY_TYPE
+import io.realm.compiler.FqNames.REALM_FIELD_CACHE
 import io.realm.compiler.FqNames.REALM_MEDIATOR_INTERFACE
 import io.realm.compiler.FqNames.REALM_MODEL_COMPANION
 import io.realm.compiler.FqNames.REALM_NATIVE_POINTER
@@ -30,6 +31,7 @@ import io.realm.compiler.FqNames.REALM_OBJECT_INTERNAL_INTERFACE
 import io.realm.compiler.FqNames.REALM_REFERENCE
 import io.realm.compiler.FqNames.TABLE
 import io.realm.compiler.Names.CLASS_FLAG_NORMAL
+import io.realm.compiler.Names.FIELD_CACHE
 import io.realm.compiler.Names.MEDIATOR
 import io.realm.compiler.Names.OBJECT_IS_MANAGED
 import io.realm.compiler.Names.OBJECT_POINTER
@@ -40,6 +42,8 @@ import io.realm.compiler.Names.PROPERTY_FLAG_INDEX
 import io.realm.compiler.Names.PROPERTY_FLAG_NULLABLE
 import io.realm.compiler.Names.PROPERTY_FLAG_PRIMARY_KEY
 import io.realm.compiler.Names.PROPERTY_TYPE_OBJECT
+import io.realm.compiler.Names.REALM_OBJECT_COMPANION_COPY_TO_REALM_METHOD
+import io.realm.compiler.Names.REALM_OBJECT_COMPANION_COPY_TO_REALM_PARAMETER
 import io.realm.compiler.Names.REALM_OBJECT_COMPANION_FIELDS_MEMBER
 import io.realm.compiler.Names.REALM_OBJECT_COMPANION_NEW_INSTANCE_METHOD
 import io.realm.compiler.Names.REALM_OBJECT_COMPANION_PRIMARY_KEY_MEMBER
@@ -58,7 +62,9 @@ import org.jetbrains.kotlin.ir.builders.declarations.addGetter
 import org.jetbrains.kotlin.ir.builders.declarations.addProperty
 import org.jetbrains.kotlin.ir.builders.declarations.addValueParameter
 import org.jetbrains.kotlin.ir.builders.declarations.buildField
+import org.jetbrains.kotlin.ir.builders.irAs
 import org.jetbrains.kotlin.ir.builders.irBlockBody
+import org.jetbrains.kotlin.ir.builders.irCall
 import org.jetbrains.kotlin.ir.builders.irGet
 import org.jetbrains.kotlin.ir.builders.irGetField
 import org.jetbrains.kotlin.ir.builders.irReturn
@@ -126,6 +132,7 @@ class RealmModelSyntheticPropertiesGeneration(private val pluginContext: IrPlugi
 
     private val realmReferenceClass = pluginContext.lookupClassOrThrow(REALM_REFERENCE)
     private val mediatorInterface = pluginContext.lookupClassOrThrow(REALM_MEDIATOR_INTERFACE)
+    private val fieldCacheClass = pluginContext.lookupClassOrThrow(REALM_FIELD_CACHE)
 
     private val listIrClass: IrClass =
         pluginContext.lookupClassOrThrow(FqNames.KOTLIN_COLLECTIONS_LIST)
@@ -144,6 +151,7 @@ class RealmModelSyntheticPropertiesGeneration(private val pluginContext: IrPlugi
             )
             addVariableProperty(realmModelInternalInterface, OBJECT_IS_MANAGED, pluginContext.irBuiltIns.booleanType, ::irFalse)
             addVariableProperty(realmModelInternalInterface, MEDIATOR, mediatorInterface.defaultType.makeNullable(), ::irNull)
+            addVariableProperty(realmModelInternalInterface, FIELD_CACHE, fieldCacheClass.defaultType.makeNullable(), ::irNull)
         }
 
     @Suppress("LongMethod")
@@ -492,6 +500,40 @@ class RealmModelSyntheticPropertiesGeneration(private val pluginContext: IrPlugi
             listOf(realmObjectCompanionInterface.functions.first { it.name == REALM_OBJECT_COMPANION_NEW_INSTANCE_METHOD }.symbol)
     }
 
+    // Generate body for the synthetic copy to realm method defined inside the Companion instance
+    // previously declared via `RealmModelSyntheticCompanionExtension`. Reads the persisted
+    // properties of an object through direct getter calls in the order of `$realm$fields`.
+    fun addCopyToRealmMethodBody(irClass: IrClass) {
+        val companionObject = irClass.companionObject() as? IrClass
+            ?: error("Companion object not available")
+
+        val fields: MutableMap<String, SchemaProperty> =
+            SchemaCollector.properties.getOrDefault(irClass, mutableMapOf())
+        val function =
+            companionObject.functions.first { it.name == REALM_OBJECT_COMPANION_COPY_TO_REALM_METHOD }
+        function.dispatchReceiverParameter = companionObject.thisReceiver?.copyTo(function)
+        val obj = function.valueParameters.firstOrNull()
+            ?: function.addValueParameter(REALM_OBJECT_COMPANION_COPY_TO_REALM_PARAMETER.identifier, pluginContext.irBuiltIns.anyType)
+        function.body = pluginContext.blockBody(function.symbol) {
+            +irReturn(
+                buildListOf(
+                    context = pluginContext,
+                    startOffset = startOffset,
+                    endOffset = endOffset,
+                    elementType = pluginContext.irBuiltIns.anyNType,
+                    args = fields.values.map { property ->
+                        val getter = property.declaration.getter ?: error("Property without getter: ${property.declaration.name}")
+                        irCall(getter).apply {
+                            dispatchReceiver = irAs(irGet(obj), irClass.defaultType)
+                        }
+                    }
+                )
+            )
+        }
+        function.overriddenSymbols =
+            listOf(realmObjectCompanionInterface.functions.first { it.name == REALM_OBJECT_COMPANION_COPY_TO_REALM_METHOD }.symbol)
+    }
+
     @Suppress("LongMethod")
     private fun IrClass.addVariableProperty(
         owner: IrClass,
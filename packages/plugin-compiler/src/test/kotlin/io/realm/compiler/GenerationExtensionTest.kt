@@ -240,6 +240,13 @@ class GenerationExtensionTest {
         val newInstance = companionObject.`$realm$newInstance`()
         assertNotNull(newInstance)
         assertEquals(kClazz, newInstance.javaClass)
+
+        // Values are read in the order of the fields
+        val values = companionObject.`$realm$copyToRealm`(newInstance)
+        assertEquals(properties.size, values.size)
+        fields!!.forEachIndexed { index, field ->
+            assertEquals(field.getter.call(newInstance), values[index])
+        }
         inputs.assertGeneratedIR()
     }
 
@@ -156,6 +156,7 @@ kotlin {
 kotlin {
     iosX64("ios")
     macosX64("macos")
+    linuxX64("linux")
     sourceSets {
         val macosMain by getting
         val macosTest by getting
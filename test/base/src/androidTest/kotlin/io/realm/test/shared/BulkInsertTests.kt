@@ -0,0 +1,121 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.test.shared
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.entities.Sample
+import io.realm.entities.StringPropertyWithPrimaryKey
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import kotlinx.coroutines.flow.asFlow
+import kotlinx.coroutines.runBlocking
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+
+class BulkInsertTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        val configuration =
+            RealmConfiguration.Builder(schema = setOf(Sample::class, StringPropertyWithPrimaryKey::class))
+                .path("$tmpDir/default.realm")
+                .build()
+        realm = Realm.open(configuration)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun bulkInsert() {
+        val objects = (0 until 2500).map { i ->
+            Sample().apply {
+                intField = i
+                stringListField.add("$i")
+            }
+        }
+
+        val inserted = runBlocking { realm.bulkInsert(objects.asFlow(), chunkSize = 1000) }
+
+        assertEquals(2500, inserted)
+        val results = realm.objects<Sample>()
+        assertEquals(2500, results.size)
+        assertEquals((0 until 2500).toSet(), results.map { it.intField }.toSet())
+        results.forEach { assertEquals(listOf("${it.intField}"), it.stringListField.toList()) }
+    }
+
+    @Test
+    fun bulkInsert_objectGraph() {
+        val objects = (0 until 10).map { i ->
+            val parent = Sample().apply { intField = i }
+            val child = Sample().apply {
+                stringField = "child"
+                intField = i
+                // Cyclic reference
+                child = parent
+            }
+            parent.apply {
+                this.child = child
+                objectListField.add(child)
+            }
+        }
+
+        val inserted = runBlocking { realm.bulkInsert(objects.asFlow(), chunkSize = 3) }
+
+        assertEquals(10, inserted)
+        assertEquals(20, realm.objects<Sample>().size)
+        val parents = realm.objects<Sample>().query("stringField != 'child'")
+        assertEquals(10, parents.size)
+        parents.forEach { parent ->
+            val child = parent.child!!
+            assertEquals("child", child.stringField)
+            assertEquals(parent.intField, child.intField)
+            assertEquals(parent.intField, child.child!!.intField)
+            assertEquals("child", parent.objectListField.first().stringField)
+        }
+    }
+
+    @Test
+    fun bulkInsert_duplicatePrimaryKeyRollsBack() {
+        val objects = listOf("1", "2", "1").map { StringPropertyWithPrimaryKey().apply { id = it } }
+
+        assertFailsWith<IllegalArgumentException> {
+            runBlocking { realm.bulkInsert(objects.asFlow(), chunkSize = 1) }
+        }
+        assertEquals(0, realm.objects<StringPropertyWithPrimaryKey>().size)
+    }
+
+    @Test
+    fun bulkInsert_invalidChunkSizeThrows() {
+        assertFailsWith<IllegalArgumentException> {
+            runBlocking { realm.bulkInsert(listOf(Sample()).asFlow(), chunkSize = 0) }
+        }
+    }
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test.shared
+
+import io.realm.ChangeLog
+import io.realm.ChangeLogEntry
+import io.realm.ObjectChange
+import io.realm.ObjectReference
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.entities.Sample
+import io.realm.entities.backup.BackupSample
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertFalse
+import kotlin.test.assertNull
+import kotlin.test.assertTrue
+
+class ChangeLogTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var changeLogPath: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        changeLogPath = "$tmpDir/changes.log"
+        val configuration = RealmConfiguration.Builder(schema = setOf(Sample::class, BackupSample::class))
+            .path("$tmpDir/default.realm")
+            .changeLog(changeLogPath)
+            .build()
+        realm = Realm.open(configuration)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun read_noChangeLog() {
+        assertTrue(ChangeLog.read(changeLogPath).isEmpty())
+    }
+
+    @Test
+    fun insertedObjects() {
+        realm.writeBlocking {
+            copyToRealm(BackupSample().apply { id = "a"; intField = 1; link = BackupSample().apply { id = "b" } })
+        }
+
+        val entry = ChangeLog.read(changeLogPath).single()
+        assertEquals(ChangeLog.START_OFFSET, entry.offset)
+        assertEquals(2, entry.changes.size)
+        val a = entry.changes.single { it.primaryKey == "a" }
+        val b = entry.changes.single { it.primaryKey == "b" }
+        assertEquals(ObjectChange.Type.INSERTED, a.type)
+        assertEquals("BackupSample", a.className)
+        assertEquals(1L, a.values["intField"])
+        assertEquals(ObjectReference("BackupSample", b.objectKey, "b"), a.values["link"])
+        assertEquals(emptyList<Any?>(), a.values["stringList"])
+        // The primary key is not part of the values
+        assertNull(a.values["id"])
+    }
+
+    @Test
+    fun modifiedProperties() {
+        realm.writeBlocking { copyToRealm(Sample()) }
+        realm.writeBlocking {
+            val sample = objects<Sample>().first()
+            sample.intField = 1
+            sample.intField = 2
+            sample.stringListField.add("Realm")
+        }
+
+        val entries = ChangeLog.read(changeLogPath)
+        assertEquals(2, entries.size)
+        val change = entries[1].changes.single()
+        assertEquals(ObjectChange.Type.MODIFIED, change.type)
+        assertNull(change.primaryKey)
+        assertEquals(entries[0].changes.single().objectKey, change.objectKey)
+        assertEquals(mapOf("intField" to 2L, "stringListField" to listOf("Realm")), change.values)
+    }
+
+    @Test
+    fun deletedObjects() {
+        realm.writeBlocking { copyToRealm(BackupSample().apply { id = "a" }) }
+        realm.writeBlocking {
+            delete(objects<BackupSample>().first())
+            // Objects inserted and deleted in the same transaction are not logged
+            copyToRealm(BackupSample().apply { id = "b" })
+            objects<BackupSample>().query("id == 'b'").delete()
+        }
+
+        val change = ChangeLog.read(changeLogPath)[1].changes.single()
+        assertEquals(ObjectChange.Type.DELETED, change.type)
+        assertEquals("a", change.primaryKey)
+        assertTrue(change.values.isEmpty())
+    }
+
+    @Test
+    fun read_fromNextOffset() {
+        realm.writeBlocking { copyToRealm(Sample()) }
+        val first = ChangeLog.read(changeLogPath).single()
+        assertTrue(ChangeLog.read(changeLogPath, first.nextOffset).isEmpty())
+
+        realm.writeBlocking { copyToRealm(Sample()) }
+        realm.writeBlocking { copyToRealm(Sample()) }
+        val entries = ChangeLog.read(changeLogPath, first.nextOffset)
+        assertEquals(2, entries.size)
+        assertEquals(first.nextOffset, entries[0].offset)
+        assertTrue(entries[0].version < entries[1].version)
+    }
+
+    @Test
+    fun read_maxBytes() {
+        realm.writeBlocking { copyToRealm(Sample()) }
+        realm.writeBlocking { copyToRealm(Sample()) }
+
+        // The first entry is returned even if it exceeds the limit
+        val entries = ChangeLog.read(changeLogPath, maxBytes = 1)
+        assertEquals(1, entries.size)
+        assertEquals(1, ChangeLog.read(changeLogPath, entries[0].nextOffset).size)
+    }
+
+    @Test
+    fun emptyTransactionsAreNotLogged() {
+        realm.writeBlocking { copyToRealm(Sample()) }
+        realm.writeBlocking { objects<Sample>().size }
+        assertEquals(1, ChangeLog.read(changeLogPath).size)
+
+        // The version of the empty transaction is covered by the next entry
+        realm.writeBlocking { copyToRealm(Sample()) }
+        val entries = ChangeLog.read(changeLogPath)
+        assertEquals(2, entries.size)
+        assertEquals(entries[0].version, entries[0].firstVersion)
+        assertEquals(entries[0].version + 1, entries[1].firstVersion)
+        assertEquals(entries[0].version + 2, entries[1].version)
+        assertEquals(ChangeLogEntry.Type.CHANGES, entries[1].type)
+    }
+
+    @Test
+    fun gapForVersionsCommittedByOtherInstance() {
+        realm.writeBlocking { copyToRealm(Sample()) }
+        val other = Realm.open(
+            RealmConfiguration.Builder(schema = setOf(Sample::class, BackupSample::class))
+                .path("$tmpDir/default.realm")
+                .build()
+        )
+        try {
+            other.writeBlocking { copyToRealm(Sample()) }
+            other.writeBlocking { copyToRealm(Sample()) }
+        } finally {
+            other.close()
+        }
+        realm.writeBlocking { copyToRealm(Sample()) }
+
+        val entries = ChangeLog.read(changeLogPath)
+        assertEquals(3, entries.size)
+        val gap = entries[1]
+        assertEquals(ChangeLogEntry.Type.GAP, gap.type)
+        assertEquals(entries[0].version + 1, gap.firstVersion)
+        assertEquals(entries[0].version + 2, gap.version)
+        assertTrue(gap.changes.isEmpty())
+        assertEquals(ChangeLogEntry.Type.CHANGES, entries[2].type)
+        assertEquals(gap.version + 1, entries[2].firstVersion)
+        assertFalse(realm.isChangeLogInterrupted())
+    }
+
+    @Test
+    fun appendFailure_logsGapAndResumes() {
+        // Appending fails while the path of the change log is a directory
+        val otherChangeLogPath = PlatformUtils.createTempDir()
+        val other = Realm.open(
+            RealmConfiguration.Builder(schema = setOf(Sample::class, BackupSample::class))
+                .path("$tmpDir/other.realm")
+                .changeLog(otherChangeLogPath)
+                .build()
+        )
+        try {
+            assertFalse(other.isChangeLogInterrupted())
+            other.writeBlocking { copyToRealm(Sample()) }
+            assertEquals(1, other.objects<Sample>().size)
+            assertTrue(other.isChangeLogInterrupted())
+
+            PlatformUtils.deleteTempDir(otherChangeLogPath)
+            other.writeBlocking { copyToRealm(Sample()) }
+            assertFalse(other.isChangeLogInterrupted())
+
+            val entries = ChangeLog.read(otherChangeLogPath)
+            assertEquals(2, entries.size)
+            assertEquals(ChangeLogEntry.Type.GAP, entries[0].type)
+            assertEquals(entries[0].firstVersion, entries[0].version)
+            assertEquals(ChangeLogEntry.Type.CHANGES, entries[1].type)
+            assertEquals(entries[0].version + 1, entries[1].firstVersion)
+            assertEquals(1, entries[1].changes.size)
+        } finally {
+            other.close()
+            PlatformUtils.deleteTempDir(otherChangeLogPath)
+        }
+    }
+
+    @Test
+    fun isChangeLogInterrupted_throwsWithoutChangeLog() {
+        val other = Realm.open(
+            RealmConfiguration.Builder(schema = setOf(Sample::class, BackupSample::class))
+                .path("$tmpDir/other.realm")
+                .build()
+        )
+        try {
+            assertFailsWith<IllegalStateException> { other.isChangeLogInterrupted() }
+        } finally {
+            other.close()
+        }
+    }
+
+    @Test
+    fun read_invalidArguments() {
+        assertFailsWith<IllegalArgumentException> {
+            ChangeLog.read(changeLogPath, offset = 0)
+        }
+        assertFailsWith<IllegalArgumentException> {
+            ChangeLog.read(changeLogPath, maxBytes = 0)
+        }
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test.shared
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.entities.Sample
+import io.realm.log.LogLevel
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import io.realm.test.util.TestLogger
+import kotlinx.coroutines.CoroutineName
+import kotlinx.coroutines.runBlocking
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertNotNull
+import kotlin.test.assertNull
+import kotlin.test.assertTrue
+import kotlin.time.Duration
+
+class InstrumentationTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var logger: TestLogger
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        logger = TestLogger()
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (this::realm.isInitialized && !realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun slowQueryThreshold_reportsQuery() {
+        openRealm { slowQueryThreshold(Duration.ZERO) }
+        realm.writeBlocking {
+            copyToRealm(Sample().apply { intField = 1 })
+            copyToRealm(Sample().apply { intField = 2 })
+        }
+
+        realm.objects<Sample>().query("intField == $0", 1)
+        assertEquals(LogLevel.WARN, logger.logLevel)
+        val message = logger.message!!
+        assertTrue(message.contains("'Sample'"), message)
+        assertTrue(message.contains("matched 1 objects"), message)
+        assertTrue(message.contains("`intField == $0`"), message)
+    }
+
+    @Test
+    fun longTransactionThreshold_reportsTransaction() {
+        openRealm { longTransactionThreshold(Duration.ZERO) }
+
+        runBlocking(CoroutineName("importer")) {
+            realm.write { copyToRealm(Sample()) }
+        }
+        assertEquals(LogLevel.WARN, logger.logLevel)
+        assertNotNull(logger.throwable)
+        val message = logger.message!!
+        assertTrue(message.contains("'importer'"), message)
+    }
+
+    @Test
+    fun thresholdsDisabledByDefault() {
+        openRealm { this }
+        realm.writeBlocking { copyToRealm(Sample()) }
+        realm.objects<Sample>().query("intField == 0")
+        assertNull(logger.message)
+    }
+
+    @Test
+    fun negativeThresholds_throws() {
+        val builder = RealmConfiguration.Builder(schema = setOf(Sample::class))
+        assertFailsWith<IllegalArgumentException> {
+            builder.slowQueryThreshold(-Duration.INFINITE)
+        }
+        assertFailsWith<IllegalArgumentException> {
+            builder.longTransactionThreshold(-Duration.INFINITE)
+        }
+    }
+
+    private fun openRealm(configure: RealmConfiguration.Builder.() -> RealmConfiguration.Builder) {
+        val configuration = RealmConfiguration.Builder(schema = setOf(Sample::class))
+            .path("$tmpDir/default.realm")
+            .log(LogLevel.WARN, listOf(logger))
+            .configure()
+            .build()
+        realm = Realm.open(configuration)
+    }
+}
@@ -272,6 +272,48 @@ class RealmConfigurationTests {
         assertContentEquals(encryptionKey, config.encryptionKey)
     }
 
+    @Test
+    fun defaultInMemory() {
+        val config = RealmConfiguration.with(schema = setOf(Sample::class))
+        assertFalse(config.inMemory)
+    }
+
+    @Test
+    fun inMemory() {
+        val config = RealmConfiguration.Builder(schema = setOf(Sample::class))
+            .inMemory()
+            .build()
+        assertTrue(config.inMemory)
+    }
+
+    @Test
+    fun defaultPrefetchFile() {
+        val config = RealmConfiguration.with(schema = setOf(Sample::class))
+        assertFalse(config.prefetchFile)
+    }
+
+    @Test
+    fun prefetchFile() {
+        val config = RealmConfiguration.Builder(schema = setOf(Sample::class))
+            .prefetchFile()
+            .build()
+        assertTrue(config.prefetchFile)
+    }
+
+    @Test
+    fun defaultCollectCommitStatistics() {
+        val config = RealmConfiguration.with(schema = setOf(Sample::class))
+        assertFalse(config.collectCommitStatistics)
+    }
+
+    @Test
+    fun collectCommitStatistics() {
+        val config = RealmConfiguration.Builder(schema = setOf(Sample::class))
+            .collectCommitStatistics()
+            .build()
+        assertTrue(config.collectCommitStatistics)
+    }
+
     @Test
     fun wrongEncryptionKeyThrowsIllegalArgumentException() {
         val builder = RealmConfiguration.Builder(schema = setOf(Sample::class))
@@ -263,6 +263,26 @@ class RealmListTests {
         assertEquals(1, list.size)
     }
 
+    @Test
+    fun size_frozenListKeepsSizeUntilRefrozen() {
+        realm.writeBlocking {
+            copyToRealm(RealmListContainer()).stringListField.add("A")
+        }
+        val frozenList = realm.objects<RealmListContainer>().first().stringListField
+        assertEquals(1, frozenList.size)
+
+        realm.writeBlocking {
+            objects<RealmListContainer>().first().stringListField.add("B")
+        }
+        // The size cached by the old version is kept
+        assertEquals(1, frozenList.size)
+        assertEquals(listOf("A"), frozenList.toList())
+
+        val refrozenList = realm.objects<RealmListContainer>().first().stringListField
+        assertEquals(2, refrozenList.size)
+        assertEquals(listOf("A", "B"), refrozenList.toList())
+    }
+
     private fun getCloseableRealm(): Realm =
         RealmConfiguration.Builder(schema = setOf(RealmListContainer::class))
             .path("$tmpDir/closeable.realm").build().let { Realm.open(it) }
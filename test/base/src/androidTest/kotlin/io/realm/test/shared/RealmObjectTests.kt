@@ -32,6 +32,7 @@ import kotlin.test.Test
 import kotlin.test.assertEquals
 import kotlin.test.assertFailsWith
 import kotlin.test.assertFalse
+import kotlin.test.assertSame
 import kotlin.test.assertTrue
 
 class RealmObjectTests : RealmStateTest {
@@ -90,6 +91,38 @@ class RealmObjectTests : RealmStateTest {
         assertFalse(obj.isValid())
     }
 
+    @Test
+    fun accessors_throwOnDeletedObject() {
+        realm.writeBlocking {
+            val liveParent = findLatest(parent)!!
+            delete(liveParent)
+            assertFailsWith<IllegalStateException> { liveParent.name }
+            assertFailsWith<IllegalStateException> { liveParent.child }
+            assertFailsWith<IllegalStateException> { liveParent.name = "Deleted" }
+        }
+    }
+
+    @Test
+    fun accessors_throwIfRealmIsClosed() {
+        assertEquals("N.N.", parent.name)
+        realm.close()
+        assertFailsWith<IllegalStateException> { parent.name }
+        assertFailsWith<IllegalStateException> { parent.child }
+    }
+
+    @Test
+    fun accessors_frozenObjectReturnsCachedValues() {
+        val frozenParent = realm.writeBlocking {
+            copyToRealm(Parent().apply { name = "Parent"; child = Child() })
+        }
+        assertEquals("Parent", frozenParent.name)
+        assertSame(frozenParent.child, frozenParent.child)
+        realm.writeBlocking {
+            findLatest(frozenParent)!!.name = "Updated"
+        }
+        assertEquals("Parent", frozenParent.name)
+    }
+
     @Test
     override fun isFrozen() {
         assertTrue { parent.isFrozen() }
@@ -66,4 +66,24 @@ class RealmResultsTests {
         realm.close()
         assertFailsWith<IllegalStateException> { results.version() }
     }
+
+    @Test
+    fun size_frozenResultsKeepSize() {
+        realm.writeBlocking { copyToRealm(Parent()) }
+        val results: RealmResults<Parent> = realm.objects(Parent::class)
+        assertEquals(1, results.size)
+        realm.writeBlocking { copyToRealm(Parent()) }
+        assertEquals(1, results.size)
+        assertEquals(2, realm.objects(Parent::class).size)
+    }
+
+    @Test
+    fun sizeThrowsIfRealmIsClosed() {
+        realm.writeBlocking { copyToRealm(Parent()) }
+        val results: RealmResults<Parent> = realm.objects(Parent::class)
+        // Resolve the cached size before closing
+        assertEquals(1, results.size)
+        realm.close()
+        assertFailsWith<IllegalStateException> { results.size }
+    }
 }
@@ -171,6 +171,80 @@ class RealmTests {
         assertEquals(0, realm.objects<Child>().size)
     }
 
+    @Test
+    fun inMemory() = runBlocking {
+        val inMemoryConfiguration = RealmConfiguration.Builder(schema = setOf(Parent::class, Child::class))
+            .path("$tmpDir/in-memory.realm")
+            .inMemory()
+            .build()
+        var inMemoryRealm = Realm.open(inMemoryConfiguration)
+        // Writes go through the writer's realm, which must share the data of the in-memory realm
+        inMemoryRealm.write { copyToRealm(Child().apply { name = "Realm" }) }
+        inMemoryRealm.writeBlocking { copyToRealm(Child()) }
+        assertEquals(2, inMemoryRealm.objects<Child>().size)
+        inMemoryRealm.close()
+
+        // Data is discarded once all instances are closed
+        inMemoryRealm = Realm.open(inMemoryConfiguration)
+        assertEquals(0, inMemoryRealm.objects<Child>().size)
+        inMemoryRealm.close()
+    }
+
+    @Test
+    fun prefetchFile() {
+        realm.writeBlocking { copyToRealm(Child()) }
+        realm.close()
+
+        val prefetchConfiguration = RealmConfiguration.Builder(schema = setOf(Parent::class, Child::class))
+            .path("$tmpDir/default.realm")
+            .prefetchFile()
+            .build()
+        realm = Realm.open(prefetchConfiguration)
+        assertEquals(1, realm.objects<Child>().size)
+
+        // Prefetching a realm that doesn't exist yet is ignored
+        Realm.open(
+            RealmConfiguration.Builder(schema = setOf(Parent::class, Child::class))
+                .path("$tmpDir/new.realm")
+                .prefetchFile()
+                .build()
+        ).close()
+    }
+
+    @Test
+    fun commitStatistics() {
+        realm.close()
+        val statisticsConfiguration = RealmConfiguration.Builder(schema = setOf(Parent::class, Child::class))
+            .path("$tmpDir/default.realm")
+            .collectCommitStatistics()
+            .build()
+        realm = Realm.open(statisticsConfiguration)
+        assertEquals(0, realm.commitStatistics().commits)
+
+        realm.writeBlocking { copyToRealm(Child()) }
+        realm.writeBlocking {
+            for (i in 0 until 1000) {
+                copyToRealm(Child().apply { name = "Child $i" })
+            }
+        }
+        // Cancelled transactions are not committed
+        realm.writeBlocking { cancelWrite() }
+
+        val statistics = realm.commitStatistics()
+        assertEquals(2, statistics.commits)
+        assertEquals(2, statistics.commitTimeHistogram.values.sum())
+        assertTrue(statistics.commitTime <= statistics.transactionTime)
+        assertTrue(statistics.maxCommitTime <= statistics.commitTime)
+        assertTrue(statistics.fileSize > 0)
+    }
+
+    @Test
+    fun commitStatistics_throwsIfNotCollected() {
+        assertFailsWith<IllegalStateException> {
+            realm.commitStatistics()
+        }
+    }
+
     @Test
     fun writeBlocking() {
         val managedChild = realm.writeBlocking { copyToRealm(Child().apply { name = "John" }) }
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+package io.realm.test.shared
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.ShardedIngestion
+import io.realm.entities.Sample
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import kotlinx.coroutines.flow.asFlow
+import kotlinx.coroutines.runBlocking
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+
+class ShardedIngestionTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var realms: List<Realm>
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        realms = (0 until SHARDS).map { shard ->
+            val configuration = RealmConfiguration.Builder(schema = setOf(Sample::class))
+                .path("$tmpDir/shard-$shard.realm")
+                .build()
+            Realm.open(configuration)
+        }
+    }
+
+    @AfterTest
+    fun tearDown() {
+        realms.forEach { it.close() }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun ingest() {
+        val objects = (0 until 1050).map { i -> Sample().apply { intField = i } }
+        val ingestion = ShardedIngestion<Sample>(realms, batchSize = 100) { it.intField % SHARDS }
+
+        val inserted = runBlocking { ingestion.ingest(objects.asFlow()) }
+
+        assertEquals(1050, inserted)
+        realms.forEachIndexed { shard, realm ->
+            val results = realm.objects<Sample>()
+            assertEquals(350, results.size)
+            results.forEach { assertEquals(shard, it.intField % SHARDS) }
+        }
+    }
+
+    @Test
+    fun ingest_invalidShardThrows() {
+        val ingestion = ShardedIngestion<Sample>(realms) { SHARDS }
+        assertFailsWith<IllegalArgumentException> {
+            runBlocking { ingestion.ingest(listOf(Sample()).asFlow()) }
+        }
+    }
+
+    @Test
+    fun constructor_invalidArgumentsThrows() {
+        assertFailsWith<IllegalArgumentException> {
+            ShardedIngestion<Sample>(emptyList()) { 0 }
+        }
+        assertFailsWith<IllegalArgumentException> {
+            ShardedIngestion<Sample>(realms, batchSize = 0) { 0 }
+        }
+    }
+
+    private companion object {
+        const val SHARDS = 3
+    }
+}
@@ -0,0 +1,29 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.entities.migration.v1
+
+import io.realm.RealmObject
+
+// Version 1 of the schema of migration tests, which shares its class name with version 2
+class Person : RealmObject {
+    var name: String = ""
+    var fullName: String? = null
+    var age: String = ""
+    var street: String = ""
+    var city: String = ""
+    var active: Boolean = true
+}
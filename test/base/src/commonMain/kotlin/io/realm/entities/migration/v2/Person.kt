@@ -0,0 +1,30 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.entities.migration.v2
+
+import io.realm.RealmObject
+
+// Version 2 of the schema of migration tests, which shares its class name with version 1
+class Person : RealmObject {
+    var displayName: String = ""
+    var firstName: String = ""
+    var lastName: String = ""
+    var age: Int = 0
+    var address: String? = null
+    var active: Boolean = true
+    var score: Double = 0.0
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.entities.Sample
+import io.realm.exportArrow
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import java.io.ByteArrayOutputStream
+import java.io.File
+import java.io.IOException
+import java.nio.BufferOverflowException
+import java.nio.ByteBuffer
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertContentEquals
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertTrue
+
+// Arrow exports read the core objects behind the results, which is only available through JNI
+class ArrowExportTests {
+
+    private val properties = listOf("stringField", "intField", "booleanField", "floatField", "doubleField")
+
+    private lateinit var tmpDir: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        realm = Realm.open(
+            RealmConfiguration.Builder(schema = setOf(Sample::class))
+                .path("$tmpDir/default.realm")
+                .build()
+        )
+        realm.writeBlocking {
+            for (i in 0 until 100) {
+                copyToRealm(Sample().apply { stringField = "Sample $i"; intField = i })
+            }
+        }
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun exportArrow_path() {
+        realm.objects<Sample>().exportArrow("$tmpDir/samples.arrows", properties)
+
+        val stream = File("$tmpDir/samples.arrows").readBytes()
+        // Messages start with the continuation marker and the stream ends with an empty message
+        assertContentEquals(ByteArray(4) { -1 }, stream.copyOfRange(0, 4))
+        assertContentEquals(
+            byteArrayOf(-1, -1, -1, -1, 0, 0, 0, 0),
+            stream.copyOfRange(stream.size - 8, stream.size)
+        )
+        val text = String(stream, Charsets.UTF_8)
+        properties.forEach { assertTrue(text.contains(it)) }
+        assertTrue(text.contains("Sample 99"))
+    }
+
+    @Test
+    fun exportArrow_sinkAndBufferMatchFile() {
+        val results = realm.objects<Sample>().query("intField < 50")
+        results.exportArrow("$tmpDir/samples.arrows", properties, batchSize = 16)
+
+        val sinkStream = ByteArrayOutputStream()
+        results.exportArrow(properties, batchSize = 16) { buffer, length -> sinkStream.write(buffer, 0, length) }
+        val buffer = ByteBuffer.allocateDirect(1024 * 1024)
+        results.exportArrow(buffer, properties, batchSize = 16)
+
+        val stream = File("$tmpDir/samples.arrows").readBytes()
+        assertContentEquals(stream, sinkStream.toByteArray())
+        assertEquals(stream.size, buffer.position())
+        assertContentEquals(stream, ByteArray(buffer.flip().remaining()).also { buffer.get(it) })
+    }
+
+    @Test
+    fun exportArrow_batchSize() {
+        val results = realm.objects<Sample>()
+        results.exportArrow("$tmpDir/one.arrows", properties, batchSize = 100)
+        results.exportArrow("$tmpDir/many.arrows", properties, batchSize = 10)
+
+        // Each record batch adds its own metadata
+        assertTrue(File("$tmpDir/many.arrows").length() > File("$tmpDir/one.arrows").length())
+    }
+
+    @Test
+    fun exportArrow_bufferOverflow() {
+        assertFailsWith<BufferOverflowException> {
+            realm.objects<Sample>().exportArrow(ByteBuffer.allocateDirect(16), properties)
+        }
+    }
+
+    @Test
+    fun exportArrow_sinkExceptionIsRethrown() {
+        assertFailsWith<IOException> {
+            realm.objects<Sample>().exportArrow(properties) { _, _ -> throw IOException("Boom") }
+        }
+    }
+
+    @Test
+    fun exportArrow_invalidArguments() {
+        val results = realm.objects<Sample>()
+        assertFailsWith<IllegalArgumentException> {
+            results.exportArrow("$tmpDir/samples.arrows", emptyList())
+        }
+        assertFailsWith<IllegalArgumentException> {
+            results.exportArrow("$tmpDir/samples.arrows", properties, batchSize = 0)
+        }
+        assertFailsWith<IllegalArgumentException> {
+            results.exportArrow("$tmpDir/samples.arrows", listOf("unknownField"))
+        }
+        assertFailsWith<IllegalArgumentException> {
+            results.exportArrow("$tmpDir/samples.arrows", listOf("stringListField"))
+        }
+        assertFailsWith<IllegalArgumentException> {
+            results.exportArrow("$tmpDir/samples.arrows", listOf("child"))
+        }
+        File("$tmpDir/samples.arrows").createNewFile()
+        assertFailsWith<IllegalArgumentException> {
+            results.exportArrow("$tmpDir/samples.arrows", properties)
+        }
+    }
+}
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.entities.Sample
+import io.realm.entities.backup.BackupSample
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import io.realm.writeBackupSnapshot
+import java.io.File
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertFalse
+import kotlin.test.assertNull
+
+// Backup snapshots are written as copies of the realm, which is only available through JNI
+class BackupJournalTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var journalPath: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        journalPath = "$tmpDir/backup.journal"
+        realm = Realm.open(
+            RealmConfiguration.Builder(schema = setOf(BackupSample::class))
+                .path("$tmpDir/default.realm")
+                .backupJournal(journalPath)
+                .build()
+        )
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun restoreBackup() {
+        realm.writeBlocking {
+            copyToRealm(BackupSample().apply { id = "a"; intField = 1 })
+            copyToRealm(BackupSample().apply { id = "deleted" })
+        }
+        realm.writeBackupSnapshot("$tmpDir/snapshot.realm")
+
+        realm.writeBlocking {
+            val a = objects<BackupSample>().query("id == 'a'").first()
+            a.intField = 2
+            a.doubleField = 1.5
+            a.stringField = "Realm"
+            a.stringList.add("tag")
+            val b = copyToRealm(BackupSample().apply { id = "b" })
+            a.link = b
+            a.objectList.add(b)
+            objects<BackupSample>().query("id == 'deleted'").delete()
+        }
+        realm.writeBlocking {
+            objects<BackupSample>().query("id == 'b'").first().intField = 3
+        }
+
+        assertEquals(2, Realm.restoreBackup(restoredConfiguration(), "$tmpDir/snapshot.realm", journalPath))
+
+        val restored = Realm.open(restoredConfiguration())
+        try {
+            assertEquals(2, restored.objects<BackupSample>().size)
+            val a = restored.objects<BackupSample>().query("id == 'a'").first()
+            assertEquals(2, a.intField)
+            assertEquals(1.5, a.doubleField)
+            assertEquals("Realm", a.stringField)
+            assertEquals(listOf("tag"), a.stringList.toList())
+            assertEquals("b", a.link!!.id)
+            assertEquals(3, a.link!!.intField)
+            assertEquals(listOf("b"), a.objectList.map { it.id })
+        } finally {
+            restored.close()
+        }
+    }
+
+    @Test
+    fun restoreBackup_deletedAndRecreatedObjectIsUnlinked() {
+        realm.writeBackupSnapshot("$tmpDir/snapshot.realm")
+        realm.writeBlocking {
+            copyToRealm(BackupSample().apply { id = "a"; link = BackupSample().apply { id = "b" } })
+        }
+        realm.writeBlocking {
+            objects<BackupSample>().query("id == 'b'").delete()
+            copyToRealm(BackupSample().apply { id = "b" })
+        }
+
+        Realm.restoreBackup(restoredConfiguration(), "$tmpDir/snapshot.realm", journalPath)
+
+        val restored = Realm.open(restoredConfiguration())
+        try {
+            assertEquals(2, restored.objects<BackupSample>().size)
+            assertNull(restored.objects<BackupSample>().query("id == 'a'").first().link)
+        } finally {
+            restored.close()
+        }
+    }
+
+    @Test
+    fun restoreBackup_ignoresTruncatedRecord() {
+        realm.writeBackupSnapshot("$tmpDir/snapshot.realm")
+        realm.writeBlocking { copyToRealm(BackupSample().apply { id = "a" }) }
+        realm.writeBlocking { copyToRealm(BackupSample().apply { id = "b" }) }
+        val journal = File(journalPath)
+        journal.writeBytes(journal.readBytes().let { it.copyOf(it.size - 1) })
+
+        assertEquals(1, Realm.restoreBackup(restoredConfiguration(), "$tmpDir/snapshot.realm", journalPath))
+
+        val restored = Realm.open(restoredConfiguration())
+        try {
+            assertEquals(listOf("a"), restored.objects<BackupSample>().map { it.id })
+        } finally {
+            restored.close()
+        }
+    }
+
+    @Test
+    fun writeBackupSnapshot_startsNewJournal() {
+        realm.writeBlocking { copyToRealm(BackupSample().apply { id = "a" }) }
+        realm.writeBackupSnapshot("$tmpDir/snapshot.realm")
+
+        assertEquals(0, Realm.restoreBackup(restoredConfiguration(), "$tmpDir/snapshot.realm", journalPath))
+        val restored = Realm.open(restoredConfiguration())
+        try {
+            assertEquals(1, restored.objects<BackupSample>().size)
+        } finally {
+            restored.close()
+        }
+    }
+
+    @Test
+    fun appendFailure_interruptsJournalUntilNextSnapshot() {
+        // Appending fails while a directory is in the way of the journal
+        File(journalPath).mkdir()
+        realm.writeBlocking { copyToRealm(BackupSample().apply { id = "a" }) }
+        File(journalPath).delete()
+        realm.writeBlocking { copyToRealm(BackupSample().apply { id = "b" }) }
+        assertEquals(2, realm.objects<BackupSample>().size)
+        assertFalse(File(journalPath).exists())
+
+        realm.writeBackupSnapshot("$tmpDir/snapshot.realm")
+        realm.writeBlocking { copyToRealm(BackupSample().apply { id = "c" }) }
+        assertEquals(1, Realm.restoreBackup(restoredConfiguration(), "$tmpDir/snapshot.realm", journalPath))
+    }
+
+    @Test
+    fun writeBackupSnapshot_throwsWithoutJournal() {
+        val other = Realm.open(
+            RealmConfiguration.Builder(schema = setOf(BackupSample::class))
+                .path("$tmpDir/other.realm")
+                .build()
+        )
+        try {
+            assertFailsWith<IllegalStateException> {
+                other.writeBackupSnapshot("$tmpDir/snapshot.realm")
+            }
+        } finally {
+            other.close()
+        }
+    }
+
+    @Test
+    fun restoreBackup_throwsIfRealmExists() {
+        realm.writeBackupSnapshot("$tmpDir/snapshot.realm")
+        File(restoredConfiguration().path).createNewFile()
+        assertFailsWith<IllegalArgumentException> {
+            Realm.restoreBackup(restoredConfiguration(), "$tmpDir/snapshot.realm", journalPath)
+        }
+    }
+
+    @Test
+    fun backupJournal_requiresPrimaryKeys() {
+        assertFailsWith<IllegalArgumentException> {
+            RealmConfiguration.Builder(schema = setOf(Sample::class))
+                .path("$tmpDir/sample.realm")
+                .backupJournal(journalPath)
+                .build()
+        }
+    }
+
+    private fun restoredConfiguration(): RealmConfiguration {
+        return RealmConfiguration.Builder(schema = setOf(BackupSample::class))
+            .path("$tmpDir/restored.realm")
+            .build()
+    }
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.copyFromRealm
+import io.realm.entities.Sample
+import io.realm.isManaged
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertFalse
+import kotlin.test.assertNull
+import kotlin.test.assertSame
+import kotlin.test.assertTrue
+
+// Object graphs are serialized from the core objects behind the realm, which is only available
+// through JNI
+class CopyFromRealmTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        realm = Realm.open(
+            RealmConfiguration.Builder(schema = setOf(Sample::class))
+                .path("$tmpDir/default.realm")
+                .build()
+        )
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun copyFromRealm_allTypes() {
+        realm.writeBlocking {
+            copyToRealm(
+                Sample().apply {
+                    stringField = "Foo"
+                    byteField = 1
+                    charField = 'b'
+                    shortField = 2
+                    intField = 3
+                    longField = 4
+                    booleanField = false
+                    floatField = 5.5f
+                    doubleField = 6.5
+                    stringListField.addAll(listOf("a", "b"))
+                    byteListField.add(7)
+                    charListField.add('c')
+                    shortListField.add(8)
+                    intListField.addAll(listOf(9, 10))
+                    longListField.add(11)
+                    booleanListField.add(true)
+                    floatListField.add(12.5f)
+                    doubleListField.add(13.5)
+                    nullableIntListField.addAll(listOf(null, 14))
+                    nullableStringListField.add(null)
+                }
+            )
+        }
+        val managed = realm.objects<Sample>().first()
+
+        val copy = realm.copyFromRealm(managed)
+
+        assertFalse(copy.isManaged())
+        assertEquals("Foo", copy.stringField)
+        assertEquals(1.toByte(), copy.byteField)
+        assertEquals('b', copy.charField)
+        assertEquals(2.toShort(), copy.shortField)
+        assertEquals(3, copy.intField)
+        assertEquals(4L, copy.longField)
+        assertFalse(copy.booleanField)
+        assertEquals(5.5f, copy.floatField)
+        assertEquals(6.5, copy.doubleField)
+        assertEquals(listOf("a", "b"), copy.stringListField.toList())
+        assertEquals(listOf<Byte>(7), copy.byteListField.toList())
+        assertEquals(listOf('c'), copy.charListField.toList())
+        assertEquals(listOf<Short>(8), copy.shortListField.toList())
+        assertEquals(listOf(9, 10), copy.intListField.toList())
+        assertEquals(listOf(11L), copy.longListField.toList())
+        assertEquals(listOf(true), copy.booleanListField.toList())
+        assertEquals(listOf(12.5f), copy.floatListField.toList())
+        assertEquals(listOf(13.5), copy.doubleListField.toList())
+        assertEquals(listOf(null, 14), copy.nullableIntListField.toList())
+        assertEquals(listOf<String?>(null), copy.nullableStringListField.toList())
+    }
+
+    @Test
+    fun copyFromRealm_depth() {
+        realm.writeBlocking {
+            copyToRealm(
+                Sample().apply {
+                    stringField = "1"
+                    child = Sample().apply {
+                        stringField = "2"
+                        child = Sample().apply { stringField = "3" }
+                        objectListField.add(Sample().apply { stringField = "4" })
+                    }
+                }
+            )
+        }
+        val root = realm.objects<Sample>().query("stringField = '1'").first()
+
+        assertNull(realm.copyFromRealm(root, depth = 0).child)
+        realm.copyFromRealm(root, depth = 1).let {
+            val child = it.child!!
+            assertEquals("2", child.stringField)
+            assertFalse(child.isManaged())
+            assertNull(child.child)
+            assertTrue(child.objectListField.isEmpty())
+        }
+        realm.copyFromRealm(root).let {
+            assertEquals("3", it.child!!.child!!.stringField)
+            assertEquals(listOf("4"), it.child!!.objectListField.map { it.stringField })
+        }
+    }
+
+    @Test
+    fun copyFromRealm_preservesIdentity() {
+        realm.writeBlocking {
+            val parent = copyToRealm(Sample().apply { stringField = "parent" })
+            val child = copyToRealm(Sample().apply { stringField = "child" })
+            parent.child = child
+            parent.objectListField.add(child)
+            child.child = parent
+        }
+        val parent = realm.objects<Sample>().query("stringField = 'parent'").first()
+
+        val copy = realm.copyFromRealm(parent)
+
+        assertSame(copy.child, copy.objectListField[0])
+        assertSame(copy, copy.child!!.child)
+    }
+
+    @Test
+    fun copyFromRealm_results() {
+        realm.writeBlocking {
+            val shared = copyToRealm(Sample().apply { stringField = "shared" })
+            for (i in 0 until 10) {
+                copyToRealm(Sample().apply { intField = i }).child = shared
+            }
+        }
+        val results = realm.objects<Sample>().query("intField < 10")
+
+        val copies = realm.copyFromRealm(results)
+
+        assertEquals(results.map { it.intField }, copies.map { it.intField })
+        assertTrue(copies.none { it.isManaged() })
+        // Objects reachable from multiple results are copied once
+        assertEquals(1, copies.map { it.child }.toSet().size)
+        assertTrue(realm.copyFromRealm(results.query("intField < 0")).isEmpty())
+    }
+
+    @Test
+    fun copyFromRealm_insideWrite() {
+        val copy = realm.writeBlocking {
+            val managed = copyToRealm(Sample().apply { stringField = "Foo" })
+            copyFromRealm(managed)
+        }
+        assertEquals("Foo", copy.stringField)
+        assertFalse(copy.isManaged())
+    }
+
+    @Test
+    fun copyFromRealm_invalidArguments() {
+        assertFailsWith<IllegalArgumentException> {
+            realm.copyFromRealm(Sample())
+        }
+        realm.writeBlocking { copyToRealm(Sample()) }
+        assertFailsWith<IllegalArgumentException> {
+            realm.copyFromRealm(realm.objects<Sample>().first(), depth = -1)
+        }
+        assertFailsWith<IllegalArgumentException> {
+            realm.copyFromRealm(realm.objects<Sample>(), depth = -1)
+        }
+    }
+
+    @Test
+    fun copyFromRealm_deletedObjectThrows() {
+        realm.writeBlocking {
+            val managed = copyToRealm(Sample())
+            delete(managed)
+            assertFailsWith<IllegalStateException> {
+                copyFromRealm(managed)
+            }
+        }
+    }
+
+    @Test
+    fun copyFromRealm_closedRealmThrows() {
+        realm.writeBlocking { copyToRealm(Sample()) }
+        val managed = realm.objects<Sample>().first()
+        realm.close()
+        assertFailsWith<IllegalStateException> {
+            realm.copyFromRealm(managed)
+        }
+    }
+}
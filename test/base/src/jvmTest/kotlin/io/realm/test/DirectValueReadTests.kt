@@ -0,0 +1,286 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.RealmList
+import io.realm.RealmObject
+import io.realm.entities.Nullability
+import io.realm.entities.list.RealmListContainer
+import io.realm.internal.ManagedRealmList
+import io.realm.internal.RealmObjectInternal
+import io.realm.internal.interop.ColumnKey
+import io.realm.internal.interop.Link
+import io.realm.internal.interop.NativePointer
+import io.realm.internal.interop.RealmCoreException
+import io.realm.internal.interop.RealmCoreInvalidatedObjectException
+import io.realm.internal.interop.RealmInterop
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertNull
+import kotlin.test.assertTrue
+
+// Object values and list elements are read directly from the object store types in JNI
+@Suppress("invisible_member", "invisible_reference")
+class DirectValueReadTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        val configuration = RealmConfiguration.Builder(schema = setOf(Nullability::class, RealmListContainer::class))
+            .path("$tmpDir/default.realm")
+            .build()
+        realm = Realm.open(configuration)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun objectValues() {
+        realm.writeBlocking {
+            val obj = copyToRealm(populatedNullability())
+            assertEquals("Realm", obj.stringNullable)
+            assertEquals(true, obj.booleanNullable)
+            assertEquals(42, obj.intNullable)
+            assertEquals(4.2f, obj.floatNullable)
+            assertEquals(4.2, obj.doubleField)
+            assertEquals("Realm", obj.objectField!!.stringNullable)
+        }
+        val frozen = realm.objects<Nullability>().single { it.objectField != null }
+        assertEquals("Realm", frozen.stringNullable)
+        assertEquals(42, frozen.intNullable)
+        assertEquals("Realm", frozen.objectField!!.stringNullable)
+    }
+
+    @Test
+    fun objectValues_null() {
+        realm.writeBlocking {
+            val obj = copyToRealm(Nullability())
+            assertNull(obj.stringNullable)
+            assertNull(obj.booleanNullable)
+            assertNull(obj.intNullable)
+            assertNull(obj.floatNullable)
+            assertNull(obj.doubleField)
+            assertNull(obj.objectField)
+        }
+        val frozen = realm.objects<Nullability>().first()
+        assertNull(frozen.stringNullable)
+        assertNull(frozen.booleanNullable)
+        assertNull(frozen.intNullable)
+        assertNull(frozen.floatNullable)
+        assertNull(frozen.doubleField)
+        assertNull(frozen.objectField)
+    }
+
+    @Test
+    fun objectValues_deletedObject() {
+        realm.writeBlocking {
+            val obj = copyToRealm(populatedNullability())
+            val pointer = obj.pointer()
+            val keys = listOf("stringNullable", "booleanNullable", "intNullable", "floatNullable", "doubleField", "objectField")
+                .map { obj.columnKey(it) }
+            delete(obj)
+
+            assertFailsWith<IllegalStateException> { obj.stringNullable }
+            assertFailsWith<IllegalStateException> { obj.booleanNullable }
+            assertFailsWith<IllegalStateException> { obj.intNullable }
+            assertFailsWith<IllegalStateException> { obj.floatNullable }
+            assertFailsWith<IllegalStateException> { obj.doubleField }
+            assertFailsWith<IllegalStateException> { obj.objectField }
+            for (key in keys) {
+                assertFailsWith<RealmCoreInvalidatedObjectException> {
+                    RealmInterop.realm_get_value<Any?>(pointer, key)
+                }
+            }
+        }
+    }
+
+    @Test
+    fun objectValues_wrongColumnType() {
+        realm.writeBlocking {
+            val obj = copyToRealm(populatedNullability())
+            val pointer = obj.pointer()
+
+            // Values are boxed according to the type of the column and never reinterpreted
+            assertFailsWith<ClassCastException> {
+                val value: Long? = RealmInterop.realm_get_value(pointer, obj.columnKey("stringNullable"))
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: String? = RealmInterop.realm_get_value(pointer, obj.columnKey("booleanNullable"))
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: Double? = RealmInterop.realm_get_value(pointer, obj.columnKey("intNullable"))
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: Double? = RealmInterop.realm_get_value(pointer, obj.columnKey("floatNullable"))
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: Float? = RealmInterop.realm_get_value(pointer, obj.columnKey("doubleField"))
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: Long? = RealmInterop.realm_get_value(pointer, obj.columnKey("objectField"))
+                value
+            }
+            assertTrue(RealmInterop.realm_get_value<Any?>(pointer, obj.columnKey("objectField")) is Link)
+
+            // Collection columns cannot be read as values
+            val container = copyToRealm(RealmListContainer())
+            assertFailsWith<RealmCoreException> {
+                RealmInterop.realm_get_value<Any?>(container.pointer(), container.columnKey("stringListField"))
+            }
+        }
+    }
+
+    @Test
+    fun listElements() {
+        realm.writeBlocking {
+            val container = copyToRealm(populatedContainer())
+            assertEquals("Realm", container.nullableStringListField[0])
+            assertEquals(true, container.nullableBooleanListField[0])
+            assertEquals(42, container.nullableIntListField[0])
+            assertEquals(4.2f, container.nullableFloatListField[0])
+            assertEquals(4.2, container.nullableDoubleListField[0])
+            assertEquals("Child", container.objectListField[0].stringField)
+        }
+    }
+
+    @Test
+    fun listElements_null() {
+        realm.writeBlocking {
+            val container = copyToRealm(
+                RealmListContainer().apply {
+                    nullableStringListField.add(null)
+                    nullableBooleanListField.add(null)
+                    nullableIntListField.add(null)
+                    nullableFloatListField.add(null)
+                    nullableDoubleListField.add(null)
+                }
+            )
+            assertNull(container.nullableStringListField[0])
+            assertNull(container.nullableBooleanListField[0])
+            assertNull(container.nullableIntListField[0])
+            assertNull(container.nullableFloatListField[0])
+            assertNull(container.nullableDoubleListField[0])
+        }
+    }
+
+    @Test
+    fun listElements_deletedObject() {
+        realm.writeBlocking {
+            val container = copyToRealm(populatedContainer())
+            val lists: List<RealmList<*>> = listOf(
+                container.nullableStringListField,
+                container.nullableBooleanListField,
+                container.nullableIntListField,
+                container.nullableFloatListField,
+                container.nullableDoubleListField,
+                container.objectListField
+            )
+            delete(container)
+            for (list in lists) {
+                assertFailsWith<RuntimeException> { list[0] }
+                assertFailsWith<RealmCoreInvalidatedObjectException> {
+                    RealmInterop.realm_list_get<Any?>(list.pointer(), 0)
+                }
+            }
+        }
+    }
+
+    @Test
+    fun listElements_wrongColumnType() {
+        realm.writeBlocking {
+            val container = copyToRealm(populatedContainer())
+
+            // Elements are boxed according to the type of the list and never reinterpreted
+            assertFailsWith<ClassCastException> {
+                val value: Long? = RealmInterop.realm_list_get(container.nullableStringListField.pointer(), 0)
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: String? = RealmInterop.realm_list_get(container.nullableBooleanListField.pointer(), 0)
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: Double? = RealmInterop.realm_list_get(container.nullableIntListField.pointer(), 0)
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: Double? = RealmInterop.realm_list_get(container.nullableFloatListField.pointer(), 0)
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: Float? = RealmInterop.realm_list_get(container.nullableDoubleListField.pointer(), 0)
+                value
+            }
+            assertFailsWith<ClassCastException> {
+                val value: Long? = RealmInterop.realm_list_get(container.objectListField.pointer(), 0)
+                value
+            }
+
+            // Out of bounds indices are reported once as index errors
+            assertFailsWith<IndexOutOfBoundsException> { container.nullableIntListField[1] }
+            assertFailsWith<IndexOutOfBoundsException> { container.nullableIntListField[-1] }
+        }
+    }
+
+    private fun populatedNullability() = Nullability().apply {
+        stringNullable = "Realm"
+        booleanNullable = true
+        intNullable = 42
+        floatNullable = 4.2f
+        doubleField = 4.2
+        objectField = Nullability().apply { stringNullable = "Realm" }
+    }
+
+    private fun populatedContainer() = RealmListContainer().apply {
+        nullableStringListField.add("Realm")
+        nullableBooleanListField.add(true)
+        nullableIntListField.add(42)
+        nullableFloatListField.add(4.2f)
+        nullableDoubleListField.add(4.2)
+        objectListField.add(RealmListContainer().apply { stringField = "Child" })
+    }
+
+    private fun RealmObject.pointer(): NativePointer = (this as RealmObjectInternal).`$realm$ObjectPointer`!!
+
+    private fun RealmObject.columnKey(property: String): ColumnKey {
+        val obj = this as RealmObjectInternal
+        return RealmInterop.realm_get_col_key(obj.`$realm$Owner`!!.dbPointer, obj.`$realm$TableName`!!, property)
+    }
+
+    private fun RealmList<*>.pointer(): NativePointer = (this as ManagedRealmList<*>).nativePointer
+}
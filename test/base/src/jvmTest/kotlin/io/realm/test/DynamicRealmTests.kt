@@ -0,0 +1,183 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.DynamicPropertyType
+import io.realm.DynamicRealm
+import io.realm.DynamicRealmObject
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.dumpJson
+import io.realm.entities.backup.BackupSample
+import io.realm.inspect
+import io.realm.test.platform.PlatformUtils
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertNull
+import kotlin.test.assertTrue
+
+// Rows are read through the core objects behind the realm, which is only available through JNI
+class DynamicRealmTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var configuration: RealmConfiguration
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        configuration = RealmConfiguration.Builder(schema = setOf(BackupSample::class))
+            .path("$tmpDir/default.realm")
+            .build()
+        val realm = Realm.open(configuration)
+        realm.writeBlocking {
+            val b = copyToRealm(sample("b", 2, "B"))
+            val c = copyToRealm(sample("c", 3, null))
+            copyToRealm(
+                sample("a", 1, "A\"1").apply {
+                    link = b
+                    stringList.addAll(listOf("x", "y"))
+                    objectList.addAll(listOf(c, b))
+                }
+            )
+        }
+        realm.close()
+    }
+
+    @AfterTest
+    fun tearDown() {
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun schema() {
+        val realm = DynamicRealm.open(configuration.path)
+        val dynamicClass = realm.schema.getValue("BackupSample")
+        assertEquals("id", dynamicClass.primaryKey)
+        assertEquals(
+            listOf("id", "intField", "doubleField", "stringField", "link", "stringList", "objectList"),
+            dynamicClass.properties.map { it.name }
+        )
+        dynamicClass.properties[dynamicClass.propertyIndex("objectList")].let {
+            assertEquals(DynamicPropertyType.OBJECT, it.type)
+            assertTrue(it.isList)
+            assertEquals("BackupSample", it.linkTarget)
+        }
+        assertEquals(DynamicPropertyType.INT, dynamicClass.properties[dynamicClass.propertyIndex("intField")].type)
+        assertFailsWith<IllegalArgumentException> { dynamicClass.propertyIndex("missing") }
+        realm.close()
+    }
+
+    @Test
+    fun objects_genericAccessors() {
+        val realm = DynamicRealm.open(configuration.path)
+        val objects = realm.objects("BackupSample").sortedBy { it.getString("id") }
+        assertEquals(3, objects.size)
+        val a = objects[0]
+        val intField = a.dynamicClass.propertyIndex("intField")
+        assertEquals(1L, a.getLong(intField))
+        assertEquals(1L, a[intField])
+        assertEquals(1.5, a.getDouble("doubleField"))
+        assertEquals("A\"1", a.getString("stringField"))
+        assertEquals(listOf("x", "y"), a.getList("stringList"))
+        assertEquals("b", a.getObject("link")!!.getString("id"))
+        assertEquals(listOf("c", "b"), a.getList("objectList").map { (it as DynamicRealmObject).getString("id") })
+        assertNull(objects[2].getString("stringField"))
+        assertNull(objects[1].getObject("link"))
+        assertFailsWith<IllegalArgumentException> { a.getString("intField") }
+        assertFailsWith<IllegalArgumentException> { a.getList("link") }
+        realm.close()
+    }
+
+    @Test
+    fun query() {
+        val realm = DynamicRealm.open(configuration.path)
+        val results = realm.query("BackupSample", "intField > $0", 1)
+        assertEquals(setOf("b", "c"), results.map { it.getString("id") }.toSet())
+        assertFailsWith<IllegalArgumentException> { realm.query("BackupSample", "missing == 1") }
+        assertFailsWith<IllegalArgumentException> { realm.objects("Missing") }
+        realm.close()
+    }
+
+    @Test
+    fun objects_readsBatches() {
+        Realm.open(configuration).let { realm ->
+            realm.writeBlocking {
+                for (i in 0 until 2 * DynamicRealm.ROW_BATCH_SIZE + 1) {
+                    copyToRealm(sample("batch$i", i, null))
+                }
+            }
+            realm.close()
+        }
+        val realm = DynamicRealm.open(configuration.path)
+        val results = realm.query("BackupSample", "id BEGINSWITH 'batch'")
+        assertEquals(2 * DynamicRealm.ROW_BATCH_SIZE + 1, results.size)
+        assertEquals((0 until results.size).map { it.toLong() }.toSet(), results.map { it.getLong("intField") }.toSet())
+        realm.close()
+    }
+
+    @Test
+    fun close() {
+        val realm = DynamicRealm.open(configuration.path)
+        val results = realm.objects("BackupSample")
+        realm.close()
+        assertTrue(realm.isClosed())
+        assertFailsWith<IllegalStateException> { results[0] }
+        assertFailsWith<IllegalStateException> { realm.objects("BackupSample") }
+        // Closing is idempotent
+        realm.close()
+    }
+
+    @Test
+    fun open_missingFile() {
+        assertFailsWith<IllegalArgumentException> { DynamicRealm.open("$tmpDir/missing.realm") }
+    }
+
+    @Test
+    fun inspect() {
+        val realm = DynamicRealm.open(configuration.path)
+        val description = realm.inspect()
+        assertTrue(description.contains("BackupSample: 3 objects"), description)
+        assertTrue(description.contains("id: STRING (primary key)"), description)
+        assertTrue(description.contains("objectList: List<BackupSample>"), description)
+        realm.close()
+    }
+
+    @Test
+    fun dumpJson() {
+        val realm = DynamicRealm.open(configuration.path)
+        val out = StringBuilder()
+        assertEquals(3L, realm.dumpJson("BackupSample", out))
+        val line = out.lines().single { it.contains("\"id\":\"a\"") }
+        assertEquals(
+            "{\"id\":\"a\",\"intField\":1,\"doubleField\":1.5,\"stringField\":\"A\\\"1\",\"link\":\"b\"," +
+                "\"stringList\":[\"x\",\"y\"],\"objectList\":[\"c\",\"b\"]}",
+            line
+        )
+        assertEquals(1L, realm.dumpJson("BackupSample", StringBuilder(), limit = 1))
+        realm.close()
+    }
+
+    private fun sample(id: String, intField: Int, stringField: String?) = BackupSample().apply {
+        this.id = id
+        this.intField = intField
+        this.doubleField = intField + 0.5
+        this.stringField = stringField
+    }
+}
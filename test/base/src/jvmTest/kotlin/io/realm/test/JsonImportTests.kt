@@ -0,0 +1,210 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.entities.Sample
+import io.realm.entities.backup.BackupSample
+import io.realm.importJson
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import kotlinx.coroutines.runBlocking
+import java.io.File
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertNull
+import kotlin.test.assertTrue
+
+// JSON is imported through the core objects behind the realm, which is only available through JNI
+class JsonImportTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var configuration: RealmConfiguration
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        configuration = RealmConfiguration.Builder(schema = setOf(BackupSample::class, Sample::class))
+            .path("$tmpDir/default.realm")
+            .build()
+        realm = Realm.open(configuration)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun importJson_file() {
+        val file = File("$tmpDir/samples.ndjson")
+        file.writeText(
+            (0 until 100).joinToString("\n") {
+                """{"id": "$it", "intField": $it, "doubleField": ${it / 2.0}, "stringField": "Sample æ $it", "stringList": ["a", "b"]}"""
+            }
+        )
+
+        val imported = runBlocking { realm.importJson(BackupSample::class, file.path, batchSize = 30) }
+
+        assertEquals(100, imported)
+        val samples = realm.objects<BackupSample>()
+        assertEquals(100, samples.size)
+        val sample = realm.objects<BackupSample>().query("id = '42'").first()
+        assertEquals(42, sample.intField)
+        assertEquals(21.0, sample.doubleField)
+        assertEquals("Sample æ 42", sample.stringField)
+        assertEquals(listOf("a", "b"), sample.stringList.toList())
+    }
+
+    @Test
+    fun importJson_buffer() {
+        val json = """
+            {"id": "1", "intField": 1, "stringField": null}
+
+            {"id": "2", "intField": 2, "unknownField": {"nested": [1, 2, 3]}}
+        """.trimIndent()
+
+        val imported = runBlocking { realm.importJson(BackupSample::class, json.encodeToByteArray()) }
+
+        assertEquals(2, imported)
+        assertEquals(2, realm.objects<BackupSample>().size)
+        assertNull(realm.objects<BackupSample>().query("id = '1'").first().stringField)
+    }
+
+    @Test
+    fun importJson_classWithoutPrimaryKey() {
+        val json = """
+            {"stringField": "Foo", "intField": 1}
+            {"stringField": "Bar"}
+        """.trimIndent()
+
+        runBlocking { realm.importJson(Sample::class, json.encodeToByteArray()) }
+
+        val samples = realm.objects<Sample>()
+        assertEquals(2, samples.size)
+        // Model defaults are not applied to properties missing from the JSON
+        assertEquals(0, samples.query("stringField = 'Bar'").first().intField)
+    }
+
+    @Test
+    fun importJson_upsertsByPrimaryKey() {
+        realm.writeBlocking {
+            copyToRealm(BackupSample().apply { id = "1"; intField = 1; stringField = "Foo" })
+        }
+
+        runBlocking {
+            realm.importJson(BackupSample::class, """{"id": "1", "intField": 2}""".encodeToByteArray())
+        }
+
+        val sample = realm.objects<BackupSample>().single()
+        assertEquals(2, sample.intField)
+        // Missing properties keep their current value
+        assertEquals("Foo", sample.stringField)
+    }
+
+    @Test
+    fun importJson_linksByPrimaryKey() {
+        val json = """
+            {"id": "1", "link": "2", "objectList": ["2", "3"]}
+            {"id": "2", "intField": 2}
+        """.trimIndent()
+
+        runBlocking { realm.importJson(BackupSample::class, json.encodeToByteArray()) }
+
+        assertEquals(3, realm.objects<BackupSample>().size)
+        val sample = realm.objects<BackupSample>().query("id = '1'").first()
+        assertEquals(2, sample.link!!.intField)
+        assertEquals(listOf("2", "3"), sample.objectList.map { it.id })
+    }
+
+    @Test
+    fun importJson_progress() {
+        val json = (0 until 10).joinToString("\n") { """{"id": "$it"}""" }.encodeToByteArray()
+        val progress = mutableListOf<Pair<Long, Long>>()
+
+        runBlocking {
+            realm.importJson(BackupSample::class, json, batchSize = 4) { objects, bytes ->
+                progress.add(Pair(objects, bytes))
+            }
+        }
+
+        assertEquals(listOf(4L, 8L, 10L), progress.map { it.first })
+        assertTrue(progress.zipWithNext().all { (previous, next) -> previous.second < next.second })
+        assertEquals(json.size.toLong(), progress.last().second)
+    }
+
+    @Test
+    fun importJson_malformedLineRollsBackBatch() {
+        val json = """
+            {"id": "1"}
+            {"id": "2"}
+            {"id": "3"}
+            {"id": "4", "intField": "NaN"}
+        """.trimIndent()
+
+        val exception = assertFailsWith<IllegalArgumentException> {
+            runBlocking { realm.importJson(BackupSample::class, json.encodeToByteArray(), batchSize = 2) }
+        }
+
+        assertTrue(exception.cause!!.message!!.contains("Line 4"), exception.cause!!.message)
+        // The first batch stays committed
+        assertEquals(listOf("1", "2"), realm.objects<BackupSample>().map { it.id }.sorted())
+    }
+
+    @Test
+    fun importJson_missingPrimaryKey() {
+        assertFailsWith<IllegalArgumentException> {
+            runBlocking {
+                realm.importJson(BackupSample::class, """{"intField": 1}""".encodeToByteArray())
+            }
+        }
+        assertEquals(0, realm.objects<BackupSample>().size)
+    }
+
+    @Test
+    fun importJson_invalidArguments() {
+        val json = """{"id": "1"}""".encodeToByteArray()
+        assertFailsWith<IllegalArgumentException> {
+            runBlocking { realm.importJson(BackupSample::class, json, batchSize = 0) }
+        }
+        assertFailsWith<IllegalArgumentException> {
+            runBlocking { realm.importJson(BackupSample::class, "$tmpDir/missing.ndjson") }
+        }
+    }
+
+    @Test
+    fun importJson_changeLogThrows() {
+        realm.close()
+        realm = Realm.open(
+            RealmConfiguration.Builder(schema = setOf(BackupSample::class))
+                .path("$tmpDir/changes.realm")
+                .changeLog("$tmpDir/changes.log")
+                .build()
+        )
+        assertFailsWith<IllegalStateException> {
+            runBlocking { realm.importJson(BackupSample::class, """{"id": "1"}""".encodeToByteArray()) }
+        }
+    }
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.SchemaMigration
+import io.realm.migration
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertSame
+import kotlin.test.assertTrue
+import io.realm.entities.migration.v1.Person as PersonV1
+import io.realm.entities.migration.v2.Person as PersonV2
+
+// Migrations run on the core objects behind the realm, which is only available through JNI
+class SchemaMigrationTests {
+
+    private lateinit var tmpDir: String
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        val realm = Realm.open(configurationV1())
+        realm.writeBlocking {
+            copyToRealm(person("Ann", "Ann Smith", "42", "Main Street 1", "Springfield"))
+            copyToRealm(person("Bob", "Bob van Dyke", "37", "Elm Street 2", "Shelbyville"))
+            copyToRealm(person("Eve", null, "29", "", "Ogdenville").apply { active = false })
+        }
+        realm.close()
+    }
+
+    @AfterTest
+    fun tearDown() {
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun migration_runsOperations() {
+        val migration = SchemaMigration.Builder()
+            .renameProperty("Person", "name", "displayName")
+            .splitProperty("Person", "fullName", " ", listOf("firstName", "lastName"))
+            .convertProperty("Person", "age")
+            .mergeProperties("Person", "address", "{street}, {city} {{{name}}}")
+            .setValue("Person", "score", 1)
+            .deleteWhere("Person", "active == false")
+            .build()
+
+        val realm = Realm.open(configurationV2(migration))
+
+        val people = realm.objects<PersonV2>().sortedBy { it.displayName }
+        assertEquals(listOf("Ann", "Bob"), people.map { it.displayName })
+        people[1].let {
+            assertEquals("Bob", it.firstName)
+            // The last target receives the remainder
+            assertEquals("van Dyke", it.lastName)
+            assertEquals(37, it.age)
+            assertEquals("Elm Street 2, Shelbyville {Bob}", it.address)
+            assertEquals(1.0, it.score)
+        }
+        realm.close()
+    }
+
+    @Test
+    fun migration_progress() {
+        val progress = mutableListOf<Triple<Int, Long, Long>>()
+        val migration = SchemaMigration.Builder()
+            .renameProperty("Person", "name", "displayName")
+            .deleteWhere("Person", "active == false")
+            .setValue("Person", "score", 2.5)
+            .build()
+
+        Realm.open(
+            configurationV2(migration) { operation, processed, total ->
+                progress.add(Triple(operation, processed, total))
+            }
+        ).close()
+
+        assertEquals(listOf(Triple(0, 3L, 3L), Triple(1, 1L, 1L), Triple(2, 2L, 2L)), progress)
+    }
+
+    @Test
+    fun migration_failureLeavesRealmUnchanged() {
+        Realm.open(configurationV1()).let { realm ->
+            realm.writeBlocking { copyToRealm(person("Joe", "Joe", "unknown", "", "")) }
+            realm.close()
+        }
+        val migration = SchemaMigration.Builder()
+            .renameProperty("Person", "name", "displayName")
+            .convertProperty("Person", "age")
+            .build()
+
+        val exception = assertFailsWith<IllegalArgumentException> {
+            Realm.open(configurationV2(migration))
+        }
+
+        assertTrue(exception.cause!!.message!!.contains("Person.age"), exception.cause!!.message)
+        val realm = Realm.open(configurationV1())
+        assertEquals(4, realm.objects<PersonV1>().size)
+        realm.close()
+    }
+
+    @Test
+    fun migration_progressCallbackExceptionIsRethrown() {
+        val failure = IllegalStateException("Boom")
+        val migration = SchemaMigration.Builder()
+            .renameProperty("Person", "name", "displayName")
+            .build()
+
+        val exception = assertFailsWith<IllegalStateException> {
+            Realm.open(configurationV2(migration) { _, _, _ -> throw failure })
+        }
+
+        assertSame(failure, exception)
+        val realm = Realm.open(configurationV1())
+        assertEquals("Ann Smith", realm.objects<PersonV1>().query("name = 'Ann'").first().fullName)
+        realm.close()
+    }
+
+    @Test
+    fun migration_invalidArguments() {
+        assertFailsWith<IllegalArgumentException> {
+            SchemaMigration.Builder().splitProperty("Person", "fullName", "", listOf("firstName"))
+        }
+        assertFailsWith<IllegalArgumentException> {
+            SchemaMigration.Builder().splitProperty("Person", "fullName", " ", listOf())
+        }
+        assertFailsWith<IllegalArgumentException> {
+            SchemaMigration.Builder().setValue("Person", "score", listOf(1))
+        }
+        assertFailsWith<IllegalArgumentException> {
+            configurationV2(SchemaMigration.Builder().mergeProperties("Person", "address", "{street").build())
+        }
+        assertFailsWith<IllegalArgumentException> {
+            RealmConfiguration.Builder(schema = setOf(PersonV2::class))
+                .deleteRealmIfMigrationNeeded()
+                .migration(SchemaMigration.Builder().build())
+                .build()
+        }
+        assertFailsWith<IllegalArgumentException> {
+            RealmConfiguration.Builder(schema = setOf(PersonV2::class))
+                .backupJournal("$tmpDir/backup.journal")
+                .migration(SchemaMigration.Builder().build())
+                .build()
+        }
+        assertFailsWith<IllegalArgumentException> {
+            RealmConfiguration.Builder(schema = setOf(PersonV2::class))
+                .changeLog("$tmpDir/changes.log")
+                .migration(SchemaMigration.Builder().build())
+                .build()
+        }
+    }
+
+    private fun person(name: String, fullName: String?, age: String, street: String, city: String) =
+        PersonV1().apply {
+            this.name = name
+            this.fullName = fullName
+            this.age = age
+            this.street = street
+            this.city = city
+        }
+
+    private fun configurationV1(): RealmConfiguration =
+        RealmConfiguration.Builder(schema = setOf(PersonV1::class))
+            .path("$tmpDir/default.realm")
+            .build()
+
+    private fun configurationV2(
+        migration: SchemaMigration,
+        onProgress: ((Int, Long, Long) -> Unit)? = null
+    ): RealmConfiguration =
+        RealmConfiguration.Builder(schema = setOf(PersonV2::class))
+            .path("$tmpDir/default.realm")
+            .schemaVersion(1)
+            .migration(migration, onProgress)
+            .build()
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.addSearchIndex
+import io.realm.entities.Sample
+import io.realm.entities.StringPropertyWithPrimaryKey
+import io.realm.objects
+import io.realm.removeSearchIndex
+import io.realm.test.platform.PlatformUtils
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertFalse
+import kotlin.test.assertTrue
+
+// Adding and removing search indexes at runtime is only available through JNI
+class SearchIndexTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        val configuration = RealmConfiguration.Builder(schema = setOf(Sample::class, StringPropertyWithPrimaryKey::class))
+            .path("$tmpDir/default.realm")
+            .build()
+        realm = Realm.open(configuration)
+        realm.writeBlocking {
+            for (i in 0 until 10) {
+                copyToRealm(Sample().apply { stringField = "$i"; intField = i })
+            }
+        }
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun addAndRemoveSearchIndex() {
+        assertFalse(realm.objects<Sample>().query("stringField == '1'").estimatedIndexUsage().mayUseIndex)
+
+        realm.writeBlocking { addSearchIndex(Sample::class, "stringField") }
+        val results = realm.objects<Sample>().query("stringField == $0", "1")
+        assertEquals(listOf("stringField"), results.estimatedIndexUsage().candidateProperties)
+        assertEquals(1, results.size)
+
+        realm.writeBlocking { removeSearchIndex(Sample::class, "stringField") }
+        assertFalse(realm.objects<Sample>().query("stringField == '1'").estimatedIndexUsage().mayUseIndex)
+        // Results keep reporting the indexes of their version
+        assertTrue(results.estimatedIndexUsage().mayUseIndex)
+    }
+
+    @Test
+    fun estimatedIndexUsage() {
+        realm.writeBlocking { addSearchIndex(Sample::class, "intField") }
+        val samples = realm.objects<Sample>()
+
+        assertEquals(emptyList(), samples.estimatedIndexUsage().candidateProperties)
+        assertEquals(listOf("intField"), samples.query("intField == 1").estimatedIndexUsage().candidateProperties)
+        assertEquals(listOf("intField"), samples.query("$0 == intField", 1).estimatedIndexUsage().candidateProperties)
+        assertEquals(listOf("intField"), samples.query("stringField == '1' AND intField = 1").estimatedIndexUsage().candidateProperties)
+        assertEquals(listOf("intField"), samples.query("intField == 1 SORT(stringField ASC)").estimatedIndexUsage().candidateProperties)
+        assertEquals(listOf("intField"), samples.query("stringField == '1'").query("intField == 1").estimatedIndexUsage().candidateProperties)
+        assertFalse(samples.query("intField > 1").estimatedIndexUsage().mayUseIndex)
+        assertFalse(samples.query("intField != 1").estimatedIndexUsage().mayUseIndex)
+        assertFalse(samples.query("intField == 1 OR stringField == '1'").estimatedIndexUsage().mayUseIndex)
+        assertFalse(samples.query("child.intField == 1").estimatedIndexUsage().mayUseIndex)
+    }
+
+    @Test
+    fun estimatedIndexUsage_reportsAllCandidates() {
+        realm.writeBlocking {
+            addSearchIndex(Sample::class, "intField")
+            addSearchIndex(Sample::class, "stringField")
+        }
+        val samples = realm.objects<Sample>()
+
+        // The estimate does not guess which index core picks
+        assertEquals(
+            listOf("stringField", "intField"),
+            samples.query("stringField == '1' AND intField == 1").estimatedIndexUsage().candidateProperties
+        )
+        assertEquals(
+            listOf("intField"),
+            samples.query("intField == 1").query("intField == 1").estimatedIndexUsage().candidateProperties
+        )
+    }
+
+    @Test
+    fun addSearchIndex_throwsOnUnsupportedType() {
+        realm.writeBlocking {
+            assertFailsWith<IllegalArgumentException> {
+                addSearchIndex(Sample::class, "floatField")
+            }
+        }
+    }
+
+    @Test
+    fun removeSearchIndex_throwsOnPrimaryKey() {
+        realm.writeBlocking {
+            assertFailsWith<IllegalArgumentException> {
+                removeSearchIndex(StringPropertyWithPrimaryKey::class, "id")
+            }
+        }
+    }
+
+    @Test
+    fun addSearchIndex_throwsOnUnknownProperty() {
+        realm.writeBlocking {
+            assertFailsWith<IllegalArgumentException> {
+                addSearchIndex(Sample::class, "unknownField")
+            }
+        }
+    }
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.entities.Sample
+import io.realm.enumerateStrings
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+
+// String enumeration is only available through JNI
+class StringEnumerationTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var configuration: RealmConfiguration
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        configuration = RealmConfiguration.Builder(schema = setOf(Sample::class))
+            .path("$tmpDir/default.realm")
+            .build()
+        realm = Realm.open(configuration)
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun enumerateStrings() {
+        val statuses = listOf("open", "closed", "pending")
+        realm.writeBlocking {
+            for (i in 0 until 300) {
+                copyToRealm(Sample().apply { stringField = statuses[i % statuses.size] })
+            }
+            enumerateStrings(Sample::class, "stringField")
+        }
+
+        assertEquals(100, realm.objects<Sample>().query("stringField == 'closed'").size)
+
+        // Values can still be updated and the enumeration survives reopening the realm
+        realm.writeBlocking {
+            copyToRealm(Sample().apply { stringField = "archived" })
+            enumerateStrings(Sample::class, "stringField")
+        }
+        realm.close()
+        realm = Realm.open(configuration)
+        assertEquals(1, realm.objects<Sample>().query("stringField == 'archived'").size)
+        assertEquals(301, realm.objects<Sample>().size)
+    }
+
+    @Test
+    fun enumerateStrings_throwsOnNonStringProperty() {
+        realm.writeBlocking {
+            assertFailsWith<IllegalArgumentException> {
+                enumerateStrings(Sample::class, "intField")
+            }
+        }
+    }
+
+    @Test
+    fun enumerateStrings_throwsOnUnknownProperty() {
+        realm.writeBlocking {
+            assertFailsWith<IllegalArgumentException> {
+                enumerateStrings(Sample::class, "unknownField")
+            }
+        }
+    }
+}
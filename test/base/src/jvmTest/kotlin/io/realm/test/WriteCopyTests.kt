@@ -0,0 +1,146 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.entities.Sample
+import io.realm.objects
+import io.realm.test.platform.PlatformUtils
+import io.realm.writeCopyTo
+import java.io.File
+import java.io.FileOutputStream
+import java.io.IOException
+import kotlin.random.Random
+import kotlin.test.AfterTest
+import kotlin.test.BeforeTest
+import kotlin.test.Test
+import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
+import kotlin.test.assertTrue
+
+// Writing copies of a realm is only available through JNI
+class WriteCopyTests {
+
+    private lateinit var tmpDir: String
+    private lateinit var realm: Realm
+
+    @BeforeTest
+    fun setup() {
+        tmpDir = PlatformUtils.createTempDir()
+        realm = Realm.open(configuration("default.realm"))
+        realm.writeBlocking {
+            for (i in 0 until 100) {
+                copyToRealm(Sample().apply { stringField = "Sample $i"; intField = i })
+            }
+        }
+    }
+
+    @AfterTest
+    fun tearDown() {
+        if (!realm.isClosed()) {
+            realm.close()
+        }
+        PlatformUtils.deleteTempDir(tmpDir)
+    }
+
+    @Test
+    fun writeCopyTo_path() {
+        realm.writeCopyTo("$tmpDir/copy.realm")
+        // Later writes are not part of the copy
+        realm.writeBlocking { copyToRealm(Sample()) }
+
+        assertCopy(configuration("copy.realm"), 100)
+    }
+
+    @Test
+    fun writeCopyTo_encrypted() {
+        val key = Random.nextBytes(Realm.ENCRYPTION_KEY_LENGTH)
+        realm.writeCopyTo("$tmpDir/encrypted.realm", key)
+
+        val configuration = RealmConfiguration.Builder(schema = setOf(Sample::class))
+            .path("$tmpDir/encrypted.realm")
+            .encryptionKey(key)
+            .build()
+        assertCopy(configuration, 100)
+    }
+
+    @Test
+    fun writeCopyTo_compactsFile() {
+        realm.writeBlocking {
+            for (i in 0 until 1000) {
+                copyToRealm(Sample().apply { stringField = "Deleted $i" })
+            }
+        }
+        realm.writeBlocking { objects<Sample>().query("stringField BEGINSWITH 'Deleted'").delete() }
+
+        realm.writeCopyTo("$tmpDir/copy.realm")
+        assertTrue(File("$tmpDir/copy.realm").length() < File(realm.configuration.path).length())
+    }
+
+    @Test
+    fun writeCopyTo_throwsIfFileExists() {
+        File("$tmpDir/copy.realm").createNewFile()
+        assertFailsWith<IllegalArgumentException> {
+            realm.writeCopyTo("$tmpDir/copy.realm")
+        }
+    }
+
+    @Test
+    fun writeCopyTo_throwsOnInvalidEncryptionKey() {
+        assertFailsWith<IllegalArgumentException> {
+            realm.writeCopyTo("$tmpDir/copy.realm", ByteArray(8))
+        }
+    }
+
+    @Test
+    fun writeCopyTo_outputStream() {
+        FileOutputStream("$tmpDir/streamed.realm").use { realm.writeCopyTo(it) }
+
+        assertCopy(configuration("streamed.realm"), 100)
+    }
+
+    @Test
+    fun writeCopyTo_sinkExceptionAbortsCopy() {
+        var chunks = 0
+        assertFailsWith<IOException> {
+            realm.writeCopyTo { _, _ ->
+                chunks++
+                throw IOException("Disk full")
+            }
+        }
+        assertEquals(1, chunks)
+        // The realm is still usable after an aborted copy
+        assertEquals(100, realm.objects<Sample>().size)
+    }
+
+    private fun configuration(name: String): RealmConfiguration {
+        return RealmConfiguration.Builder(schema = setOf(Sample::class))
+            .path("$tmpDir/$name")
+            .build()
+    }
+
+    private fun assertCopy(configuration: RealmConfiguration, expectedCount: Int) {
+        val copy = Realm.open(configuration)
+        try {
+            assertEquals(expectedCount, copy.objects<Sample>().size)
+            assertEquals(1, copy.objects<Sample>().query("stringField == 'Sample 42'").size)
+        } finally {
+            copy.close()
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.test.platform
+
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.CoroutineDispatcher
+import kotlinx.coroutines.CoroutineExceptionHandler
+import kotlinx.coroutines.CoroutineScope
+import kotlinx.coroutines.async
+import kotlinx.coroutines.newSingleThreadContext
+import kotlinx.coroutines.runBlocking
+import kotlin.coroutines.CoroutineContext
+import kotlin.native.concurrent.AtomicReference
+import kotlin.native.concurrent.freeze
+
+/**
+ * Linux does not have a platform run loop, so the "run loop" is emulated by a dedicated
+ * dispatcher thread while the calling thread blocks until [terminate] is called.
+ */
+actual class RunLoopThread : CoroutineScope {
+
+    private val dispatcher: CoroutineDispatcher by lazy { newSingleThreadContext("RunLoopThread") }
+    override val coroutineContext: CoroutineContext by lazy { dispatcher + exceptionHandler }
+
+    private val error: AtomicReference<Throwable?> = AtomicReference(null)
+    private val terminated = CompletableDeferred<Unit>()
+
+    val exceptionHandler = CoroutineExceptionHandler { _, exception ->
+        error.value = exception.freeze()
+        println("CoroutineExceptionHandler got $exception")
+        terminate()
+    }
+
+    actual fun run(block: RunLoopThread.() -> Unit) {
+        this.async { block(this@RunLoopThread) }
+        runBlocking { terminated.await() }
+        error.value?.let { throw it }
+    }
+
+    actual fun terminate() {
+        terminated.complete(Unit)
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// JMH benchmarks of the JVM SDK. Run with `./gradlew :benchmarks:benchmark` or
+// `./gradlew :benchmarks:smokeBenchmark` for a quick single iteration run.
+plugins {
+    id("org.jetbrains.kotlin.multiplatform")
+    id("org.jetbrains.kotlin.plugin.allopen")
+    id("org.jetbrains.kotlinx.benchmark")
+    id("realm-lint")
+    id("io.realm.kotlin")
+}
+
+kotlin {
+    jvm()
+    sourceSets {
+        getByName("jvmMain") {
+            dependencies {
+                implementation(kotlin("stdlib"))
+                implementation("io.realm.kotlin:library-base:${Realm.version}")
+                implementation("org.jetbrains.kotlinx:kotlinx-coroutines-core:${Versions.coroutines}")
+                implementation("org.jetbrains.kotlinx:kotlinx-benchmark-runtime:${Versions.kotlinxBenchmark}")
+            }
+        }
+    }
+}
+
+// JMH generates subclasses of the benchmark states
+allOpen {
+    annotation("org.openjdk.jmh.annotations.State")
+}
+
+benchmark {
+    targets {
+        register("jvm")
+    }
+    configurations {
+        getByName("main") {
+            warmups = 3
+            iterations = 5
+            iterationTime = 1
+            iterationTimeUnit = "s"
+        }
+        register("smoke") {
+            warmups = 1
+            iterations = 1
+            iterationTime = 500
+            iterationTimeUnit = "ms"
+        }
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.benchmarks
+
+import io.realm.RealmResults
+import io.realm.exportArrow
+import io.realm.objects
+import org.openjdk.jmh.annotations.Benchmark
+import org.openjdk.jmh.annotations.BenchmarkMode
+import org.openjdk.jmh.annotations.Mode
+import org.openjdk.jmh.annotations.OutputTimeUnit
+import org.openjdk.jmh.annotations.Scope
+import org.openjdk.jmh.annotations.Setup
+import org.openjdk.jmh.annotations.State
+import org.openjdk.jmh.annotations.TearDown
+import org.openjdk.jmh.infra.Blackhole
+import java.util.concurrent.TimeUnit
+
+// Exports of query results in the Apache Arrow IPC streaming format
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+class ArrowExportBenchmarks {
+
+    private lateinit var benchmarkRealm: BenchmarkRealm
+    private lateinit var results: RealmResults<BenchmarkObject>
+
+    @Setup
+    fun setup() {
+        benchmarkRealm = BenchmarkRealm(OBJECT_COUNT)
+        results = benchmarkRealm.realm.objects()
+    }
+
+    @TearDown
+    fun tearDown() {
+        benchmarkRealm.close()
+    }
+
+    @Benchmark
+    fun exportArrow(blackhole: Blackhole) {
+        results.exportArrow(PROPERTIES) { buffer, length ->
+            blackhole.consume(buffer)
+            blackhole.consume(length)
+        }
+    }
+
+    private companion object {
+        const val OBJECT_COUNT = 10_000
+        val PROPERTIES = listOf("id", "name", "score", "active")
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.benchmarks
+
+import io.realm.Realm
+import io.realm.RealmConfiguration
+import io.realm.RealmObject
+import java.io.File
+import java.nio.file.Files
+
+class BenchmarkObject : RealmObject {
+    var id: Long = 0
+    var name: String = ""
+    var score: Double = 0.0
+    var active: Boolean = false
+}
+
+/**
+ * A realm in a temporary directory holding the objects the benchmarks operate on.
+ */
+class BenchmarkRealm(objectCount: Int) {
+
+    private val directory: File = Files.createTempDirectory("realm_benchmarks").toFile()
+
+    val realm: Realm = Realm.open(
+        RealmConfiguration.Builder(schema = setOf(BenchmarkObject::class))
+            .path("${directory.absolutePath}/benchmark.realm")
+            .build()
+    )
+
+    init {
+        realm.writeBlocking {
+            repeat(objectCount) { copyToRealm(benchmarkObject(it)) }
+        }
+    }
+
+    fun close() {
+        realm.close()
+        directory.deleteRecursively()
+    }
+}
+
+fun benchmarkObject(index: Int): BenchmarkObject = BenchmarkObject().apply {
+    id = index.toLong()
+    name = "Object $index"
+    score = index * 0.5
+    active = index % 2 == 0
+}
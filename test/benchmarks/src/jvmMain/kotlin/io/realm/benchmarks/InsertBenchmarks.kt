@@ -0,0 +1,73 @@
+/*
+ * Copyright 2021 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package io.realm.benchmarks
+
+import io.realm.objects
+import kotlinx.coroutines.flow.flow
+import kotlinx.coroutines.runBlocking
+import org.openjdk.jmh.annotations.Benchmark
+import org.openjdk.jmh.annotations.BenchmarkMode
+import org.openjdk.jmh.annotations.Level
+import org.openjdk.jmh.annotations.Mode
+import org.openjdk.jmh.annotations.OutputTimeUnit
+import org.openjdk.jmh.annotations.Scope
+import org.openjdk.jmh.annotations.Setup
+import org.openjdk.jmh.annotations.State
+import org.openjdk.jmh.annotations.TearDown
+import java.util.concurrent.TimeUnit
+
+// Inserts of unmanaged objects
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+class InsertBenchmarks {
+
+    private lateinit var benchmarkRealm: BenchmarkRealm
+
+    @Setup
+    fun setup() {
+        benchmarkRealm = BenchmarkRealm(0)
+    }
+
+    @TearDown
+    fun tearDown() {
+        benchmarkRealm.close()
+    }
+
+    // Keeps the realm from growing across iterations
+    @TearDown(Level.Iteration)
+    fun deleteObjects() {
+        benchmarkRealm.realm.writeBlocking { objects<BenchmarkObject>().delete() }
+    }
+
+    @Benchmark
+    fun bulkInsert(): Long = runBlocking {
+        benchmarkRealm.realm.bulkInsert(flow { repeat(OBJECT_COUNT) { emit(benchmarkObject(it)) } })
+    }
+
+    // Baseline for bulk inserts, copying the same objects in a single write transaction
+    @Benchmark
+    fun copyToRealm() {
+        benchmarkRealm.realm.writeBlocking {
+            repeat(OBJECT_COUNT) { copyToRealm(benchmarkObject(it)) }
+        }
+    }
+
+    private companion object {
+        const val OBJECT_COUNT = 1000
+    }
+}
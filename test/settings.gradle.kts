@@ -31,3 +31,4 @@ pluginManagement {
 
 include("base")
 include("sync")
+include("benchmarks")